@@ -72,7 +72,9 @@ hpp::rbprm::State HPP_RBPRM_DLLAPI ComputeContacts(const hpp::rbprm::RbPrmFullBo
 /// \param robustnessTreshold minimum value of the static equilibrium robustness criterion required to accept the
 /// configuration (0 by default). \param acceleration acceleration on the CoM estimated by the planning \param comPath
 /// : path found by the planning \param currentPathId : timing inside comPath such that comPath(currentPathId) ==
-/// configuration (for the freeflyer DOFs) \return a State describing the computed contact configuration, with relevant
+/// configuration (for the freeflyer DOFs) \param maintainedContacts if not null, result of maintain_all_contacts
+/// for previous and configuration, used instead of projecting again the state maintaining all the contacts
+/// \return a State describing the computed contact configuration, with relevant
 /// contact information and balance information.
 hpp::rbprm::contact::ContactReport HPP_RBPRM_DLLAPI
 ComputeContacts(const hpp::rbprm::State& previous, const hpp::rbprm::RbPrmFullBodyPtr_t& body,
@@ -80,7 +82,8 @@ ComputeContacts(const hpp::rbprm::State& previous, const hpp::rbprm::RbPrmFullBo
                 const std::map<std::string, std::vector<std::string> >& affFilters, const fcl::Vec3f& direction,
                 const double robustnessTreshold = 0, const fcl::Vec3f& acceleration = fcl::Vec3f(0, 0, 0),
                 const core::PathConstPtr_t& comPath = core::PathPtr_t(), const double currentPathId = 0,
-                const bool testReachability = true, const bool quasiStatic = false);
+                const bool testReachability = true, const bool quasiStatic = false,
+                const projection::ProjectionReport* maintainedContacts = 0);
 
 }  // namespace contact
 }  // namespace rbprm
@@ -21,6 +21,7 @@
 
 #include <hpp/rbprm/rbprm-state.hh>
 #include <hpp/rbprm/rbprm-fullbody.hh>
+#include <hpp/rbprm/kinematic-context.hh>
 #include <hpp/rbprm/projection/projection.hh>
 #include <queue>
 
@@ -65,6 +66,21 @@ struct ContactGenHelper {
   const bool accept_unreachable_;
   const bool tryQuasiStatic_;
   const int reachabilityPointPerPhases_;
+  /// If not 0, only the maxCandidates_ best candidates of each limb are considered for contact creation.
+  /// Initialized with RbPrmFullBody::maxContactCandidates.
+  std::size_t maxCandidates_;
+  /// Context on which the equilibrium and center of mass queries are evaluated.
+  /// Uses the device of fullBody_ by default. Set it to KinematicContext::create(fullBody_)
+  /// so that these queries do not modify fullBody_->device_.
+  KinematicContextPtr_t context_;
+  /// If it holds more than one context, the contact candidates of a limb are projected and tested for
+  /// equilibrium in parallel, by batches of workers_.size() candidates, each thread using its own context
+  /// (see createKinematicContexts). Reachability is then tested sequentially, in heuristic order,
+  /// so that the contact created is the same as with a sequential evaluation.
+  T_KinematicContext workers_;
+  /// If not null, projection of workingState_ maintaining all its contacts, computed beforehand
+  /// with maintain_all_contacts. maintain_contacts uses it in place of its first candidate.
+  const projection::ProjectionReport* maintainedContacts_;
 };
 
 std::vector<hpp::pinocchio::CollisionObjectPtr_t> HPP_RBPRM_DLLAPI
@@ -100,6 +116,17 @@ T_ContactState gen_contacts_combinatorial(const std::vector<std::string>& freeEf
 /// \return the best candidate wrt the priority in the list and the contact order
 projection::ProjectionReport maintain_contacts(ContactGenHelper& contactGenHelper);
 
+/// Projects previous to the root configuration of configuration, maintaining all its contacts,
+/// as maintain_contacts does for its first candidate but without testing the reachability.
+/// The projection is computed on the device of context, so that several threads can maintain
+/// the contacts for different configurations, each one with its own context (see createKinematicContexts).
+/// \param previous state whose contacts are maintained
+/// \param configuration target root configuration, also used as initial guess of the projection
+/// \return the state found, with the configuration projected
+projection::ProjectionReport HPP_RBPRM_DLLAPI maintain_all_contacts(const KinematicContextPtr_t& context,
+                                                                    const State& previous,
+                                                                    pinocchio::ConfigurationIn_t configuration);
+
 /// Given a current state and an effector, tries to generate a contact configuration.
 /// \param ContactGenHelper parametrization of the planner
 /// \param limb the limb to create a contact with
@@ -2,6 +2,7 @@
 #define HPP_RBPRM_KINEMATICS_CONSTRAINTS_HH
 
 #include <hpp/rbprm/rbprm-limb.hh>
+#include <hpp/rbprm/kinematic-context.hh>
 #include <hpp/rbprm/rbprm-state.hh>
 #include <hpp/pinocchio/configuration.hh>
 #include <hpp/rbprm/rbprm-state.hh>
@@ -31,9 +32,31 @@ std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const RbPrmFul
 std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForLimb(const RbPrmFullBodyPtr_t& fullBody,
                                                                  const State& state, const std::string& limbName);
 
+/// Same as computeAllKinematicsConstraints, but evaluated on the device of context
+/// instead of the device of the full body.
+std::pair<MatrixX3, VectorX> computeAllKinematicsConstraints(const KinematicContextPtr_t& context,
+                                                             const pinocchio::ConfigurationPtr_t& configuration);
+
+/// Same as computeKinematicsConstraintsForState, but evaluated on the device of context
+/// instead of the device of the full body.
+std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const KinematicContextPtr_t& context,
+                                                                  const State& state);
+
+/// Same as computeKinematicsConstraintsForLimb, but evaluated on the device of context
+/// instead of the device of the full body.
+std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForLimb(const KinematicContextPtr_t& context,
+                                                                 const State& state, const std::string& limbName);
+
 std::pair<MatrixX3, VectorX> getInequalitiesAtTransform(const std::pair<MatrixX3, MatrixX3>& NV,
                                                         const hpp::pinocchio::Transform3f& transform);
 
+/// Same as getInequalitiesAtTransform for the kinematic constraints of limb.
+/// The inequalities are cached by each thread for each limb, and only computed again when the transform changes,
+/// ie. when the contact of the limb moves.
+/// \return a reference valid until the next call for the same limb by the same thread
+const std::pair<MatrixX3, VectorX>& getInequalitiesAtTransform(const RbPrmLimbPtr_t& limb,
+                                                               const hpp::pinocchio::Transform3f& transform);
+
 bool verifyKinematicConstraints(const std::pair<MatrixX3, VectorX>& Ab, const fcl::Vec3f& point);
 
 bool verifyKinematicConstraints(const std::pair<MatrixX3, MatrixX3>& NV, const hpp::pinocchio::Transform3f& transform,
@@ -41,6 +64,8 @@ bool verifyKinematicConstraints(const std::pair<MatrixX3, MatrixX3>& NV, const h
 
 bool verifyKinematicConstraints(const RbPrmFullBodyPtr_t& fullbody, const State& state, fcl::Vec3f point);
 
+bool verifyKinematicConstraints(const KinematicContextPtr_t& context, const State& state, fcl::Vec3f point);
+
 }  // namespace reachability
 }  // namespace rbprm
 }  // namespace hpp
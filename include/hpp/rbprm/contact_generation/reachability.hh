@@ -83,6 +83,9 @@ std::pair<MatrixXX, VectorX> computeStabilityConstraints(const centroidal_dynami
 std::pair<MatrixXX, VectorX> computeStabilityConstraintsForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
                                                                  bool& success, const fcl::Vec3f& acc);
 
+std::pair<MatrixXX, VectorX> computeStabilityConstraintsForState(const KinematicContextPtr_t& context, State& state,
+                                                                 bool& success, const fcl::Vec3f& acc);
+
 std::pair<MatrixXX, VectorX> computeConstraintsForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
                                                         bool& success);
 
@@ -101,6 +104,11 @@ std::pair<MatrixXX, VectorX> computeConstraintsForState(const RbPrmFullBodyPtr_t
 Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& next,
                    const fcl::Vec3f& acc = fcl::Vec3f::Zero(), bool useIntermediateState = false);
 
+/// Same as above, but the center of mass and the constraints are computed with the device of context,
+/// so that several threads can test transitions concurrently with one context each.
+Result isReachable(const KinematicContextPtr_t& context, State& previous, State& next,
+                   const fcl::Vec3f& acc = fcl::Vec3f::Zero(), bool useIntermediateState = false);
+
 Result isReachableDynamic(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& next, bool tryQuasiStatic = true,
                           std::vector<double> timings = std::vector<double>(), int numPointsPerPhases = 0);
 
@@ -50,6 +50,15 @@ class HPP_RBPRM_DLLAPI DynamicPathValidation : public RbPrmPathValidation {
   /// Users need to call RbPrmPlanner::create in order to create instances.
   DynamicPathValidation(const core::DevicePtr_t& robot, const core::value_type& stepSize);
 
+  /// Sets the contacts of the start of the path (its end if reverse) as initial contacts of the dynamic validation
+  virtual void startValidation(const core::PathPtr_t& path, bool reverse);
+
+  virtual bool validateConfiguration(const core::Configuration_t& q, core::ValidationReportPtr_t& report,
+                                     const std::vector<std::string>& filter);
+
+  virtual bool validateConfiguration(const core::Configuration_t& q, core::ValidationReportPtr_t& report,
+                                     const std::vector<std::string>& filter, core::value_type& step);
+
  private:
   DynamicValidationPtr_t dynamicValidation_;
 };  // class RbPrmPlanner
@@ -22,6 +22,7 @@
 #include <hpp/core/config-validation.hh>
 #include <hpp/centroidal-dynamics/centroidal_dynamics.hh>
 #include <hpp/rbprm/rbprm-validation-report.hh>
+#include <hpp/rbprm/planner/rbprm-node.hh>
 namespace hpp {
 namespace pinocchio {
 class RbPrmDevice;  // fwd declaration of  rbprmDevice class
@@ -79,6 +80,8 @@ class DynamicValidation : public core::ConfigValidation {
   core::Configuration_t lastAcc_;
   centroidal_dynamics::Matrix63 H_;
   centroidal_dynamics::Vector6 h_;
+  /// contact surfaces of the obstacles, read when the contacts change along the path
+  const core::ContactSurfaceCachePtr_t contactSurfaces_;
 
 };  // class dynamicValidation
 /// \}
@@ -21,9 +21,11 @@
 
 #include <hpp/rbprm/config.hh>
 #include <hpp/rbprm/rbprm-fullbody.hh>
+#include <hpp/rbprm/kinematic-context.hh>
 #include <hpp/core/path-vector.hh>
 #include <hpp/pinocchio/device.hh>
 
+#include <map>
 #include <vector>
 
 namespace hpp {
@@ -99,17 +101,40 @@ class HPP_RBPRM_DLLAPI RbPrmInterpolation {
   rbprm::T_StateFrame addGoalConfig(const rbprm::T_StateFrame& states);
   rbprm::T_StateFrame addGoalConfigRec(const rbprm::T_StateFrame& states, const std::vector<std::string> variations);
 
+  /// Removes the redundant states of a sequence of states, called by Interpolate if filterStates is true.
+  /// \param originStates states, with at most one contact variation between two consecutive ones
+  /// \param deep if true, the filters are applied until the number of states stops changing,
+  /// otherwise only the states without contact variation are removed
+  /// \return the filtered list of states
+  T_StateFrame FilterStates(const T_StateFrame& originStates, const bool deep);
+
  public:
   const core::PathVectorConstPtr_t path_;
   const State start_;
   const State end_;
   bool testReachability_;  // decide if we use the reachability criterion during interpolation
   bool quasiStatic_;       // decide if we use the criterion only in quasi-static
+  /// If it holds more than one context, Interpolate maintains the contacts of the last state created
+  /// for the next workers_.size() configurations ahead, in parallel, each thread using its own context
+  /// (see createKinematicContexts). The main thread then computes the states in order, using these
+  /// projections for the configurations where all the contacts are maintained. They are computed again
+  /// when a new state is created, its contacts being different.
+  /// The projections start from the configuration of the last state created instead of the configuration
+  /// found at the previous step, so the states may slightly differ from a sequential interpolation.
+  T_KinematicContext workers_;
+  /// If true, Interpolate steps over the configurations where the contacts of the last state are kept:
+  /// the configuration stride configurations ahead is probed with maintain_all_contacts, and skipped with all
+  /// the configurations before it if the projection succeeds and the state found is reachable and balanced,
+  /// as ComputeContacts requires. Only the states with all the limbs in contact are probed, ComputeContacts
+  /// trying to create a contact for the free limbs at each configuration. The stride
+  /// is doubled after each successful probe and halved after each failed one. Probes are bounded by the
+  /// first configuration where the center of mass leaves the kinematic constraints of the contacts,
+  /// which cannot all be maintained there. False by default; workers_ are not used in this mode.
+  bool adaptiveStep_;
 
  private:
   RbPrmFullBodyPtr_t robot_;
 
-  T_StateFrame FilterStates(const T_StateFrame& originStates, const bool deep);
   T_StateFrame FilterStatesRec(const T_StateFrame& originStates);
   T_StateFrame tryReplaceStates(const T_StateFrame& originStates);
   void tryReplaceStates(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res);
@@ -120,7 +145,40 @@ class HPP_RBPRM_DLLAPI RbPrmInterpolation {
   void FilterBreakCreate(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res);
   T_StateFrame FilterBreakCreate(const T_StateFrame& originStates);
   StateFrame findBestRepositionState(T_StateFrame candidates, std::vector<std::string> limbsNames);
+  /// Try to replace the second state of [from, from + 4) by a state with the contact created in the
+  /// fourth one, reachable from the first one. \return true and set replaced if it succeeds
+  bool tryReplaceState(const CIT_StateFrame& from, State& replaced);
+  /// Try to replace the third state of [from, from + 4) by a state keeping the contact broken in the
+  /// second one, so that the second one can be skipped. \return true and set replaced if it succeeds
+  bool trySkipState(const CIT_StateFrame& from, State& replaced);
+  /// Memoized in reachabilityResults_
   bool testReachability(const State& s0, const State& s1);
+  /// \return whether the substitution of the given kind (0 for tryReplaceState, 1 for trySkipState) already
+  /// failed on the states [from, from + 4)
+  bool substitutionFailed(const CIT_StateFrame& from, const std::size_t kind) const;
+  void addFailedSubstitution(const CIT_StateFrame& from, const std::size_t kind);
+  std::size_t skipMaintainedConfigurations(const T_Configuration& configs, const CIT_Configuration& cit,
+                                           const State& previous, const Configuration_t& lastConfig,
+                                           const double robustnessTreshold, std::size_t& stride,
+                                           contact::ContactReport& report);
+
+  struct ReachabilityResult {
+    State from_;
+    State to_;
+    bool success_;
+  };
+  /// Results of testReachability, indexed by the hashes of the two states. FilterStates iterates over
+  /// the filters until the number of states stops changing, and most pairs of states are tested again
+  /// at each iteration. The states are stored to tell apart the pairs with the same hashes.
+  /// Cleared by FilterStates.
+  std::multimap<std::pair<std::size_t, std::size_t>, ReachabilityResult> reachabilityResults_;
+  struct FailedSubstitution {
+    std::size_t kind_;
+    std::vector<State> states_;
+  };
+  /// Substitutions tried by tryReplaceState or trySkipState that failed, indexed by the hash of their states.
+  /// The states are stored to tell apart the substitutions with the same hashes. Cleared by FilterStates.
+  std::multimap<std::size_t, FailedSubstitution> failedSubstitutions_;
 
  protected:
   RbPrmInterpolation(const core::PathVectorConstPtr_t path, const RbPrmFullBodyPtr_t robot, const State& start,
@@ -105,7 +105,8 @@ class HPP_CORE_DLLAPI TimeConstraintHelper {
 /// "A Hierarchical Framework for Realizing Dynamically-stable
 /// Motions of Humanoid Robot in Obstacle-cluttered Environments"
 /// If OpenMP is activated, the interpolation between the states is run in parallel
-/// WARNING: At the moment, no more than 100 states can be interpolated simultaneously
+/// The interpolations that fail are run again, at most 10 times each. The path returned ends at the first
+/// state that could not be reached, and an exception is thrown if none could be.
 /// TODO: include parametrization of shortcut algorithm
 ///
 /// \param helper holds the problem parameters and the considered device
@@ -140,7 +141,8 @@ core::PathPtr_t HPP_RBPRM_DLLAPI interpolateStates(
 /// "A Hierarchical Framework for Realizing Dynamically-stable
 /// Motions of Humanoid Robot in Obstacle-cluttered Environments"
 /// If OpenMP is activated, the interpolation between the states is run in parallel
-/// WARNING: At the moment, no more than 100 states can be interpolated simultaneously
+/// The interpolations that fail are run again, at most 10 times each. The path returned ends at the first
+/// state that could not be reached, and an exception is thrown if none could be.
 /// TODO: include parametrization of shortcut algorithm
 ///
 /// \param helper holds the problem parameters and the considered device
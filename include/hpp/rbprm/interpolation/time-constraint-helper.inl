@@ -43,6 +43,8 @@
 #include <hpp/constraints/relative-com.hh>
 #include <hpp/constraints/symbolic-calculus.hh>
 #include <hpp/constraints/symbolic-function.hh>
+#include <exception>
+#include <stdexcept>
 #include <vector>
 #include <hpp/pinocchio/configuration.hh>
 namespace hpp {
@@ -211,29 +213,29 @@ namespace
             return partialPath;
         }
 
-        inline std::size_t checkPath(const std::size_t& distance, bool valid[])
+        inline std::size_t checkPath(const std::vector<PathVectorPtr_t>& res)
         {
-            std::size_t numValid(distance);
-            for(std::size_t i = 0; i < distance; ++i)
+            std::size_t numValid(res.size());
+            for(std::size_t i = 0; i < res.size(); ++i)
             {
-               if (!valid[i])
+               if (!res[i])
                {
                     numValid= i;
                     break;
                }
             }
-            //if (numValid==0)
-            //    throw std::runtime_error("No path found at state 0");
-            /*else */if(numValid != distance)
+            if(numValid != res.size())
             {
                 std::cout << "No path found at state " << numValid << std::endl;
             }
             return numValid;
         }
 
-        inline PathPtr_t ConcatenateAndResizePath(PathVectorPtr_t res[], std::size_t numValid, const bool keepExtraDof,
+        inline PathPtr_t ConcatenateAndResizePath(const std::vector<PathVectorPtr_t>& res, std::size_t numValid, const bool keepExtraDof,
                                                   hpp::pinocchio::DevicePtr_t device)
         {
+            if (numValid == 0)
+                throw std::runtime_error("No path found at state 0");
             PathVectorPtr_t completePath = res[0];
             for(std::size_t i = 1; i < numValid; ++i)
             {
@@ -300,46 +302,70 @@ namespace
                                               const PathGetter_T& pathGetter,
                                               const StateIterator_T &startState, const StateIterator_T &endState,
                                               const std::size_t numOptimizations, const bool keepExtraDof=false,
-                                              const pinocchio::value_type error_treshold = 0.001, const size_t maxIterations = 0)
+                                              const pinocchio::value_type error_treshold = 0.001, const size_t maxIterations = 0,
+                                              const std::size_t maxAttempts = 10)
     {
         hppDout(notice,"Begin interpolateStatesFromPathGetter :");
         pinocchio::Computation_t flag = fullbody->device_->computationFlag();
         pinocchio::Computation_t newflag = static_cast <pinocchio::Computation_t> (pinocchio::JOINT_POSITION | pinocchio::JACOBIAN | pinocchio::COM);
         fullbody->device_->controlComputation (newflag);
-        PathVectorPtr_t res[100];
-        bool valid[100];
         std::size_t distance = std::distance(startState,endState);
-        assert(distance < 100);
+        std::vector<PathVectorPtr_t> res(distance);
+        std::vector<std::exception_ptr> errors(distance);
         // treat each interpolation between two states separatly
         // in a different thread
         hppDout(notice,"InterpolateStates from path : distance = "<<distance);
-        std::size_t numValid;
-        do{
-            #pragma omp parallel for
-            for(std::size_t i = 0; i < distance; ++i)
+        // segments not interpolated yet: only the segments that failed are run again,
+        // each of them at most maxAttempts times
+        std::vector<std::size_t> pending;
+        for(std::size_t i = 0; i < distance; ++i)
+            pending.push_back(i);
+        for(std::size_t attempt = 0; attempt < maxAttempts && !pending.empty(); ++attempt)
+        {
+            hppDout(notice,"InterpolateStates : attempt "<<attempt<<", number of segments : "<<pending.size());
+            // the planning times of the segments differ a lot, a dynamic schedule keeps all the threads busy
+            #pragma omp parallel for schedule(dynamic)
+            for(std::size_t k = 0; k < pending.size(); ++k)
             {
-                StateIterator_T a, b;
-                a = (startState+i);
-                b = (startState+i+1);
-                Helper_T helper(fullbody, shooterFactory, constraintFactory, referenceProblem, pathGetter(a,b),error_treshold); // 0.1 : error
-                helper.SetConstraints(get(a), get(b));
-                hppDout(notice,"Start helper.run :");
-                PathVectorPtr_t partialPath = helper.Run(get(a), get(b),maxIterations);
-                hppDout(notice,"helper.run done.");
-                if(partialPath)
+                const std::size_t i = pending[k];
+                try
                 {
-                    res[i] = optimize(helper,partialPath, numOptimizations);
-                    valid[i]=true;
+                    StateIterator_T a, b;
+                    a = (startState+i);
+                    b = (startState+i+1);
+                    Helper_T helper(fullbody, shooterFactory, constraintFactory, referenceProblem, pathGetter(a,b),error_treshold); // 0.1 : error
+                    helper.SetConstraints(get(a), get(b));
+                    hppDout(notice,"Start helper.run :");
+                    PathVectorPtr_t partialPath = helper.Run(get(a), get(b),maxIterations);
+                    hppDout(notice,"helper.run done.");
+                    if(partialPath)
+                    {
+                        res[i] = optimize(helper,partialPath, numOptimizations);
+                    }
+                    else
+                    {
+                        hppDout(notice,"InterpolateStates : helper.run returned an empty path");
+                    }
                 }
-                else
+                catch(...)
                 {
-                    hppDout(notice,"InterpolateStates : helper.run returned an empty path");
-                    valid[i] = false;
+                    errors[i] = std::current_exception();
                 }
             }
-            numValid = checkPath(distance, valid);
-        }while(numValid < distance);
-
+            std::vector<std::size_t> failed;
+            for(std::size_t k = 0; k < pending.size(); ++k)
+            {
+                if(errors[pending[k]])
+                {
+                    fullbody->device_->controlComputation (flag);
+                    std::rethrow_exception(errors[pending[k]]);
+                }
+                if(!res[pending[k]])
+                    failed.push_back(pending[k]);
+            }
+            pending.swap(failed);
+        }
+        std::size_t numValid = checkPath(res);
         fullbody->device_->controlComputation (flag);
         return ConcatenateAndResizePath(res, numValid, keepExtraDof, fullbody->device_);
     }
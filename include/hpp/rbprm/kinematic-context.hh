@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_RBPRM_KINEMATIC_CONTEXT_HH
+#define HPP_RBPRM_KINEMATIC_CONTEXT_HH
+
+#include <hpp/rbprm/config.hh>
+#include <hpp/rbprm/rbprm-limb.hh>
+#include <hpp/rbprm/projection/projector-cache.hh>
+#include <hpp/pinocchio/device.hh>
+#include <hpp/pinocchio/frame.hh>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hpp {
+namespace rbprm {
+
+HPP_PREDEF_CLASS(RbPrmFullBody);
+class RbPrmFullBody;
+typedef std::shared_ptr<RbPrmFullBody> RbPrmFullBodyPtr_t;
+
+HPP_PREDEF_CLASS(KinematicContext);
+class KinematicContext;
+typedef std::shared_ptr<KinematicContext> KinematicContextPtr_t;
+typedef std::vector<KinematicContextPtr_t> T_KinematicContext;
+
+/// Device on which the kinematic queries of contact generation
+/// (kinematic constraints, equilibrium, center of mass) are evaluated.
+/// A context returned by create owns a clone of the device of the full body: several threads
+/// can then run queries on the same RbPrmFullBody, each one with its own context.
+/// A context returned by shared evaluates the queries on RbPrmFullBody::device_,
+/// which is what the functions taking a RbPrmFullBody instead of a context do.
+///
+/// The following queries still use RbPrmFullBody::device_ whatever the context, and must not be
+/// run concurrently on the same full body:
+/// - the contact sampling of ComputeContacts and CollideOctree, which place the limbs on device_,
+/// - reachability::isReachableDynamic.
+/// The projections of a context are done with the projectors of its projectorCache, which a context owning
+/// its device does not share: each context must then be used by a single thread at a time.
+/// The collision validations of the full body are thread safe as long as the device has enough data
+/// (see createKinematicContexts).
+class HPP_RBPRM_DLLAPI KinematicContext {
+ public:
+  /// Creates a context owning a clone of the device of fullBody
+  static KinematicContextPtr_t create(const RbPrmFullBodyPtr_t& fullBody);
+  /// Creates a context evaluating the queries on the device of fullBody
+  static KinematicContextPtr_t shared(const RbPrmFullBodyPtr_t& fullBody);
+
+ public:
+  const RbPrmFullBodyPtr_t& fullBody() const { return fullBody_; }
+  const pinocchio::DevicePtr_t& device() const { return device_; }
+  /// \return whether the device of the context is a clone of the device of the full body
+  bool ownsDevice() const;
+
+  /// Sets the configuration of the device and computes its forward kinematics
+  void setConfiguration(pinocchio::ConfigurationIn_t configuration);
+  /// \return the joint of the device of the context with the same name as joint,
+  /// joint being a joint of the device of the full body
+  pinocchio::JointPtr_t joint(const pinocchio::JointPtr_t& joint) const;
+  /// \return the frame of the effector of a limb of the full body, in the device of the context
+  pinocchio::Frame effector(const RbPrmLimbPtr_t& limb) const;
+  /// \return the transformation of the effector of a limb of the full body
+  /// for the last configuration set
+  pinocchio::Transform3f effectorTransformation(const RbPrmLimbPtr_t& limb) const;
+  /// \return the position of the center of mass for the last configuration set
+  fcl::Vec3f positionCenterOfMass() const;
+  /// \return the projectors built on the device of the context, the ones of the full body if the context
+  /// does not own its device. The cache of a context owning its device is not cleared when a limb is added
+  /// to the full body, the contexts must then be created after the limbs.
+  const projection::ProjectorCachePtr_t& projectorCache() const;
+
+ private:
+  KinematicContext(const RbPrmFullBodyPtr_t& fullBody, const pinocchio::DevicePtr_t& device);
+
+ private:
+  const RbPrmFullBodyPtr_t fullBody_;
+  const pinocchio::DevicePtr_t device_;
+  /// effector frames of the cloned device, indexed by frame name
+  std::map<std::string, pinocchio::Frame> effectors_;
+  /// root joints of the limbs in the cloned device, indexed by joint name
+  std::map<std::string, pinocchio::JointPtr_t> joints_;
+  /// projectors of the cloned device
+  projection::ProjectorCachePtr_t projectorCache_;
+};  // class KinematicContext
+
+/// Creates nbContexts contexts owning their own clone of the device of fullBody.
+/// The number of data of the device of the full body is increased to nbContexts if needed,
+/// so that the collision validations of the full body can be used by as many threads
+/// (see pinocchio::Device::numberDeviceData).
+HPP_RBPRM_DLLAPI T_KinematicContext createKinematicContexts(const RbPrmFullBodyPtr_t& fullBody,
+                                                            const std::size_t nbContexts);
+}  // namespace rbprm
+}  // namespace hpp
+
+#endif  // HPP_RBPRM_KINEMATIC_CONTEXT_HH
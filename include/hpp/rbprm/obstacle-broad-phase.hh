@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_RBPRM_OBSTACLE_BROAD_PHASE_HH
+#define HPP_RBPRM_OBSTACLE_BROAD_PHASE_HH
+
+#include <hpp/rbprm/config.hh>
+#include <hpp/core/collision-validation.hh>
+#include <hpp/core/validation-report.hh>
+#include <hpp/fcl/BV/AABB.h>
+
+#include <vector>
+
+namespace hpp {
+namespace rbprm {
+
+HPP_PREDEF_CLASS(ObstacleBroadPhase);
+typedef std::shared_ptr<ObstacleBroadPhase> ObstacleBroadPhasePtr_t;
+
+/// \addtogroup validation
+/// \{
+
+/// Bounding volume hierarchy over the axis aligned bounding boxes of static obstacles.
+/// It is shared by the collision validations of the trunk and of the ROMs of a RbPrmValidation:
+/// the collision pairs of a validation are only tested against the obstacles whose bounding box
+/// intersects the one of the body, so that the cost of a validation depends on the number of obstacles
+/// near the robot instead of the total number of obstacles.
+/// The obstacles must not move once added.
+class HPP_RBPRM_DLLAPI ObstacleBroadPhase {
+ public:
+  static ObstacleBroadPhasePtr_t create();
+
+  /// Adds an obstacle, ignored if already added
+  void addObstacle(const core::CollisionObjectConstPtr_t& obstacle);
+
+  /// Adds the obstacles of the collision pairs of validation
+  void addObstacles(const core::CollisionValidation& validation);
+
+  void clear();
+
+  std::size_t size() const { return entries_.size(); }
+
+  /// Builds the hierarchy if obstacles were added since it was last built.
+  /// The queries are read-only once the hierarchy is built, they can then be run by several threads.
+  void build();
+
+  /// \retval obstacles the obstacles whose bounding box intersects box
+  void query(const hpp::fcl::AABB& box, std::vector<const pinocchio::CollisionObject*>& obstacles);
+
+  /// Tests the collision pairs of validation for the configuration config of robot, as
+  /// core::CollisionValidation::validate does, skipping the obstacles far from the body of each pair.
+  /// The pairs whose obstacle was not added are always tested.
+  /// \param robot the robot whose bodies are the first objects of the collision pairs of validation
+  /// \param computeAllContacts if true, all the pairs in collision are reported in
+  /// a core::AllCollisionsValidationReport, otherwise the test stops at the first collision
+  /// \return whether no pair is in collision
+  bool validate(const pinocchio::DevicePtr_t& robot, core::CollisionValidation& validation,
+                const core::Configuration_t& config, const bool computeAllContacts,
+                core::ValidationReportPtr_t& validationReport);
+
+ protected:
+  ObstacleBroadPhase();
+
+ private:
+  struct Entry {
+    core::CollisionObjectConstPtr_t obstacle_;
+    hpp::fcl::AABB box_;
+  };
+  /// node of the hierarchy, containing the entries [begin_, end_) when it is a leaf
+  struct Node {
+    hpp::fcl::AABB box_;
+    std::size_t begin_, end_;
+    std::size_t left_, right_;
+  };
+
+  std::size_t buildNode(const std::size_t begin, const std::size_t end);
+
+ private:
+  std::vector<Entry> entries_;
+  /// obstacles of entries_, sorted
+  std::vector<const pinocchio::CollisionObject*> obstacles_;
+  std::vector<Node> nodes_;
+  bool built_;
+};  // class ObstacleBroadPhase
+/// \}
+}  // namespace rbprm
+}  // namespace hpp
+
+#endif  // HPP_RBPRM_OBSTACLE_BROAD_PHASE_HH
@@ -23,6 +23,8 @@
 #include <hpp/rbprm/planner/rbprm-steering-kinodynamic.hh>
 #include <hpp/rbprm/planner/steering-method-parabola.hh>
 #include <hpp/rbprm/rbprm-path-validation.hh>
+#include <hpp/rbprm/planner/rbprm-node.hh>
+#include <vector>
 
 namespace hpp {
 namespace rbprm {
@@ -59,6 +61,16 @@ class DynamicPlanner : public core::BiRRTPlanner {
 
   virtual core::PathVectorPtr_t finishSolve(const core::PathVectorPtr_t& path);
 
+  /// Adds a worker to the planner. Once workers are added, each step shoots one configuration per worker,
+  /// and the workers extend the roadmap toward them in parallel, each one with its own copy of the steering
+  /// method. The nodes and edges found by the workers are then added to the roadmap sequentially.
+  /// \param pathValidation path validation used by the worker. It must not share its collision validations
+  /// with the path validation of the problem nor with other workers, as their collision pairs are reordered
+  /// during validation. The number of data of the robot and of its ROMs is increased to the number of workers
+  /// (see pinocchio::Device::numberDeviceData).
+  void addWorker(const core::PathValidationPtr_t& pathValidation);
+  std::size_t numberOfWorkers() const { return workers_.size(); }
+
  protected:
   /// Constructor
   DynamicPlanner(core::ProblemConstPtr_t problem, const RoadmapPtr_t& roadmap);
@@ -84,6 +96,10 @@ class DynamicPlanner : public core::BiRRTPlanner {
   core::PathPtr_t extendInternal(core::ConfigurationPtr_t& qProj_, const core::NodePtr_t& near,
                                  const core::ConfigurationPtr_t& target, bool reverse = false);
 
+  core::PathPtr_t extendInternal(const SteeringMethodKinodynamicPtr_t& sm, core::ConfigurationPtr_t& qProj_,
+                                 const core::NodePtr_t& near, const core::ConfigurationPtr_t& target,
+                                 bool reverse = false);
+
   bool tryParabolaPath(const core::NodePtr_t& near, core::ConfigurationPtr_t q_jump,
                        const core::ConfigurationPtr_t& target, bool reverse, core::NodePtr_t& x_jump,
                        core::NodePtr_t& nodeReached, core::PathPtr_t& kinoPath, core::PathPtr_t& paraPath);
@@ -92,12 +108,40 @@ class DynamicPlanner : public core::BiRRTPlanner {
                                  bool reverse);
 
  private:
+  struct Worker {
+    SteeringMethodKinodynamicPtr_t sm_;
+    core::PathValidationPtr_t pathValidation_;
+    core::ConfigurationPtr_t qProj_;
+  };
+  /// extension of the roadmap computed by a worker, toward a random configuration from
+  /// the start component or from an end component
+  struct Extension {
+    Extension() : valid_(false) {}
+    core::NodePtr_t near_;
+    core::PathPtr_t path_;
+    core::PathPtr_t validPath_;
+    bool valid_;
+  };
+  typedef std::vector<Extension> T_Extension;
+
+  /// Parallel version of oneStep, used when workers are added
+  void oneStepParallel();
+  /// Extends the start component and the end components toward q_rand, without modifying the roadmap
+  void extend(Worker& worker, const core::ConfigurationPtr_t& q_rand, T_Extension& extensions);
+  /// Adds to the roadmap the nodes and edges of the extensions computed by extend, as oneStep does.
+  /// \return whether the start component has been connected to an end component
+  bool addExtensions(const core::ConfigurationPtr_t& q_rand, const T_Extension& extensions);
+
+ private:
+  std::vector<Worker> workers_;
   core::ConfigurationPtr_t qProj_;
   DynamicPlannerWkPtr_t weakPtr_;
   const core::RoadmapPtr_t roadmap_;
   const SteeringMethodKinodynamicPtr_t sm_;
   const SteeringMethodParabolaPtr_t smParabola_;
   const RbPrmPathValidationPtr_t rbprmPathValidation_;
+  /// contact surfaces of the obstacles, shared by the GIWC computations of all the nodes
+  const core::ContactSurfaceCachePtr_t contactSurfaces_;
   double sizeFootX_, sizeFootY_;
   bool rectangularContact_;
   bool tryJump_;
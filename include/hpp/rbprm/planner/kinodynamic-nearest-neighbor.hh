@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_RBPRM_KINODYNAMIC_NEAREST_NEIGHBOR_HH
+#define HPP_RBPRM_KINODYNAMIC_NEAREST_NEIGHBOR_HH
+
+#include <hpp/rbprm/config.hh>
+#include <hpp/core/nearest-neighbor.hh>
+#include <hpp/core/distance.hh>
+#include <hpp/pinocchio/device.hh>
+
+#include <vector>
+
+namespace hpp {
+namespace rbprm {
+
+HPP_PREDEF_CLASS(KinodynamicNearestNeighbor);
+typedef std::shared_ptr<KinodynamicNearestNeighbor> KinodynamicNearestNeighborPtr_t;
+
+/// Nearest neighbor search on the nodes of a roadmap, indexed by the position and the velocity of their root
+/// (the velocity being stored in the extra config space).
+/// The nodes are stored in k-d trees of increasing sizes: each new node is added to a tree of size 1,
+/// and two trees of the same size are merged into a new tree (rebuilt from scratch) of twice the size.
+/// The queries use the exact distance of the roadmap, the trees being only used to prune the nodes:
+/// the distance must verify, for each axis i of the root,
+/// d(q1, q2) >= max(|p1_i - p2_i| / vMax, |v1_i - v2_i| / aMax)
+/// which is the case of core::KinodynamicDistance, vMax being increased to the largest velocity of the nodes.
+class HPP_RBPRM_DLLAPI KinodynamicNearestNeighbor : public core::NearestNeighbor {
+ public:
+  /// \param distance distance of the roadmap
+  /// \param robot robot whose configurations are stored in the roadmap
+  /// \param vMax bound on the velocity of the root along each axis
+  /// \param aMax bound on the acceleration of the root along each axis
+  static KinodynamicNearestNeighborPtr_t create(const core::DistancePtr_t& distance,
+                                                const pinocchio::DevicePtr_t& robot, const core::value_type vMax,
+                                                const core::value_type aMax);
+
+  virtual void clear();
+
+  virtual void addNode(const core::NodePtr_t& node);
+
+  virtual core::NodePtr_t search(core::ConfigurationIn_t configuration,
+                                 const core::ConnectedComponentPtr_t& connectedComponent, core::value_type& distance,
+                                 bool reverse = false);
+
+  virtual core::NodePtr_t search(const core::NodePtr_t& node, const core::ConnectedComponentPtr_t& connectedComponent,
+                                 core::value_type& distance);
+
+  /// \retval distance distance to the farthest node returned
+  virtual core::Nodes_t KnearestSearch(core::ConfigurationIn_t configuration,
+                                       const core::ConnectedComponentPtr_t& connectedComponent, const std::size_t K,
+                                       core::value_type& distance);
+
+  virtual core::Nodes_t KnearestSearch(const core::NodePtr_t& node,
+                                       const core::ConnectedComponentPtr_t& connectedComponent, const std::size_t K,
+                                       core::value_type& distance);
+
+  virtual core::Nodes_t KnearestSearch(core::ConfigurationIn_t configuration, const core::RoadmapPtr_t& roadmap,
+                                       const std::size_t K, core::value_type& distance);
+
+  virtual core::NodeVector_t withinBall(core::ConfigurationIn_t configuration,
+                                        const core::ConnectedComponentPtr_t& connectedComponent,
+                                        core::value_type maxDistance);
+
+  /// The connected component of a node is read when it is tested, merging components has nothing to update
+  virtual void merge(core::ConnectedComponentPtr_t, core::ConnectedComponentPtr_t) {}
+
+  virtual core::DistancePtr_t distance() const { return distance_; }
+
+  std::size_t size() const { return size_; }
+
+ public:
+  /// position and velocity of the root, not aligned so that entries can be stored in std::vector
+  typedef Eigen::Matrix<core::value_type, 6, 1, Eigen::DontAlign> Key;
+  struct Entry {
+    Key key_;
+    core::NodePtr_t node_;
+  };
+  struct Query;
+
+ protected:
+  KinodynamicNearestNeighbor(const core::DistancePtr_t& distance, const pinocchio::DevicePtr_t& robot,
+                             const core::value_type vMax, const core::value_type aMax);
+
+ private:
+  /// k-d tree stored in an array: the split entry of a range is in its middle,
+  /// and its split dimension at the same index
+  struct Tree {
+    std::vector<Entry> entries_;
+    std::vector<unsigned char> dimensions_;
+  };
+
+  Key key(core::ConfigurationIn_t configuration) const;
+  /// weights of the lower bound of the distance to a query, max_i weights_i |key_i - queryKey_i|
+  Key weights(const Key& queryKey) const;
+  void build(Tree& tree, const std::size_t begin, const std::size_t end);
+  void search(const Tree& tree, const std::size_t begin, const std::size_t end, const core::value_type lowerBound,
+              Query& query) const;
+  void search(Query& query) const;
+  core::Nodes_t KnearestSearch(core::ConfigurationIn_t configuration,
+                               const core::ConnectedComponentPtr_t& connectedComponent, const std::size_t K,
+                               core::value_type& distance, bool reverse);
+
+ private:
+  const core::DistancePtr_t distance_;
+  const core::size_type velocityIndex_;
+  const core::value_type vMax_;
+  const core::value_type aMax_;
+  /// trees_[i] is either empty or contains 2^i entries
+  std::vector<Tree> trees_;
+  std::size_t size_;
+  /// largest velocity of the root of the nodes along each axis
+  core::value_type maxVelocity_;
+};  // class KinodynamicNearestNeighbor
+
+}  // namespace rbprm
+}  // namespace hpp
+
+#endif  // HPP_RBPRM_KINODYNAMIC_NEAREST_NEIGHBOR_HH
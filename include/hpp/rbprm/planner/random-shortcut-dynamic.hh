@@ -22,6 +22,7 @@
 #include <hpp/core/path-optimization/random-shortcut.hh>
 #include <hpp/rbprm/planner/rbprm-steering-kinodynamic.hh>
 #include <hpp/rbprm/rbprm-path-validation.hh>
+#include <vector>
 
 namespace hpp {
 namespace rbprm {
@@ -53,12 +54,48 @@ class RandomShortcutDynamic : public core::pathOptimization::RandomShortcut {
   /// Optimize path
   virtual core::PathVectorPtr_t optimize(const core::PathVectorPtr_t& path);
 
+  /// Adds a worker to the optimizer. Once workers are added, each iteration samples one shortcut per worker,
+  /// and the three segments of all the shortcuts are steered and validated in parallel, each worker using
+  /// its own copy of the steering method. The shortcut that reduces the most the length of the path is kept.
+  /// The workers are not used if the problem has a path projector.
+  /// \param pathValidation path validation used by the worker. It must not share its collision validations
+  /// with the path validation of the problem nor with other workers, as their collision pairs are reordered
+  /// during validation. The number of data of the robot and of its ROMs is increased to the number of workers
+  /// (see pinocchio::Device::numberDeviceData).
+  void addWorker(const RbPrmPathValidationPtr_t& pathValidation);
+  std::size_t numberOfWorkers() const { return workers_.size(); }
+
  protected:
   RandomShortcutDynamic(core::ProblemConstPtr_t problem);
 
   core::PathPtr_t steer(core::ConfigurationIn_t q1, core::ConfigurationIn_t q2) const;
 
  private:
+  struct Worker {
+    SteeringMethodKinodynamicPtr_t sm_;
+    RbPrmPathValidationPtr_t pathValidation_;
+  };
+  /// shortcut of the path between the parameters t_[1] and t_[2], the path being replaced by
+  /// a straight path on each segment [t_[i], t_[i+1]] where it is valid and shorter
+  struct Shortcut {
+    core::value_type t_[4];
+    core::Configuration_t q_[4];
+    core::PathVectorPtr_t original_[3];
+    core::value_type originalLength_[3];
+    core::PathPtr_t straight_[3];
+    bool valid_[3];
+  };
+
+  /// Parallel version of optimize, used when workers are added
+  core::PathVectorPtr_t optimizeParallel(const core::PathVectorPtr_t& path);
+  /// Steers and validates the segment i of shortcut, with the steering method and the validation of worker
+  void validateSegment(const Worker& worker, const core::value_type mass, Shortcut& shortcut,
+                       const std::size_t i) const;
+  core::PathPtr_t steer(const Worker& worker, const core::value_type mass, core::ConfigurationIn_t q1,
+                        core::ConfigurationIn_t q2) const;
+
+ private:
+  std::vector<Worker> workers_;
   const SteeringMethodKinodynamicPtr_t sm_;
   const RbPrmPathValidationPtr_t rbprmPathValidation_;
   double sizeFootX_, sizeFootY_;
@@ -4,6 +4,10 @@
 #include <hpp/core/node.hh>
 #include <hpp/rbprm/rbprm-validation-report.hh>
 #include <hpp/centroidal-dynamics/centroidal_dynamics.hh>
+#include <hpp/rbprm/utils/algorithms.h>
+
+#include <map>
+#include <vector>
 
 namespace hpp {
 namespace pinocchio {
@@ -14,23 +18,57 @@ namespace core {
 
 HPP_PREDEF_CLASS(RbprmNode);
 typedef RbprmNode* RbprmNodePtr_t;
+HPP_PREDEF_CLASS(ContactSurfaceCache);
+typedef std::shared_ptr<ContactSurfaceCache> ContactSurfaceCachePtr_t;
 
 typedef centroidal_dynamics::MatrixXX MatrixXX;
 typedef centroidal_dynamics::Matrix6X Matrix6X;
 typedef centroidal_dynamics::Matrix63 Matrix63;
 typedef centroidal_dynamics::Vector6 Vector6;
+typedef centroidal_dynamics::VectorX VectorX;
+typedef Eigen::Matrix<double, Eigen::Dynamic, 3> MatrixX3;
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Matrix3X;
+/// Contact surfaces of the obstacles found in contact with the ROMs when computing the GIWC of the nodes.
+/// The plane of an obstacle (defined by its first triangle) and the convex hull of its vertices only depend
+/// on its placement, they are computed once per obstacle; only the ROM is placed at the configuration of each node.
+class HPP_CORE_DLLAPI ContactSurfaceCache {
+ public:
+  struct Surface {
+    CollisionObjectConstPtr_t obstacle_;
+    fcl::Transform3f transform_;
+    geom::Point normal_;
+    geom::Point point_;
+    geom::T_Point hull_;
+  };
+
+  static ContactSurfaceCachePtr_t create() { return ContactSurfaceCachePtr_t(new ContactSurfaceCache()); }
+
+  /// \return the surface of obstacle, computed again if the obstacle moved since it was stored
+  const Surface& surface(const CollisionObjectConstPtr_t& obstacle, pinocchio::DeviceData& deviceData);
+
+  void clear() { surfaces_.clear(); }
+
+  std::size_t size() const { return surfaces_.size(); }
+
+ private:
+  ContactSurfaceCache() {}
+
+  std::map<const pinocchio::CollisionObject*, Surface> surfaces_;
+};  // class ContactSurfaceCache
+
 class HPP_CORE_DLLAPI RbprmNode : public Node {
  public:
   /// Constructor
   /// \param configuration configuration stored in the new node
   /// \note A new connected component is created. For consistency, the
   ///       new node is not registered in the connected component.
-  RbprmNode(const ConfigurationPtr_t& configuration) : Node(configuration) {}
+  RbprmNode(const ConfigurationPtr_t& configuration)
+      : Node(configuration), accelerationPolytopeComputed_(false) {}
   /// Constructor
   /// \param configuration configuration stored in the new node
   /// \param connectedComponent connected component the node belongs to.
   RbprmNode(const ConfigurationPtr_t& configuration, ConnectedComponentPtr_t connectedComponent)
-      : Node(configuration, connectedComponent) {}
+      : Node(configuration, connectedComponent), accelerationPolytopeComputed_(false) {}
 
   fcl::Vec3f getNormal() { return normal_; }
 
@@ -53,15 +91,24 @@ class HPP_CORE_DLLAPI RbprmNode : public Node {
 
   Matrix6X getIPhat() { return IP_hat_; }
 
-  void setG(Matrix6X G) { G_ = G; }
+  void setG(Matrix6X G) {
+    G_ = G;
+    accelerationPolytopeComputed_ = false;
+  }
 
   Matrix6X getG() { return G_; }
 
-  void setH(Matrix63 H) { H_ = H; }
+  void setH(Matrix63 H) {
+    H_ = H;
+    accelerationPolytopeComputed_ = false;
+  }
 
   Matrix63 getH() { return H_; }
 
-  void seth(Vector6 h) { h_ = h; }
+  void seth(Vector6 h) {
+    h_ = h;
+    accelerationPolytopeComputed_ = false;
+  }
 
   Vector6 geth() { return h_; }
 
@@ -69,13 +116,38 @@ class HPP_CORE_DLLAPI RbprmNode : public Node {
 
   size_type getNumberOfContacts() { return numberOfContacts_; }
 
+  /// \param surfaces if provided, the contact surfaces of the obstacles are read from this cache
   void fillNodeMatrices(ValidationReportPtr_t report, bool rectangularContact, double sizeFootx, double sizeFooty,
-                        double m, double mu, pinocchio::RbPrmDevicePtr_t device);
+                        double m, double mu, pinocchio::RbPrmDevicePtr_t device,
+                        const ContactSurfaceCachePtr_t& surfaces = ContactSurfaceCachePtr_t());
 
-  void chooseBestContactSurface(ValidationReportPtr_t report, hpp::pinocchio::RbPrmDevicePtr_t device);
+  void chooseBestContactSurface(ValidationReportPtr_t report, hpp::pinocchio::RbPrmDevicePtr_t device,
+                                const ContactSurfaceCachePtr_t& surfaces = ContactSurfaceCachePtr_t());
 
   Eigen::Quaterniond getQuaternion();
 
+  /// Compute the polytope of the admissible accelerations of the center of mass, {a | A a <= b}:
+  /// a is admissible if H a - h is in the cone generated by the columns of G. The inequalities of this cone
+  /// are computed once by double description (cdd), the admissibility of an acceleration and the maximal
+  /// acceleration along a direction are then found without solving a LP.
+  /// Must be called again if G, H or h are modified.
+  /// \return false if the double description failed, the LP must then be used
+  bool computeAccelerationPolytope();
+
+  bool accelerationPolytopeComputed() const { return accelerationPolytopeComputed_; }
+
+  /// Whether the acceleration a is admissible, the polytope must be computed
+  bool isAccelerationAdmissible(const centroidal_dynamics::Vector3& a) const;
+
+  /// Whether each column of accelerations is admissible, tested with one matrix product.
+  /// The polytope must be computed
+  /// \retval admissible admissible[i] is true if the column i of accelerations is admissible
+  void isAccelerationAdmissible(const Matrix3X& accelerations, std::vector<bool>& admissible) const;
+
+  /// Maximal alpha such that alpha * direction is admissible, the polytope must be computed
+  /// \return 0 if no acceleration along direction is admissible, infinity if alpha is not bounded
+  double maximumAcceleration(const centroidal_dynamics::Vector3& direction) const;
+
  private:
   fcl::Vec3f normal_;
   RbprmValidationReportPtr_t collisionReport_;
@@ -88,6 +160,9 @@ class HPP_CORE_DLLAPI RbprmNode : public Node {
   Matrix63 H_;
   Vector6 h_;
   size_type numberOfContacts_;
+  bool accelerationPolytopeComputed_;
+  MatrixX3 accelerationA_;
+  VectorX accelerationb_;
 
 };  // class
 
@@ -3,6 +3,7 @@
 
 #include <hpp/core/roadmap.hh>
 #include <hpp/rbprm/planner/rbprm-node.hh>
+#include <hpp/rbprm/planner/kinodynamic-nearest-neighbor.hh>
 #include <hpp/util/debug.hh>
 #include <hpp/pinocchio/configuration.hh>
 
@@ -20,6 +21,16 @@ class HPP_CORE_DLLAPI RbprmRoadmap : public Roadmap {
     return RbprmRoadmapPtr_t(ptr);
   }
 
+  /// Return shared pointer to new instance, whose nearest neighbor queries are indexed
+  /// by the position and velocity of the root (see rbprm::KinodynamicNearestNeighbor).
+  /// \param vMax, aMax bounds on the velocity and acceleration of the root used by distance
+  static RbprmRoadmapPtr_t create(const DistancePtr_t& distance, const DevicePtr_t& robot, const value_type vMax,
+                                  const value_type aMax) {
+    RbprmRoadmapPtr_t roadmap = create(distance, robot);
+    roadmap->nearestNeighbor(rbprm::KinodynamicNearestNeighbor::create(distance, robot, vMax, aMax));
+    return roadmap;
+  }
+
   virtual ~RbprmRoadmap() { clear(); }
 
   /* virtual RbprmNodePtr_t addNode (const ConfigurationPtr_t& configuration)
@@ -22,6 +22,8 @@
 #include <hpp/core/steering-method/steering-kinodynamic.hh>
 #include <hpp/rbprm/planner/rbprm-node.hh>
 
+#include <vector>
+
 namespace hpp {
 namespace rbprm {
 
@@ -51,6 +53,14 @@ class HPP_RBPRM_DLLAPI SteeringMethodKinodynamic : public core::steeringMethod::
     }
     return core::PathPtr_t();
   }
+
+  /// Steer from x to each configuration of targets, or from each of them to x if reverse.
+  /// The contacts of x are set to the LP solver once for the whole batch and the buffers of the acceleration
+  /// checks are shared by all the targets.
+  /// \return the paths in the order of targets, null where the steering failed
+  std::vector<core::PathPtr_t> operator()(const core::NodePtr_t x, const std::vector<core::ConfigurationPtr_t>& targets,
+                                          bool reverse = false);
+
   /// Create an instance
   static SteeringMethodKinodynamicPtr_t create(core::ProblemConstPtr_t problem) {
     SteeringMethodKinodynamic* ptr = new SteeringMethodKinodynamic(problem);
@@ -116,11 +126,33 @@ class HPP_RBPRM_DLLAPI SteeringMethodKinodynamic : public core::steeringMethod::
   core::PathPtr_t setSteeringMethodBounds(const core::RbprmNodePtr_t& near, const core::ConfigurationIn_t target,
                                           bool reverse);
 
+  /**
+   * @brief checkAdmissibleAcceleration check if the acceleration a is admissible with the contacts of node,
+   *                                    with the acceleration polytope of the node if it is computed, with a LP
+   *                                    otherwise (G must then be set to sEq_)
+   */
+  bool checkAdmissibleAcceleration(const core::RbprmNodePtr_t& node, const centroidal_dynamics::Vector3& a);
+
+  /**
+   * @brief checkAdmissibleAccelerations check the accelerations of path at each time of times with the contacts of
+   *                                     node, with one matrix product if the acceleration polytope of the node is
+   *                                     computed, with a LP per time otherwise (G must then be set to sEq_)
+   * @param admissible admissible[i] is set to true if the acceleration at times[i] is admissible
+   */
+  void checkAdmissibleAccelerations(const core::RbprmNodePtr_t& node, const core::KinodynamicPathPtr_t& path,
+                                    const std::vector<double>& times, std::vector<bool>& admissible);
+
  private:
   core::DeviceWkPtr_t device_;
   centroidal_dynamics::Vector3 lastDirection_;
   centroidal_dynamics::Equilibrium* sEq_;
   bool boundsUpToDate_;
+  /// true while steering a batch from a node whose G is already set to sEq_
+  bool gUpToDate_;
+  core::Configuration_t q_;
+  core::Matrix3X accelerations_;
+  std::vector<double> times_;
+  std::vector<bool> admissible_;
   SteeringMethodKinodynamicWkPtr_t weak_;
 
 };  // class rbprm-kinodynamic
@@ -22,6 +22,9 @@
 #include <hpp/util/debug.hh>
 #include <hpp/core/steering-method.hh>
 #include <hpp/core/weighed-distance.hh>
+#include <hpp/rbprm/planner/parabola-path.hh>
+#include <hpp/rbprm/rbprm-validation.hh>
+#include <vector>
 
 namespace hpp {
 namespace rbprm {
@@ -86,6 +89,14 @@ class HPP_CORE_DLLAPI SteeringMethodParabola : public core::SteeringMethod {
   // return maximal final (or impact) velocity
   value_type getVImpMax() { return Vimpmax_; }
 
+  /// Set to null the parabolas along which the trunk collides with an obstacle at a configuration sampled
+  /// every step, without validating each parabola.
+  /// The parabolas must link the same configurations with different alpha: they only differ by the height
+  /// of the root at each parameter, so one distance between the trunk and the obstacles at a parameter
+  /// proves that the trunk is collision free at all the heights closer than this distance.
+  static void discardCollidingParabolas(const RbPrmValidationPtr_t& validation, const value_type step,
+                                        std::vector<ParabolaPathPtr_t>& parabolas);
+
  protected:
   /// Constructor with problem
   /// Robot and weighed distance are created from problem
@@ -130,8 +141,8 @@ class HPP_CORE_DLLAPI SteeringMethodParabola : public core::SteeringMethod {
   bool sixth_constraint(const value_type& X, const value_type& Y, value_type* alpha_imp_plus,
                         value_type* alpha_imp_minus) const;
 
-  /// Get the length of the path by numerical integration (Simpson method)
-  /// Length is computed only when the path is created
+  /// Get the length of the path, in closed form: the parabola paths are parameterized by the distance
+  /// travelled in the horizontal plane, theta being the direction of the motion
   virtual value_type computeLength(const core::ConfigurationIn_t q1, const core::ConfigurationIn_t q2,
                                    const vector_t coefs) const;
 
@@ -143,6 +154,9 @@ class HPP_CORE_DLLAPI SteeringMethodParabola : public core::SteeringMethod {
   vector_t computeCoefficients(const value_type alpha, const value_type theta, const value_type X_theta,
                                const value_type Z, const value_type x_theta_0, const value_type z_0) const;
 
+  /// Return the maximal height of the parabola between x_theta_0 and x_theta_imp, in closed form
+  value_type parabMaxHeight(const vector_t coefs, const value_type x_theta_0, const value_type x_theta_imp) const;
+
   /// Return true if the maximal height of the parabola does not exceed the
   /// freeflyer translation bounds, false otherwise.
   bool parabMaxHeightRespected(const vector_t coefs, const value_type x_theta_0, const value_type x_theta_imp) const;
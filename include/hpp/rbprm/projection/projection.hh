@@ -20,6 +20,7 @@
 #define HPP_RBPRM_PROJECTION_HH
 
 #include <hpp/rbprm/rbprm-fullbody.hh>
+#include <hpp/rbprm/kinematic-context.hh>
 #include <hpp/rbprm/rbprm-state.hh>
 #include <hpp/rbprm/reports.hh>
 
@@ -69,6 +70,12 @@ ProjectionReport HPP_RBPRM_DLLAPI projectToRootConfiguration(hpp::rbprm::RbPrmFu
                                                              const hpp::rbprm::State& currentState,
                                                              const Vector3 offset = Vector3::Zero());
 
+/// Same as projectToRootConfiguration with a zero offset, but the projection is computed on the device of context,
+/// with the projectors of its cache (see KinematicContext::projectorCache).
+ProjectionReport HPP_RBPRM_DLLAPI projectToRootConfiguration(const KinematicContextPtr_t& context,
+                                                             const pinocchio::ConfigurationIn_t conf,
+                                                             const hpp::rbprm::State& currentState);
+
 /// Project a configuration such that a given limb configuration is collision free
 /// \param fullBody target Robot
 /// \param limb considered limb
@@ -95,12 +102,35 @@ ProjectionReport HPP_RBPRM_DLLAPI projectSampleToObstacle(
     const sampling::OctreeReport& report, core::CollisionValidationPtr_t validation,
     pinocchio::ConfigurationOut_t configuration, const hpp::rbprm::State& current);
 
+/// Same as projectSampleToObstacle, but the projection and the kinematics are computed on the device of context.
+/// The joints that do not belong to the limb are locked to their value in configuration.
+/// Unless a postural task is used, the projector is kept in the cache of context, the next projections
+/// for the limb only updating the values of the locked joints and the target of the effector.
+/// validation may be shared by several threads if the device it validates has enough data
+/// (see createKinematicContexts).
+ProjectionReport HPP_RBPRM_DLLAPI projectSampleToObstacle(
+    const KinematicContextPtr_t& context, const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
+    const sampling::OctreeReport& report, core::CollisionValidationPtr_t validation,
+    pinocchio::ConfigurationOut_t configuration, const hpp::rbprm::State& current);
+
+ProjectionReport HPP_RBPRM_DLLAPI projectEffector(
+    core::ConfigProjectorPtr_t proj, const KinematicContextPtr_t& context, const std::string& limbId,
+    const hpp::rbprm::RbPrmLimbPtr_t& limb, core::CollisionValidationPtr_t validation,
+    pinocchio::ConfigurationOut_t configuration, const fcl::Matrix3f& rotationTarget, std::vector<bool> rotationFilter,
+    const fcl::Vec3f& positionTarget, const fcl::Vec3f& normal, const hpp::rbprm::State& current);
+
 ProjectionReport HPP_RBPRM_DLLAPI projectEffector(
     core::ConfigProjectorPtr_t proj, const hpp::rbprm::RbPrmFullBodyPtr_t& body, const std::string& limbId,
     const hpp::rbprm::RbPrmLimbPtr_t& limb, core::CollisionValidationPtr_t validation,
     pinocchio::ConfigurationOut_t configuration, const fcl::Matrix3f& rotationTarget, std::vector<bool> rotationFilter,
     const fcl::Vec3f& positionTarget, const fcl::Vec3f& normal, const hpp::rbprm::State& current);
 
+fcl::Transform3f HPP_RBPRM_DLLAPI computeProjectionMatrix(const KinematicContextPtr_t& context,
+                                                          const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                                          const pinocchio::ConfigurationIn_t configuration,
+                                                          const fcl::Vec3f& normal, const fcl::Vec3f& position,
+                                                          const fcl::Matrix3f& rotation = fcl::Matrix3f::Zero());
+
 fcl::Transform3f HPP_RBPRM_DLLAPI computeProjectionMatrix(const hpp::rbprm::RbPrmFullBodyPtr_t& body,
                                                           const hpp::rbprm::RbPrmLimbPtr_t& limb,
                                                           const pinocchio::ConfigurationIn_t configuration,
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_RBPRM_PROJECTOR_CACHE_HH
+#define HPP_RBPRM_PROJECTOR_CACHE_HH
+
+#include <hpp/rbprm/config.hh>
+#include <hpp/core/fwd.hh>
+#include <hpp/constraints/fwd.hh>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hpp {
+namespace rbprm {
+namespace projection {
+
+HPP_PREDEF_CLASS(ProjectorCache);
+typedef std::shared_ptr<ProjectorCache> ProjectorCachePtr_t;
+
+/// Projectors of the projections of a full body or of a kinematic context (see projection.hh),
+/// kept between the calls.
+/// A projector is built the first time a type of projection is done with a set of fixed contacts,
+/// the next projections of this type with the same contacts only update the right hand sides of its
+/// constraints (contact positions, target of the projection, values of the locked joints).
+/// The target rotations of the 6D contacts are right hand sides as well, the orientation constraints having
+/// their output in SO(3).
+/// The cache of a full body is cleared when a limb is added to it, and must be cleared if its device is modified.
+class HPP_RBPRM_DLLAPI ProjectorCache {
+ public:
+  enum ProjectionType { ROOT_POSITION, COM_POSITION, ROOT_CONFIGURATION, STATE_TO_OBSTACLE, SAMPLE_TO_OBSTACLE };
+
+  struct Key {
+    explicit Key(const ProjectionType type) : type_(type), lockOtherJoints_(false) {}
+
+    ProjectionType type_;
+    /// fixed contacts of the state projected
+    std::vector<std::string> contacts_;
+    /// limb moved by the projection, if any
+    std::string limb_;
+    bool lockOtherJoints_;
+
+    bool operator<(const Key& other) const;
+  };
+
+  struct Entry {
+    core::ConfigProjectorPtr_t projector_;
+    /// position constraints of the contacts, in the order of Key::contacts_
+    std::vector<constraints::ImplicitPtr_t> contacts_;
+    /// orientation constraints of the contacts, in the order of Key::contacts_, null for the 3D contacts
+    std::vector<constraints::ImplicitPtr_t> orientations_;
+    /// constraint on the position of the root, the center of mass or the effector of the limb moved
+    constraints::ImplicitPtr_t target_;
+    /// constraint on the orientation of the effector of the limb moved, null for a 3D contact
+    constraints::ImplicitPtr_t targetOrientation_;
+    std::vector<constraints::ImplicitPtr_t> lockedJoints_;
+  };
+
+  /// \param maxSize the cache is cleared when it holds maxSize projectors and a new one is needed
+  static ProjectorCachePtr_t create(const std::size_t maxSize = 100);
+
+  /// \return the entry of key, null if it is not in the cache
+  Entry* find(const Key& key);
+
+  /// Adds an empty entry for key, the cache being cleared first if it is full
+  Entry& add(const Key& key);
+
+  void clear() { entries_.clear(); }
+
+  std::size_t size() const { return entries_.size(); }
+
+ private:
+  ProjectorCache(const std::size_t maxSize) : maxSize_(maxSize) {}
+
+  const std::size_t maxSize_;
+  std::map<Key, Entry> entries_;
+};  // class ProjectorCache
+}  // namespace projection
+}  // namespace rbprm
+}  // namespace hpp
+
+#endif  // HPP_RBPRM_PROJECTOR_CACHE_HH
@@ -27,6 +27,7 @@
 #include <hpp/core/problem-solver.hh>
 #include <hpp/rbprm/sampling/heuristic.hh>
 #include <hpp/rbprm/reports.hh>
+#include <hpp/rbprm/projection/projector-cache.hh>
 #include <hpp/rbprm/interpolation/spline/bezier-path.hh>
 #include <vector>
 
@@ -75,18 +76,24 @@ class HPP_RBPRM_DLLAPI RbPrmFullBody {
   /// contact. This can be problematic in terms of performance. The default value is 3 cm. \param resolution,
   /// resolution of the octree voxels. The samples generated are stored in an octree data \param
   /// disableEffectorCollision, whether collision detection should be disabled for end effector bones
+  /// \param nbThreads number of threads used to generate the samples. If greater than 1, each thread
+  /// uses its own clone of the device and a random generator seeded from seed.
+  /// \param seed seed used for the generation of the samples when nbThreads > 1
   void AddLimb(const std::string& id, const std::string& name, const std::string& effectorName,
                const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset, const fcl::Vec3f& normal, const double x,
                const double y, const core::ObjectStdVector_t& collisionObjects, const std::size_t nbSamples,
                const std::string& heuristic = "static", const double resolution = 0.03,
                ContactType contactType = _6_DOF, const bool disableEffectorCollision = false, const bool grasp = false,
-               const std::string& kinematicConstraintsPath = std::string(), const double kinematicConstraintsMin = 0.);
+               const std::string& kinematicConstraintsPath = std::string(), const double kinematicConstraintsMin = 0.,
+               const std::size_t nbThreads = 1, const unsigned int seed = 0);
 
   /// Creates a Limb for the robot,
   /// identified by its name. Stores a sample
   /// container, used for requests
   ///
-  /// \param database: path to the sample database used for the limbs
+  /// \param database: path to the sample database used for the limbs. Both the text format and the binary
+  /// format written by saveLimbInfoAndDatabaseBinary are accepted, the format being detected from the file header.
+  /// Binary databases are memory mapped and loaded without parsing.
   /// \param id: user defined id for the limb. Must be unique.
   /// The id is used if several contact points are defined for the same limb (ex: the knee and the foot)
   /// \param collisionObjects objects to be considered for collisions with the limb. TODO remove
@@ -125,6 +132,7 @@ class HPP_RBPRM_DLLAPI RbPrmFullBody {
   const rbprm::T_Limb& GetNonContactingLimbs() { return nonContactingLimbs_; }
   const T_LimbGroup& GetGroups() { return limbGroups_; }
   const core::CollisionValidationPtr_t& GetCollisionValidation() { return collisionValidation_; }
+  const sampling::HeuristicFactory& GetHeuristicFactory() const { return factory_; }
   const std::map<std::string, core::CollisionValidationPtr_t>& GetLimbCollisionValidation() {
     return limbcollisionValidations_;
   }
@@ -141,12 +149,18 @@ class HPP_RBPRM_DLLAPI RbPrmFullBody {
   void usePosturalTaskContactCreation(bool usePosturalTaskContactCreation) {
     usePosturalTaskContactCreation_ = usePosturalTaskContactCreation;
   }
+  /// If not 0, only the maxContactCandidates best contact candidates of each limb, according to its
+  /// heuristic, are considered during contact generation (see contact::ContactGenHelper::maxCandidates_).
+  std::size_t maxContactCandidates() const { return maxContactCandidates_; }
+  void maxContactCandidates(const std::size_t maxContactCandidates) { maxContactCandidates_ = maxContactCandidates; }
   bool addEffectorTrajectory(const size_t pathId, const std::string& effectorName, const bezier_Ptr& trajectory);
   bool addEffectorTrajectory(const size_t pathId, const std::string& effectorName,
                              const std::vector<bezier_Ptr>& trajectories);
   bool getEffectorsTrajectories(const size_t pathId, EffectorTrajectoriesMap_t& result);
   bool getEffectorTrajectory(const size_t pathId, const std::string& effectorName, std::vector<bezier_Ptr>& result);
   bool toggleNonContactingLimb(std::string name);
+  /// Projectors of the projections of this full body, see projection.hh
+  const projection::ProjectorCachePtr_t& projectorCache() const { return projectorCache_; }
 
  private:
   core::CollisionValidationPtr_t collisionValidation_;
@@ -161,9 +175,12 @@ class HPP_RBPRM_DLLAPI RbPrmFullBody {
   pinocchio::Configuration_t postureWeights_;  // weight used to compute the distance in the postural tasks
   bool usePosturalTaskContactCreation_;  // if true, during the contact creation the orientation of the feet along the
                                          // contact normal is optimized for a postural task
+  std::size_t maxContactCandidates_;
   std::map<size_t, EffectorTrajectoriesMap_t>
       effectorsTrajectoriesMaps_;  // the map link the pathIndex (the same as in the wholeBody paths in problem solver)
                                    // to a map of trajectories for each effectors.
+  const projection::ProjectorCachePtr_t projectorCache_;
+
  private:
   void AddLimbPrivate(rbprm::RbPrmLimbPtr_t limb, const std::string& id, const std::string& name,
                       const hpp::core::ObjectStdVector_t& collisionObjects, const bool disableEffectorCollision,
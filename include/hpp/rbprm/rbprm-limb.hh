@@ -88,18 +88,27 @@ class HPP_RBPRM_DLLAPI RbPrmLimb {
   /// contact. This can be problematic in terms of performance. The default value is 3 cm. \param contactType Whether
   /// the contact is a surface contact (orientation matters) or a punctual contact \param disableEndEffectorCollision
   /// Whether the end effector bodies should be counted for collision detection
+  /// \param nbThreads number of threads used to generate the samples
+  /// \param seed seed used for the generation of the samples when nbThreads > 1
   static RbPrmLimbPtr_t create(const pinocchio::JointPtr_t limb, const std::string& effectorName,
                                const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset, const fcl::Vec3f& normal,
                                const double x, const double y, const std::size_t nbSamples,
                                const sampling::heuristic evaluate = 0, const double resolution = 0.1,
                                ContactType contactType = _6_DOF, bool disableEndEffectorCollision = false,
                                bool grasps = false, const std::string& kinematicsConstraintsPath = std::string(),
-                               const double kinematicConstraintsMinDistance = 0.);
+                               const double kinematicConstraintsMinDistance = 0., const std::size_t nbThreads = 1,
+                               const unsigned int seed = 0);
 
   static RbPrmLimbPtr_t create(const pinocchio::DevicePtr_t device, std::ifstream& fileStream,
                                const bool loadValues = true, const hpp::rbprm::sampling::heuristic evaluate = 0,
                                bool disableEndEffectorCollision = false, bool grasps = false);
 
+  /// Creates a Limb from a binary database saved with saveLimbInfoAndDatabaseBinary
+  /// \param reader reader positioned at the beginning of the database, including its header
+  static RbPrmLimbPtr_t create(const pinocchio::DevicePtr_t device, tools::io::BinaryReader& reader,
+                               const bool loadValues = true, const hpp::rbprm::sampling::heuristic evaluate = 0,
+                               bool disableEndEffectorCollision = false, bool grasps = false);
+
  public:
   ~RbPrmLimb();
 
@@ -129,11 +138,16 @@ class HPP_RBPRM_DLLAPI RbPrmLimb {
             const std::size_t nbSamples, const sampling::heuristic evaluate, const double resolution,
             ContactType contactType, bool disableEndEffectorCollision = false, bool grasps = false,
             const std::string& kinematicsConstraintsPath = std::string(),
-            const double kinematicConstraintsMinDistance = 0.);
+            const double kinematicConstraintsMinDistance = 0., const std::size_t nbThreads = 1,
+            const unsigned int seed = 0);
 
   RbPrmLimb(const pinocchio::DevicePtr_t device, std::ifstream& fileStream, const bool loadValues,
             const hpp::rbprm::sampling::heuristic evaluate, bool disableEndEffectorCollision = false,
             bool grasps = false);
+
+  RbPrmLimb(const pinocchio::DevicePtr_t device, tools::io::BinaryReader& reader, const uint64_t version,
+            const bool loadValues, const hpp::rbprm::sampling::heuristic evaluate,
+            bool disableEndEffectorCollision = false, bool grasps = false);
   ///
   /// \brief Initialization.
   ///
@@ -144,6 +158,9 @@ class HPP_RBPRM_DLLAPI RbPrmLimb {
 };  // class RbPrmLimb
 
 HPP_RBPRM_DLLAPI bool saveLimbInfoAndDatabase(const RbPrmLimbPtr_t limb, std::ofstream& dbFile);
+/// Saves the limb and its database in binary format. The file must be opened in binary mode.
+/// Such databases are memory mapped when loaded, and automatically detected by RbPrmFullBody::AddLimb
+HPP_RBPRM_DLLAPI bool saveLimbInfoAndDatabaseBinary(const RbPrmLimbPtr_t limb, std::ofstream& dbFile);
 
 }  // namespace rbprm
 }  // namespace hpp
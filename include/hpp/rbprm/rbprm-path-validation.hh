@@ -40,22 +40,86 @@ class HPP_RBPRM_DLLAPI RbPrmPathValidation : public core::pathValidation::Discre
                         core::PathValidationReportPtr_t& report, const std::vector<std::string>& filter);
 
   virtual bool validate(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
-                        core::PathValidationReportPtr_t& report) {
-    return core::pathValidation::Discretized::validate(path, reverse, validPart, report);
-  }
+                        core::PathValidationReportPtr_t& report);
+
+  /// Whether the whole path is valid. Unlike validate, the valid part of the path is not computed:
+  /// in bisection order, the validation stops at the first invalid configuration found.
+  virtual bool isValid(const core::PathPtr_t& path, core::PathValidationReportPtr_t& report);
 
   /// Add a configuration validation object
   virtual void add(const core::ConfigValidationPtr_t& configValidation);
 
   RbPrmValidationPtr_t getValidator() { return rbprmValidation_; }
 
+  /// Step between the configurations sampled with the constant step
+  core::value_type stepSize() const { return stepSize_; }
+
+  /// Validates the paths with steps computed from the distance between the trunk and the obstacles,
+  /// instead of the constant stepSize_.
+  /// No point of the trunk moving faster than velocityBound + angularVelocityBound * (radius of the trunk),
+  /// the trunk is collision free along the path until it travelled its distance to the obstacles: the collision
+  /// of the trunk is checked continuously. The ROMs and the joint bounds are still checked at the sampled
+  /// configurations only, which are at most maxStepSize apart.
+  /// In this mode, only the RbPrmValidation (and the DynamicValidation) of the path validation are used.
+  /// \param velocityBound bound on the norm of the linear velocity of the root along the paths
+  /// \param angularVelocityBound bound on the norm of the angular velocity of the root along the paths
+  /// \param maxStepSize largest step between two sampled configurations
+  /// \param tolerance the trunk is considered in collision when closer than tolerance to an obstacle
+  void setAdaptiveStep(const core::value_type velocityBound, const core::value_type angularVelocityBound,
+                       const core::value_type maxStepSize, const core::value_type tolerance);
+
+  /// Validates the paths with the constant stepSize_ (default)
+  void setConstantStep() { adaptiveStep_ = false; }
+
+  bool adaptiveStep() const { return adaptiveStep_; }
+
+  /// With the constant step, validates the configurations sampled every stepSize_ in bisection order
+  /// (both ends, then the middle of the path, then the middles of each half...) instead of the time order,
+  /// so that invalid configurations far from the start are found early.
+  /// The valid part returned by validate is still the longest valid part starting from the start of the path
+  /// (its end if reverse): the configurations before the first invalid one are all validated.
+  /// In this mode, only the RbPrmValidation (and the DynamicValidation) of the path validation are used.
+  void setBisectionOrder(bool bisectionOrder) { bisectionOrder_ = bisectionOrder; }
+
+  bool bisectionOrder() const { return bisectionOrder_; }
+
  protected:
   /// Protected constructor
   /// Users need to call RbPrmPlanner::create in order to create instances.
   RbPrmPathValidation(const core::DevicePtr_t& robot, const core::value_type& stepSize);
 
+  /// Validates the path with the adaptive step, from its end if reverse
+  bool validateAdaptive(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
+                        core::PathValidationReportPtr_t& report, const std::vector<std::string>& filter);
+
+  /// Validates the path with the constant step, in bisection order
+  /// \param validPart if not null, set to the longest valid part of path from its start (its end if reverse).
+  /// If null, the validation stops at the first invalid configuration found.
+  bool validateBisection(const core::PathPtr_t& path, bool reverse, core::PathPtr_t* validPart,
+                         core::PathValidationReportPtr_t& report, const std::vector<std::string>& filter);
+
+  /// Called before the validation of a path in the modes implemented by this class
+  virtual void startValidation(const core::PathPtr_t& /*path*/, bool /*reverse*/) {}
+
+  /// Validates a configuration sampled by validateBisection
+  virtual bool validateConfiguration(const core::Configuration_t& q, core::ValidationReportPtr_t& report,
+                                     const std::vector<std::string>& filter);
+
+  /// Validates a configuration sampled by validateAdaptive
+  /// \retval step time during which the trunk can not collide, starting from this configuration
+  virtual bool validateConfiguration(const core::Configuration_t& q, core::ValidationReportPtr_t& report,
+                                     const std::vector<std::string>& filter, core::value_type& step);
+
   RbPrmValidationPtr_t rbprmValidation_;
 
+ private:
+  bool adaptiveStep_;
+  bool bisectionOrder_;
+  core::value_type velocityBound_;
+  core::value_type angularVelocityBound_;
+  core::value_type maxStepSize_;
+  core::value_type tolerance_;
+
 };  // class RbPrmPlanner
 }  // namespace rbprm
 }  // namespace hpp
@@ -21,6 +21,7 @@
 
 #include <hpp/core/collision-validation.hh>
 #include <hpp/rbprm/rbprm-device.hh>
+#include <hpp/rbprm/obstacle-broad-phase.hh>
 #include <hpp/rbprm/config.hh>
 
 namespace hpp {
@@ -66,12 +67,19 @@ class HPP_RBPRM_DLLAPI RbPrmRomValidation : public core::CollisionValidation {
 
   void setOptional(bool optional) { optional_ = optional; }
 
+  /// Sets the broadphase used to skip the collision pairs whose obstacle is far from the ROM,
+  /// no broadphase is used if null
+  void broadPhase(const ObstacleBroadPhasePtr_t& broadPhase) { broadPhase_ = broadPhase; }
+
+  const ObstacleBroadPhasePtr_t& broadPhase() const { return broadPhase_; }
+
  protected:
   RbPrmRomValidation(const pinocchio::DevicePtr_t& robot, const std::vector<std::string>& affFilters);
 
  private:
   core::ValidationReportPtr_t unusedReport_;
   bool optional_;
+  ObstacleBroadPhasePtr_t broadPhase_;
 
 };  // class RbPrmValidation
 /// \}
@@ -86,6 +86,30 @@ class HPP_RBPRM_DLLAPI RbPrmValidation : public core::CollisionValidation {
   virtual bool validate(const core::Configuration_t& config, core::ValidationReportPtr_t& validationReport,
                         const std::vector<std::string>& filter);
 
+  /// Compute whether the configuration is valid, the collision test of the trunk being replaced by
+  /// the computation of its distance to the obstacles
+  ///
+  /// \param config the config to check for validity,
+  /// \retval validationReport report on validation, can be cast to RbprmValidationReport,
+  /// \param filter specify constraints on all roms required to be in contact
+  /// \param tolerance the trunk is considered in collision if its distance to the obstacles is below tolerance
+  /// \retval trunkDistance distance between the trunk and the obstacles
+  /// \retval trunkRadius radius of a sphere centered on the root (the first 3 values of config) containing the trunk
+  /// \return whether the whole config is valid.
+  bool validate(const core::Configuration_t& config, core::ValidationReportPtr_t& validationReport,
+                const std::vector<std::string>& filter, const core::value_type tolerance,
+                core::value_type& trunkDistance, core::value_type& trunkRadius);
+
+  /// Compute the distance between the trunk and the obstacles
+  ///
+  /// \param config the configuration of the robot,
+  /// \retval trunkRadius radius of a sphere centered on the root (the first 3 values of config) containing the trunk
+  /// \param closestPair if not null, its objects are set to the closest pair of objects
+  /// \return the distance between the trunk and the obstacles, infinite without obstacles
+  core::value_type trunkDistance(
+      const core::Configuration_t& config, core::value_type& trunkRadius,
+      const core::CollisionValidationReportPtr_t& closestPair = core::CollisionValidationReportPtr_t());
+
   /// Add an obstacle to validation
   /// \param object obstacle added
   /// Store obstacle and build a collision pair with each body of the robot.
@@ -111,6 +135,15 @@ class HPP_RBPRM_DLLAPI RbPrmValidation : public core::CollisionValidation {
   ///
   void computeAllContacts(bool computeAllContacts);
 
+  /// \brief set whether the trunk and the ROM validations test the collision pairs of the
+  /// obstacles near each body only, using a broadphase built on the obstacles of all the validations.
+  /// The obstacles must not move while the broadphase is used.
+  /// The broadphase is rebuilt by addObstacle, the obstacles added to the validations directly
+  /// are always tested until it is enabled again.
+  void useBroadPhase(bool useBroadPhase);
+
+  const ObstacleBroadPhasePtr_t& broadPhase() const { return broadPhase_; }
+
  private:
   /// Compute whether the configuration is valid for the root (collision and joint-bound)
   ///
@@ -160,6 +193,7 @@ class HPP_RBPRM_DLLAPI RbPrmValidation : public core::CollisionValidation {
 
  private:
   core::ValidationReportPtr_t unusedReport_;
+  ObstacleBroadPhasePtr_t broadPhase_;
 
 };  // class RbPrmValidation
 /// \}
@@ -29,6 +29,7 @@ namespace rbprm {
 namespace sampling {
 
 struct HeuristicParam;
+class SampleDB;
 
 /// Defines a heuristic method to sort samples
 /// the higher the score, the better the sample
@@ -39,6 +40,19 @@ struct HeuristicParam;
 typedef double (*heuristic)(const sampling::Sample& sample, const Eigen::Vector3d& direction,
                             const Eigen::Vector3d& normal, const HeuristicParam& params);
 
+/// Batch version of a heuristic, scoring a contiguous range of samples of a SampleDB
+/// at once from the column storage of the database. It must give the same scores as the
+/// heuristic it is registered with, up to rounding, and call rand () in the same order.
+/// \param database database containing the samples
+/// \param first index of the first sample to score
+/// \param nbSamples number of samples to score
+/// \param direction overall direction of motion
+/// \param normal contact surface normal relatively to the candidates
+/// \param values output array of nbSamples values, values[i] being the score of sample first + i
+typedef void (*batchHeuristic)(const SampleDB& database, const std::size_t first, const std::size_t nbSamples,
+                               const Eigen::Vector3d& direction, const Eigen::Vector3d& normal,
+                               const HeuristicParam& params, double* values);
+
 /// Defines a set of existing heuristics for biasing the sample candidate selection
 ///
 /// This class defines two heuristics by default. "EFORT" and "manipulability".
@@ -47,7 +61,13 @@ struct HPP_RBPRM_DLLAPI HeuristicFactory {
   ~HeuristicFactory();
 
   bool AddHeuristic(const std::string& name, const heuristic func);
+  /// Registers the batch version of the heuristic with the given name
+  /// \return false if no heuristic has this name, or if it already has a batch version
+  bool AddBatchHeuristic(const std::string& name, const batchHeuristic func);
+  /// \return the batch version of a registered heuristic, 0 if there is none
+  batchHeuristic GetBatchHeuristic(const heuristic func) const;
   std::map<std::string, const heuristic> heuristics_;
+  std::map<std::string, const batchHeuristic> batchHeuristics_;
 };
 
 }  // namespace sampling
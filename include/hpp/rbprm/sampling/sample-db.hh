@@ -26,8 +26,15 @@
 #include <boost/function.hpp>
 #include <vector>
 #include <map>
+#include <stdint.h>
 
 namespace hpp {
+namespace tools {
+namespace io {
+class BinaryReader;
+class BinaryWriter;
+}  // namespace io
+}  // namespace tools
 
 namespace rbprm {
 namespace sampling {
@@ -56,6 +63,40 @@ struct sample_compare {
 
 typedef std::multiset<OctreeReport, sample_compare> T_OctreeReport;
 
+/// Contact candidates, extracted one at a time by decreasing heuristic value.
+/// Candidates are only stored while they are collected, and heap ordered when the first one is requested,
+/// so that the cost of sorting is only paid for the candidates actually extracted.
+/// Candidates with the same value are extracted in insertion order, as with T_OctreeReport.
+class HPP_RBPRM_DLLAPI CandidateQueue {
+ public:
+  /// \param maxCandidates if not 0, only the maxCandidates best candidates are kept
+  explicit CandidateQueue(const std::size_t maxCandidates = 0);
+
+  void push(const OctreeReport& report);
+  /// \return the remaining candidate with the highest heuristic value
+  const OctreeReport& top() const;
+  /// Removes the candidate returned by top
+  void pop();
+  bool empty() const { return entries_.empty(); }
+  std::size_t size() const { return entries_.size(); }
+  std::size_t maxCandidates() const { return maxCandidates_; }
+
+ private:
+  struct Entry {
+    Entry(const OctreeReport& report, const std::size_t order) : report_(report), order_(order) {}
+    OctreeReport report_;
+    std::size_t order_;
+  };
+  static bool better(const Entry& lhs, const Entry& rhs);
+  static bool worse(const Entry& lhs, const Entry& rhs);
+  void prepare() const;
+
+  std::size_t maxCandidates_;
+  std::size_t pushed_;
+  mutable std::vector<Entry> entries_;
+  mutable bool extracting_;
+};
+
 HPP_PREDEF_CLASS(SampleDB);
 
 typedef std::vector<double> T_Double;
@@ -81,17 +122,40 @@ typedef std::map<std::string, ValueBound> T_ValueBound;
 class HPP_RBPRM_DLLAPI SampleDB {
  public:
   SampleDB(std::ifstream& databaseStream, bool loadValues = true);
+  /// Loads a database saved with saveLimbDatabaseBinary.
+  /// \param reader reader positioned at the beginning of the database section
+  /// \param version version of the binary format, as read from the file header
+  /// \param loadValues whether the value columns should be loaded
+  SampleDB(tools::io::BinaryReader& reader, const uint64_t version, bool loadValues = true);
+  /// Generates a database for a limb.
+  /// \param nbThreads if greater than 1, samples are generated and evaluated in parallel
+  /// (see GenerateSamples). The evaluation functions in data must then be thread safe.
+  /// \param seed seed of the random generators used for parallel generation
   SampleDB(const pinocchio::JointPtr_t limb, const std::string& effector, const std::size_t nbSamples,
            const fcl::Vec3f& offset = fcl::Vec3f(0, 0, 0), const fcl::Vec3f& limbOffset = fcl::Vec3f(0, 0, 0),
-           const double resolution = 0.1, const T_evaluate& data = T_evaluate(), const std::string& staticValue = "");
+           const double resolution = 0.1, const T_evaluate& data = T_evaluate(), const std::string& staticValue = "",
+           const std::size_t nbThreads = 1, const unsigned int seed = 0);
   ~SampleDB();
-  /*
-      private:
-           SampleDB(const SampleDB&);
-           const SampleDB& operator=(const SampleDB&);
-  */
+
+ private:
+  // samples_ are views on the columns of the database, which can thus not be copied
+  SampleDB(const SampleDB&);
+  const SampleDB& operator=(const SampleDB&);
+
  public:
   double resolution_;
+  /// Data of the samples, stored column-wise and indexed by sample id, so that
+  /// requests scanning many samples read contiguous memory.
+  Eigen::Matrix<double, 3, Eigen::Dynamic> effectorPositions_;
+  Eigen::Matrix<double, 3, Eigen::Dynamic> effectorPositionsInLimbFrame_;
+  /// jacobian products, each column is a 6x6 matrix stored in column major order
+  Eigen::Matrix<double, 36, Eigen::Dynamic> jacobianProducts_;
+  Eigen::VectorXd staticValues_;
+  /// limb configurations, one column per sample
+  Eigen::MatrixXd configurations_;
+  /// jacobians, each column is a 6 x n matrix stored in column major order
+  Eigen::MatrixXd jacobians_;
+  /// Views on the columns above, sample i being samples_[i]
   T_Sample samples_;
   boost::shared_ptr<const octomap::OcTree> octomapTree_;
   fcl::OcTree* octree_;  // deleted with geometry_
@@ -106,9 +170,16 @@ class HPP_RBPRM_DLLAPI SampleDB {
 
 };  // class SampleDB
 
+/// Evaluates a value for all the samples of the database, and stores its normalized result.
+/// \param nbThreads number of threads used for the evaluation. If greater than 1, eval must be thread safe.
 HPP_RBPRM_DLLAPI SampleDB& addValue(SampleDB& database, const std::string& valueName, const evaluate eval,
-                                    bool isStaticValue = true, bool sortSamples = true);
+                                    bool isStaticValue = true, bool sortSamples = true,
+                                    const std::size_t nbThreads = 1);
 HPP_RBPRM_DLLAPI bool saveLimbDatabase(const SampleDB& database, std::ofstream& dbFile);
+/// Writes the database using the binary format. Each sample is stored as a fixed
+/// size record, followed by the value columns, the serialized octree and the voxel index,
+/// so that loading the database does not require to rebuild the octree nor to sort the samples.
+HPP_RBPRM_DLLAPI bool saveLimbDatabaseBinary(const SampleDB& database, tools::io::BinaryWriter& writer);
 
 /// Given the current position of a robot, returns a set
 /// of candidate sample configurations for contact generation.
@@ -143,6 +214,22 @@ HPP_RBPRM_DLLAPI bool GetCandidates(const SampleDB& sc, const fcl::Transform3f&
                                     T_OctreeReport& report, const HeuristicParam& params,
                                     const heuristic evaluate = 0);
 
+/// Given the current position of a robot, adds to a CandidateQueue the
+/// candidate sample configurations for contact generation.
+///
+/// \param sc the SampleDB containing all the samples for a given limb
+/// \param treeTrf the current transformation of the root of the robot
+/// \param direction the current direction of motion, used to evaluate the sample
+/// heuristically
+/// \param candidates queue updated as the samples are explored
+/// \param evaluate heuristic used to sort candidates
+/// \param evaluateBatch if not 0, batch version of evaluate, used to score all the samples of a voxel at once
+/// \return true if at least one candidate was found
+HPP_RBPRM_DLLAPI bool GetCandidates(const SampleDB& sc, const fcl::Transform3f& treeTrf,
+                                    const hpp::pinocchio::CollisionObjectPtr_t& o2, const fcl::Vec3f& direction,
+                                    CandidateQueue& candidates, const HeuristicParam& params,
+                                    const heuristic evaluate = 0, const batchHeuristic evaluateBatch = 0);
+
 }  // namespace sampling
 }  // namespace rbprm
 }  // namespace hpp
@@ -25,6 +25,7 @@
 #include <hpp/pinocchio/device.hh>
 
 #include <deque>
+#include <vector>
 namespace hpp {
 
 namespace rbprm {
@@ -34,6 +35,12 @@ HPP_PREDEF_CLASS(Sample);
 /// Sample configuration for a robot limb, stored
 /// in an octree and used for proximity requests for contact creation.
 /// assumes that joints are compact, ie they all are consecutive in configuration.
+/// A Sample is a view on its data: samples stored in a SampleDB point to the columns
+/// of the database, while samples created with the constructors below own their data.
+/// A view, and any copy of it, must not be used once the database is destroyed, or once its
+/// columns are reallocated (when the database is sorted or loaded). Copy the sample with the
+/// owning constructor to keep it longer.
+/// Samples can be copied but not assigned: the views of a sample are bound once, at construction.
 class Sample;
 typedef std::shared_ptr<Sample> SamplePtr_t;
 
@@ -43,6 +50,11 @@ class HPP_RBPRM_DLLAPI Sample {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   /// \endcond
 
+  typedef Eigen::Map<const pinocchio::Configuration_t> ConfigurationView_t;
+  typedef Eigen::Map<const fcl::Vec3f> PositionView_t;
+  typedef Eigen::Map<const Eigen::MatrixXd> JacobianView_t;
+  typedef Eigen::Map<const Eigen::Matrix<pinocchio::value_type, 6, 6> > JacobianProductView_t;
+
   /// Creates a sample configuration, given the current configuration of a limb.
   /// the current Configuration_t of the limb will be used to compute the sample.
   /// \param limb root of the considered limb
@@ -58,6 +70,14 @@ class HPP_RBPRM_DLLAPI Sample {
          const pinocchio::ConfigurationIn_t configuration, const Eigen::MatrixXd& jacobian,
          const Eigen::Matrix<pinocchio::value_type, 6, 6>& jacobianProduct);
 
+  /// Creates a view on sample data stored elsewhere, typically in the columns of a SampleDB.
+  /// The data is not copied and must outlive the sample.
+  /// \param jacobian 6 x jacobianCols matrix stored in column major order
+  /// \param jacobianProduct 6 x 6 matrix stored in column major order
+  Sample(const std::size_t id, const std::size_t length, const std::size_t startRank, const double staticValue,
+         const double* effectorPosition, const double* effectorPositionInLimbFrame, const double* configuration,
+         const double* jacobian, const std::size_t jacobianCols, const double* jacobianProduct);
+
   /// Creates sample configuration for a limb, extracted from a complete robot configuration, passed as a parameter
   /// \param limb root of the considered limb
   /// \param the configuration from which the limb sample will be extracted
@@ -67,19 +87,29 @@ class HPP_RBPRM_DLLAPI Sample {
   Sample(const pinocchio::JointPtr_t limb, const pinocchio::Frame effector, pinocchio::ConfigurationIn_t configuration,
          const fcl::Vec3f& offset = fcl::Vec3f(0, 0, 0), const fcl::Vec3f& limbOffset = fcl::Vec3f(0, 0, 0),
          const std::size_t id = 0);
+  /// Creates a view on the data of clone, sharing its data if clone owns it. No data is copied.
   Sample(const Sample& clone);
   ~Sample() {}
 
+ private:
+  Sample& operator=(const Sample&);
+
+  Sample(const std::size_t id, const std::size_t length, const std::size_t startRank, const double staticValue,
+         const std::size_t jacobianCols, const std::shared_ptr<const std::vector<double> >& storage);
+
+  /// data of the samples which are not stored in a SampleDB, null otherwise
+  std::shared_ptr<const std::vector<double> > storage_;
+
  public:
   std::size_t startRank_;
   std::size_t length_;
-  pinocchio::Configuration_t configuration_;
+  ConfigurationView_t configuration_;
   /// Position relative to robot root (ie, robot base at 0 everywhere)
-  fcl::Vec3f effectorPosition_;
-  fcl::Vec3f effectorPositionInLimbFrame_;
-  Eigen::MatrixXd jacobian_;
+  PositionView_t effectorPosition_;
+  PositionView_t effectorPositionInLimbFrame_;
+  JacobianView_t jacobian_;
   /// Product of the jacobian by its transpose
-  Eigen::Matrix<pinocchio::value_type, 6, 6> jacobianProduct_;
+  JacobianProductView_t jacobianProduct_;
   /// id in sample container
   std::size_t id_;
   double staticValue_;
@@ -102,6 +132,23 @@ SampleVector_t GenerateSamples(const pinocchio::JointPtr_t limb, const std::stri
                                const std::size_t nbSamples, const fcl::Vec3f& offset = fcl::Vec3f(0, 0, 0),
                                const fcl::Vec3f& limbOffset = fcl::Vec3f(0, 0, 0));
 
+/// Generates the samples in parallel. Each thread owns a clone of the robot and a random generator
+/// seeded with seed + thread index, and generates a contiguous range of samples. For a given seed
+/// and number of threads the result is thus always the same.
+/// The configurations are sampled with the same distribution as in the serial version (see
+/// core::configurationShooter::Uniform), so the database does not depend on the number of threads.
+/// \param limb root of the considered limb
+/// \param effector tag identifying the end effector of the limb
+/// \param nbSamples number of samples to be generated
+/// \param offset location of the contact point of the effector relatively to the effector joint origin
+/// \param limbOffset offset betwwen the limb joint position and it's link
+/// \param nbThreads number of threads used for the generation
+/// \param seed seed of the random generators
+/// \return a deque of sample configurations respecting joint limits.
+SampleVector_t GenerateSamples(const pinocchio::JointPtr_t limb, const std::string& effector,
+                               const std::size_t nbSamples, const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset,
+                               const std::size_t nbThreads, const unsigned int seed);
+
 /// Assigns the limb configuration associated with a sample to a robot configuration
 /// \param sample The limb configuration to load
 /// \param robot the configuration to be modified
@@ -22,6 +22,7 @@
 #include <hpp/pinocchio/device.hh>
 #include <hpp/rbprm/rbprm-state.hh>
 #include <hpp/rbprm/rbprm-fullbody.hh>
+#include <hpp/rbprm/kinematic-context.hh>
 #include <hpp/centroidal-dynamics/centroidal_dynamics.hh>
 
 #include <map>
@@ -55,14 +56,36 @@ double IsStable(const RbPrmFullBodyPtr_t fullbody, State& state, fcl::Vec3f acc
 std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const RbPrmFullBodyPtr_t fullbody, State& state,
                                                    const core::value_type friction = 0.5);
 
+/// Same as IsStable, but the kinematics of the state are evaluated on the device of context,
+/// so that several threads can test the equilibrium of states of the same full body.
+double IsStable(const KinematicContextPtr_t& context, State& state, fcl::Vec3f acc = fcl::Vec3f(0, 0, 0),
+                fcl::Vec3f com = fcl::Vec3f(0, 0, 0),
+                const centroidal_dynamics::EquilibriumAlgorithm = centroidal_dynamics::EQUILIBRIUM_ALGORITHM_DLP);
+
+/// Same as ComputeCentroidalCone, but the kinematics of the state are evaluated on the device of context
+std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const KinematicContextPtr_t& context, State& state,
+                                                   const core::value_type friction = 0.5);
+
 centroidal_dynamics::Equilibrium initLibrary(const RbPrmFullBodyPtr_t fullbody);
 
+/// Returns the solver used by IsStable and ComputeCentroidalCone for fullbody.
+/// Solvers are created once per thread and per robot mass, number of generators and LP solver,
+/// their contacts being reset with setNewContacts (see setupLibrary). The LP of the solver is warm started
+/// from the previous query, which pays off when the contact set only changed by one effector.
+centroidal_dynamics::Equilibrium& cachedLibrary(const RbPrmFullBodyPtr_t fullbody);
+
 centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, State& state,
                                           centroidal_dynamics::Equilibrium& sEq,
                                           centroidal_dynamics::EquilibriumAlgorithm& alg,
                                           core::value_type friction = 0.6, const double feetX = 0,
                                           const double feetY = 0) throw(std::runtime_error);
 
+centroidal_dynamics::Vector3 setupLibrary(const KinematicContextPtr_t& context, State& state,
+                                          centroidal_dynamics::Equilibrium& sEq,
+                                          centroidal_dynamics::EquilibriumAlgorithm& alg,
+                                          core::value_type friction = 0.6, const double feetX = 0,
+                                          const double feetY = 0) throw(std::runtime_error);
+
 }  // namespace stability
 }  // namespace rbprm
 }  // namespace hpp
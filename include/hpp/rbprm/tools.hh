@@ -20,8 +20,12 @@
 #define HPP_RBPRM_TOOLS_HH
 
 #include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
 
 #include <hpp/core/config-validation.hh>
+#include <hpp/constraints/fwd.hh>
 #include <hpp/pinocchio/joint.hh>
 #include <hpp/rbprm/config.hh>
 #include <hpp/pinocchio/collision-object.hh>
@@ -59,7 +63,11 @@ void RemoveEffectorCollisionRec(T& validation, pinocchio::JointPtr_t joint,
 /// \param spared Name of the root of the unlocked kinematic chain
 /// \param joint Root of the considered kinematic chain to block
 /// \param projector Projector on which to block the joints
-void LockJointRec(const std::string& spared, const pinocchio::JointPtr_t joint, core::ConfigProjectorPtr_t projector);
+/// \param lockedJoints if not null, the locked joints are appended to it
+/// \param comparison comparison type of the locked joints, Equality to update their values as right hand sides
+void LockJointRec(const std::string& spared, const pinocchio::JointPtr_t joint, core::ConfigProjectorPtr_t projector,
+                  std::vector<constraints::ImplicitPtr_t>* lockedJoints = 0,
+                  const constraints::ComparisonType comparison = constraints::EqualToZero);
 
 /// Lock all joints in a kinematic chain, except for a list of subchains
 /// \param spared names of the root of the unlocked kinematic chains
@@ -90,6 +98,83 @@ fcl::Vec3f readVecFCL(std::ifstream& myfile);
 Eigen::MatrixXd readMatrix(std::ifstream& myfile, std::string& line);
 fcl::Matrix3f readRotMatrixFCL(std::ifstream& myfile, std::string& line);
 fcl::Vec3f readVecFCL(std::ifstream& myfile, std::string& line);
+
+/// Magic number opening every binary limb database
+extern const char BinaryMagic[8];
+/// Current version of the binary limb database format.
+/// Version 2 adds the voxel index and the octree boxes.
+const uint64_t BinaryVersion = 2;
+/// Byte order marker, used to reject databases written on a machine of different endianness
+const uint64_t BinaryByteOrder = 0x0102030405060708ULL;
+
+/// Checks whether a file starts with the binary database magic number
+/// \param path path to the file to check
+/// \return true if the file is a binary limb database
+bool isBinaryDatabase(const std::string& path);
+
+/// Read only memory mapping of a file. The mapping is released on destruction.
+class HPP_RBPRM_DLLAPI MappedFile {
+ public:
+  MappedFile(const std::string& path);
+  ~MappedFile();
+  const char* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+ private:
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+  const char* data_;
+  std::size_t size_;
+};
+
+/// Sequential writer for the binary database format.
+/// Every field is padded to 8 bytes so that arrays of double can
+/// be accessed in place once the file is mapped.
+class HPP_RBPRM_DLLAPI BinaryWriter {
+ public:
+  BinaryWriter(std::ostream& output) : output_(output) {}
+  void writeU64(const uint64_t value);
+  void writeDouble(const double value);
+  void writeDoubles(const double* values, const std::size_t size);
+  void writeString(const std::string& value);
+  void writeBlob(const std::string& blob);
+  void writeVecFCL(const fcl::Vec3f& vec);
+  void writeRotMatrixFCL(const fcl::Matrix3f& mat);
+  bool good() const { return output_.good(); }
+
+ private:
+  void pad(const std::size_t size);
+  std::ostream& output_;
+};
+
+/// Sequential reader over a binary database mapped in memory.
+/// No copy is performed for arrays, which point directly into the buffer.
+/// Throws std::runtime_error if the buffer is too short.
+class HPP_RBPRM_DLLAPI BinaryReader {
+ public:
+  BinaryReader(const char* data, const std::size_t size) : current_(data), end_(data + size) {}
+  uint64_t readU64();
+  double readDouble();
+  const double* readDoubles(const std::size_t size);
+  std::string readString();
+  /// \return pointer to the blob data, of size blobSize
+  const char* readBlob(std::size_t& blobSize);
+  fcl::Vec3f readVecFCL();
+  fcl::Matrix3f readRotMatrixFCL();
+
+ private:
+  const char* advance(const std::size_t size);
+  const char* current_;
+  const char* end_;
+};
+
+/// Writes the magic number, byte order marker and current version of the binary format
+void writeBinaryHeader(BinaryWriter& writer);
+
+/// Reads and checks the header of a binary database.
+/// Throws std::runtime_error if the header is invalid or if the version is not supported
+/// \return the version of the format used in the database
+uint64_t readBinaryHeader(BinaryReader& reader);
 }  // namespace io
 
 template <typename T>
@@ -45,6 +45,9 @@ typedef boost::shared_ptr<const BVHModelOB> BVHModelOBConst_Ptr_t;
 BVHModelOBConst_Ptr_t GetModel(const hpp::pinocchio::CollisionObjectConstPtr_t object,
                                hpp::pinocchio::DeviceData& deviceData);
 
+/// \return the model of object in its local frame, without copy
+BVHModelOBConst_Ptr_t GetLocalModel(const hpp::pinocchio::CollisionObjectConstPtr_t object);
+
 void projectZ(IT_Point pointsBegin, IT_Point pointsEnd);
 
 /// Implementation of the gift wrapping algorithm to determine the 2D projection of the convex hull of a set of points
@@ -246,6 +249,17 @@ T_Point intersectSegmentPlane(Point s0, Point s1, Eigen::Vector3d pn, Point p0);
  */
 T_Point intersectPolygonePlane(BVHModelOBConst_Ptr_t polygone, BVHModelOBConst_Ptr_t plane, Eigen::Ref<Point> Pn);
 
+/**
+ * @brief intersectPolygonePlane compute the intersection between a polygone and an (infinite) plane
+ * @param polygone model of the polygone in its local frame
+ * @param transform placement of the polygone
+ * @param Pn the normal of the plan
+ * @param P0 a point in the plan
+ * @return an ordoned list of point (clockwise), which belong to both the polygone and the plane
+ */
+T_Point intersectPolygonePlane(BVHModelOBConst_Ptr_t polygone, const hpp::fcl::Transform3f& transform, CPointRef Pn,
+                               CPointRef P0);
+
 T_Point convertBVH(BVHModelOBConst_Ptr_t obj);
 
 /**
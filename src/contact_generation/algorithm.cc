@@ -128,9 +128,8 @@ ContactComputationStatus ComputeStableContact(
   contactGenHelper.testReachability_ = false;  // because this method is only called without previous states
   sampling::HeuristicParam params;
   params.contactPositions_ = current.contactPositions_;
-  contactGenHelper.fullBody_->device_->currentConfiguration(contactGenHelper.workingState_.configuration_);
-  contactGenHelper.fullBody_->device_->computeForwardKinematics();
-  params.comPosition_ = contactGenHelper.fullBody_->device_->positionCenterOfMass();
+  contactGenHelper.context_->setConfiguration(contactGenHelper.workingState_.configuration_);
+  params.comPosition_ = contactGenHelper.context_->positionCenterOfMass();
   size_type cfgSize(contactGenHelper.workingState_.configuration_.rows());
   params.comSpeed_ = fcl::Vec3f(contactGenHelper.workingState_.configuration_[cfgSize - 6],
                                 contactGenHelper.workingState_.configuration_[cfgSize - 5],
@@ -198,7 +197,8 @@ hpp::rbprm::contact::ContactReport ComputeContacts(
     pinocchio::ConfigurationIn_t configuration, const affMap_t& affordances,
     const std::map<std::string, std::vector<std::string> >& affFilters, const fcl::Vec3f& direction,
     const double robustnessTreshold, const fcl::Vec3f& acceleration, const core::PathConstPtr_t& comPath,
-    const double currentPathId, const bool testReachability, const bool quasiStatic) {
+    const double currentPathId, const bool testReachability, const bool quasiStatic,
+    const projection::ProjectionReport* maintainedContacts) {
   // save old configuration
   core::ConfigurationIn_t save = body->device_->currentConfiguration();
   pinocchio::Computation_t flag = body->device_->computationFlag();
@@ -216,6 +216,7 @@ hpp::rbprm::contact::ContactReport ComputeContacts(
                                     false, true, direction, acceleration, false, false, comPath, currentPathId);
   cHelper.testReachability_ = testReachability;
   cHelper.quasiStatic_ = quasiStatic;
+  cHelper.maintainedContacts_ = maintainedContacts;
   contact::ContactReport rep = contact::oneStep(cHelper);
 
   // copy extra dofs
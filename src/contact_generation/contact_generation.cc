@@ -27,6 +27,8 @@
 #include "hpp/rbprm/rbprm-profiler.hh"
 #endif
 #include <hpp/util/timer.hh>
+#include <algorithm>
+#include <exception>
 
 namespace hpp {
 namespace rbprm {
@@ -62,7 +64,10 @@ ContactGenHelper::ContactGenHelper(RbPrmFullBodyPtr_t fb, const State& ps, pinoc
       maximiseContacts_(true),
       accept_unreachable_(false),
       tryQuasiStatic_(fb->staticStability()),
-      reachabilityPointPerPhases_(0) {
+      reachabilityPointPerPhases_(0),
+      maxCandidates_(fb->maxContactCandidates()),
+      context_(KinematicContext::shared(fb)),
+      maintainedContacts_(0) {
   workingState_.configuration_ = configuration;
   workingState_.stable = false;
 }
@@ -144,11 +149,11 @@ Q_State maintain_contacts_combinatorial(const hpp::rbprm::State& currentState, c
 
 using namespace projection;
 
-bool maintain_contacts_stability_rec(hpp::rbprm::RbPrmFullBodyPtr_t fullBody,
+bool maintain_contacts_stability_rec(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const KinematicContextPtr_t& context,
                                      pinocchio::ConfigurationIn_t targetRootConfiguration, Q_State& candidates,
                                      const std::size_t contactLength, const fcl::Vec3f& acceleration,
                                      const double robustness, ProjectionReport& currentRep) {
-  if (stability::IsStable(fullBody, currentRep.result_, acceleration) > robustness) {
+  if (stability::IsStable(context, currentRep.result_, acceleration) > robustness) {
     currentRep.result_.stable = true;
     return true;
   }
@@ -160,7 +165,7 @@ bool maintain_contacts_stability_rec(hpp::rbprm::RbPrmFullBodyPtr_t fullBody,
     if (cState.contactOrder_.size() < contactLength) return false;
     ProjectionReport rep = projectToRootConfiguration(fullBody, targetRootConfiguration, cState);
     Q_State copy_candidates = candidates;
-    if (maintain_contacts_stability_rec(fullBody, targetRootConfiguration, copy_candidates, contactLength,
+    if (maintain_contacts_stability_rec(fullBody, context, targetRootConfiguration, copy_candidates, contactLength,
                                         acceleration, robustness, rep)) {
       currentRep = rep;
       candidates = copy_candidates;
@@ -212,9 +217,10 @@ std::vector<pinocchio::CollisionObjectPtr_t> getAffObjectsForLimb(
 ProjectionReport maintain_contacts_stability(ContactGenHelper& contactGenHelper, ProjectionReport& currentRep) {
   const std::size_t contactLength(currentRep.result_.contactOrder_.size());
   // contactGenHelper.candidates_.pop(); // TODO REMOVE (TEST)
-  maintain_contacts_stability_rec(contactGenHelper.fullBody_, contactGenHelper.workingState_.configuration_,
-                                  contactGenHelper.candidates_, contactLength, contactGenHelper.acceleration_,
-                                  contactGenHelper.robustnessTreshold_, currentRep);
+  maintain_contacts_stability_rec(contactGenHelper.fullBody_, contactGenHelper.context_,
+                                  contactGenHelper.workingState_.configuration_, contactGenHelper.candidates_,
+                                  contactLength, contactGenHelper.acceleration_, contactGenHelper.robustnessTreshold_,
+                                  currentRep);
   hppDout(notice, "check stability maintain contact : " << currentRep.result_.stable);
   return currentRep;
 }
@@ -246,34 +252,49 @@ std::vector<std::string> sortLimbs(const State& currentState, const std::vector<
   return res2;
 }
 
-ProjectionReport genColFree(ContactGenHelper& contactGenHelper, ProjectionReport& currentRep) {
+ProjectionReport genColFree(const RbPrmFullBodyPtr_t& fullBody, const State& workingState,
+                            const ProjectionReport& currentRep) {
   ProjectionReport res = currentRep;
   // identify broken limbs and find collision free configurations for each one of them.
-  std::vector<std::string> effNames(extractEffectorsName(contactGenHelper.fullBody_->GetLimbs()));
+  std::vector<std::string> effNames(extractEffectorsName(fullBody->GetLimbs()));
   std::vector<std::string> freeLimbs = rbprm::freeEffectors(currentRep.result_, effNames.begin(), effNames.end());
-  freeLimbs = sortLimbs(contactGenHelper.workingState_, freeLimbs);
+  freeLimbs = sortLimbs(workingState, freeLimbs);
   for (std::vector<std::string>::const_iterator cit = freeLimbs.begin(); cit != freeLimbs.end() && res.success_;
        ++cit) {
-    res = projection::setCollisionFree(contactGenHelper.fullBody_,
-                                       contactGenHelper.fullBody_->GetLimbCollisionValidation().at(*cit), *cit,
-                                       res.result_);
+    res = projection::setCollisionFree(fullBody, fullBody->GetLimbCollisionValidation().at(*cit), *cit, res.result_);
     hppDout(notice, "free limb in maintain contact : " << *cit);
   }
   // gen collision free configuration for the limbs not used for contact in last :
-  hppDout(notice, "size of val map = " << contactGenHelper.fullBody_->GetLimbCollisionValidation().size());
-  std::vector<std::string> effNotContactingNames(
-      extractEffectorsName(contactGenHelper.fullBody_->GetNonContactingLimbs()));
+  hppDout(notice, "size of val map = " << fullBody->GetLimbCollisionValidation().size());
+  std::vector<std::string> effNotContactingNames(extractEffectorsName(fullBody->GetNonContactingLimbs()));
   for (std::vector<std::string>::const_iterator cit = effNotContactingNames.begin();
        cit != effNotContactingNames.end() && res.success_; ++cit) {
     hppDout(notice, "for limb name = " << *cit);
-    res = projection::setCollisionFree(contactGenHelper.fullBody_,
-                                       contactGenHelper.fullBody_->GetLimbCollisionValidation().at(*cit), *cit,
-                                       res.result_);
+    res = projection::setCollisionFree(fullBody, fullBody->GetLimbCollisionValidation().at(*cit), *cit, res.result_);
     hppDout(notice, "free limb not used for contact in maintain contact : " << *cit);
   }
   return res;
 }
 
+// Projects candidate to the root configuration of workingState, then finds collision free configurations
+// for its free limbs and validates the result against the collision validation of the full body.
+ProjectionReport projectCollisionFree(const KinematicContextPtr_t& context, const State& workingState,
+                                      const State& candidate) {
+  const RbPrmFullBodyPtr_t& fullBody = context->fullBody();
+  ProjectionReport rep = projectToRootConfiguration(context, workingState.configuration_, candidate);
+  hppDout(notice, "maintain contacts, projection success : " << rep.success_);
+  if (rep.success_) rep = genColFree(fullBody, workingState, rep);
+  if (rep.success_) {
+    hpp::core::ValidationReportPtr_t valRep(new hpp::core::CollisionValidationReport);
+    rep.success_ = fullBody->GetCollisionValidation()->validate(rep.result_.configuration_, valRep);
+    hppDout(notice, "maintain contact collision for config : r(["
+                        << pinocchio::displayConfig(rep.result_.configuration_) << "])");
+    hppDout(notice, "valide  : " << rep.success_);
+    if (!rep.success_) hppDout(notice, "report = " << *valRep);
+  }
+  return rep;
+}
+
 void stringCombinatorialRec(std::vector<std::vector<std::string> >& res, const std::vector<std::string>& candidates,
                             const std::size_t depth) {
   if (depth == 0) return;
@@ -350,37 +371,28 @@ ProjectionReport maintain_contacts(ContactGenHelper& contactGenHelper) {
   }
   hppDout(notice, "candidates OK");
   Q_State& candidates = contactGenHelper.candidates_;
+  const State& workingState = contactGenHelper.workingState_;
   while (!candidates.empty() && !rep.success_) {
     // retrieve latest state
     State cState = candidates.front();
     candidates.pop();
-    hppDout(notice, "Project toRootConfiguration : ");
-    rep =
-        projectToRootConfiguration(contactGenHelper.fullBody_, contactGenHelper.workingState_.configuration_, cState);
-    hppDout(notice, "maintain contacts, projection success : " << rep.success_ << " for contacts : ");
-    for (std::map<std::string, bool>::const_iterator cit = cState.contacts_.begin(); cit != cState.contacts_.end();
-         ++cit) {
-      hppDout(notice, "limb : " << cit->first << ", contact = " << cit->second);
-    }
-    if (rep.success_) rep = genColFree(contactGenHelper, rep);
-    if (rep.success_) {
-      // collision validation
-      hpp::core::ValidationReportPtr_t valRep(new hpp::core::CollisionValidationReport);
-      rep.success_ =
-          contactGenHelper.fullBody_->GetCollisionValidation()->validate(rep.result_.configuration_, valRep);
-      hppDout(notice, "maintain contact collision for config : r(["
-                          << pinocchio::displayConfig(rep.result_.configuration_) << "])");
-      hppDout(notice, "valide  : " << rep.success_);
-      if (!rep.success_) {
-        valRep->print(std::cout);
-        std::cout << std::endl;
-        hppDout(notice, "report = " << *valRep);
+    if (contactGenHelper.maintainedContacts_ &&
+        cState.fixedContacts(cState) == workingState.fixedContacts(workingState)) {
+      hppDout(notice, "all contacts maintained, use the projection computed beforehand");
+      rep = *contactGenHelper.maintainedContacts_;
+      contactGenHelper.maintainedContacts_ = 0;
+    } else {
+      hppDout(notice, "Project toRootConfiguration for contacts : ");
+      for (std::map<std::string, bool>::const_iterator cit = cState.contacts_.begin();
+           cit != cState.contacts_.end(); ++cit) {
+        hppDout(notice, "limb : " << cit->first << ", contact = " << cit->second);
       }
+      rep = projectCollisionFree(contactGenHelper.context_, workingState, cState);
     }
     if (rep.success_) {
       if (contactGenHelper.quasiStatic_ && contactGenHelper.testReachability_) {
         reachability::Result resReachability =
-            reachability::isReachable(contactGenHelper.fullBody_, contactGenHelper.workingState_, rep.result_);
+            reachability::isReachable(contactGenHelper.context_, contactGenHelper.workingState_, rep.result_);
         rep.success_ = resReachability.success();
         hppDout(notice, "Reachability test for maintain contact : succes = " << rep.success_);
         rep.status_ = rep.success_ ? REACHABLE_CONTACT : STABLE_CONTACT;
@@ -394,36 +406,67 @@ ProjectionReport maintain_contacts(ContactGenHelper& contactGenHelper) {
   return rep;
 }
 
-sampling::T_OctreeReport CollideOctree(const ContactGenHelper& contactGenHelper, const std::string& limbName,
-                                       RbPrmLimbPtr_t limb, const sampling::heuristic evaluate,
-                                       const sampling::HeuristicParam& params) {
+ProjectionReport maintain_all_contacts(const KinematicContextPtr_t& context, const State& previous,
+                                       pinocchio::ConfigurationIn_t configuration) {
+  State workingState(previous);
+  workingState.configuration_ = configuration;
+  workingState.stable = false;
+  return projectCollisionFree(context, workingState, workingState);
+}
+
+sampling::CandidateQueue CollideOctree(const ContactGenHelper& contactGenHelper, const std::string& limbName,
+                                      RbPrmLimbPtr_t limb, const sampling::heuristic evaluate,
+                                      const sampling::HeuristicParam& params) {
   pinocchio::Transform3f transformpinocchio = limb->octreeRoot();  // get root transform from configuration
   fcl::Transform3f transform(transformpinocchio.rotation(), transformpinocchio.translation());
   std::vector<pinocchio::CollisionObjectPtr_t> affordances =
       getAffObjectsForLimb(limbName, contactGenHelper.affordances_, contactGenHelper.affFilters_);
 
-  //#pragma omp parallel for
   // request samples which collide with each of the collision objects
   sampling::heuristic eval = evaluate == 0 ? limb->evaluate_ : evaluate;
-  std::size_t i(0);
+  const sampling::batchHeuristic evalBatch = contactGenHelper.fullBody_->GetHeuristicFactory().GetBatchHeuristic(eval);
   if (affordances.empty()) throw std::runtime_error("No aff objects found!!!");
 
-  std::vector<sampling::T_OctreeReport> reports(affordances.size());
+  // candidates of all the objects are ordered according to the heuristic
+  sampling::CandidateQueue candidates(contactGenHelper.maxCandidates_);
   for (std::vector<pinocchio::CollisionObjectPtr_t>::const_iterator oit = affordances.begin();
-       oit != affordances.end(); ++oit, ++i) {
+       oit != affordances.end(); ++oit) {
     if (eval)
-      sampling::GetCandidates(limb->sampleContainer_, transform, *oit, contactGenHelper.direction_, reports[i], params,
-                              eval);
+      sampling::GetCandidates(limb->sampleContainer_, transform, *oit, contactGenHelper.direction_, candidates,
+                              params, eval, evalBatch);
     else
-      sampling::GetCandidates(limb->sampleContainer_, transform, *oit, contactGenHelper.direction_, reports[i],
+      sampling::GetCandidates(limb->sampleContainer_, transform, *oit, contactGenHelper.direction_, candidates,
                               params);
   }
-  sampling::T_OctreeReport finalSet;
-  // order samples according to EFORT
-  for (std::vector<sampling::T_OctreeReport>::const_iterator cit = reports.begin(); cit != reports.end(); ++cit) {
-    finalSet.insert(cit->begin(), cit->end());
+  return candidates;
+}
+
+// projection and equilibrium test of a contact candidate, which do not depend on the other candidates
+struct CandidateEvaluation {
+  CandidateEvaluation() : robustness_(-std::numeric_limits<double>::max()) {}
+  ProjectionReport rep_;
+  double robustness_;
+  std::exception_ptr error_;
+};
+
+// whether the equilibrium of a state obtained by contact creation must be tested
+bool checkStability(const ContactGenHelper& contactGenHelper, const State& state) {
+  return contactGenHelper.checkStabilityGenerate_ && (state.nbContacts != 1 || contactGenHelper.stableForOneContact_);
+}
+
+void evaluateCandidate(const ContactGenHelper& contactGenHelper, const KinematicContextPtr_t& context,
+                       const std::string& limbId, const RbPrmLimbPtr_t& limb,
+                       const core::CollisionValidationPtr_t& validation, const sampling::OctreeReport& report,
+                       const State& current, core::Configuration_t& configuration, CandidateEvaluation& evaluation) {
+  // exceptions are raised when the candidate is processed, as in a sequential evaluation.
+  // No benchmark here: this is called from the worker threads.
+  try {
+    evaluation.rep_ = projectSampleToObstacle(context, limbId, limb, report, validation, configuration, current);
+    if (evaluation.rep_.success_ && checkStability(contactGenHelper, evaluation.rep_.result_))
+      evaluation.robustness_ = stability::IsStable(context, evaluation.rep_.result_, contactGenHelper.acceleration_);
+  } catch (...) {
+    evaluation.error_ = std::current_exception();
   }
-  return finalSet;
 }
 
 hpp::rbprm::State findValidCandidate(const ContactGenHelper& contactGenHelper, const std::string& limbId,
@@ -434,11 +477,10 @@ hpp::rbprm::State findValidCandidate(const ContactGenHelper& contactGenHelper, c
   current.stable = false;
   State intermediateState(current);                 // state before new contact creation
   State previous(contactGenHelper.previousState_);  // previous state, before contact break
-  sampling::T_OctreeReport finalSet = CollideOctree(contactGenHelper, limbId, limb, evaluate, params);
+  sampling::CandidateQueue candidates = CollideOctree(contactGenHelper, limbId, limb, evaluate, params);
   core::Configuration_t moreRobust, bestUnreachable, configuration;
   configuration = current.configuration_;
   double maxRob = -std::numeric_limits<double>::max();
-  sampling::T_OctreeReport::const_iterator it = finalSet.begin();
   fcl::Vec3f position, normal;
   fcl::Matrix3f rotation;
   ProjectionReport rep;
@@ -446,101 +488,115 @@ hpp::rbprm::State findValidCandidate(const ContactGenHelper& contactGenHelper, c
   bool isReachable;
   int evaluatedCandidates = 0;
   hppDout(notice, "in findValidCandidate for limb : " << limbId);
-  hppDout(notice, "number of candidate : " << finalSet.size());
-  for (; !found_sample && it != finalSet.end(); ++it) {
+  hppDout(notice, "number of candidate : " << candidates.size());
+  // the candidates are projected and tested for equilibrium by batches of one candidate per worker,
+  // then processed in heuristic order, so that the candidate retained does not depend on the number of workers
+  const std::size_t batchSize = std::max<std::size_t>(1, contactGenHelper.workers_.size());
+  std::vector<sampling::OctreeReport> batch;
+  std::vector<core::Configuration_t> configurations;
+  std::vector<CandidateEvaluation> evaluations;
+  while (!found_sample && !candidates.empty()) {
     hppStartBenchmark(EVALUATE_CONTACT_CANDIDATE);
-    evaluatedCandidates++;
-    const sampling::OctreeReport& bestReport = *it;
-    hppDout(notice, "heuristic value = " << it->value_);
-    core::Configuration_t conf_before(configuration);
-    sampling::Load(*bestReport.sample_, conf_before);
-    hppDout(notice, "config before projection : r([" << pinocchio::displayConfig(conf_before) << "])");
-    hppStartBenchmark(PROJECTION_CONTACT);
-    /*ProjectionReport */ rep = projectSampleToObstacle(contactGenHelper.fullBody_, limbId, limb, bestReport,
-                                                        validation, configuration, current);
-    hppStopBenchmark(PROJECTION_CONTACT);
-    hppDisplayBenchmark(PROJECTION_CONTACT);
-    hppDout(notice, "config : r([" << pinocchio::displayConfig(configuration) << "])");
-    hppDout(notice, "projection to obstacle success = " << rep.success_);
-    if (rep.success_) {
-      hppDout(notice, "CheckStabilityGenerate : " << contactGenHelper.checkStabilityGenerate_);
-      hppDout(notice, "StableOneContact" << contactGenHelper.stableForOneContact_);
-      hppDout(notice, "Num contact : " << rep.result_.nbContacts);
-      if (!contactGenHelper.checkStabilityGenerate_ ||
-          (rep.result_.nbContacts == 1 &&
-           !contactGenHelper.stableForOneContact_)) {  // only check projection, success !
-        hppDout(notice, "Don't check stability : one contact or not the last contact");
-        position = rep.result_.contactPositions_.at(limbId);
-        rotation = rep.result_.contactRotation_.at(limbId);
-        normal = rep.result_.contactNormals_.at(limbId);
-        found_sample = true;
-      } else {  // check stability and reachability
-        hppStartBenchmark(STABILITY_CONTACT);
-        robustness = stability::IsStable(contactGenHelper.fullBody_, rep.result_, contactGenHelper.acceleration_);
-        hppStopBenchmark(STABILITY_CONTACT);
-        hppDisplayBenchmark(STABILITY_CONTACT);
-        hppDout(notice, "stability rob = " << robustness);
-        if (robustness >= contactGenHelper.robustnessTreshold_) {
-          hppDout(notice, "stability OK, test reachability : ");
-          if (contactGenHelper.testReachability_) {
-            reachability::Result resReachability;
-            if (contactGenHelper.quasiStatic_) {
-              resReachability = reachability::isReachable(contactGenHelper.fullBody_, intermediateState, rep.result_);
-              // resReachability = reachability::isReachable(contactGenHelper.fullBody_,previous,rep.result_); // TODO
-              // : use a parameter to choose between both cases
+    batch.clear();
+    for (; batch.size() < batchSize && !candidates.empty(); candidates.pop()) batch.push_back(candidates.top());
+    evaluations.assign(batch.size(), CandidateEvaluation());
+    hppStartBenchmark(PROJECTION_STABILITY_CONTACT);
+    if (batchSize == 1) {
+      evaluateCandidate(contactGenHelper, contactGenHelper.context_, limbId, limb, validation, batch.front(), current,
+                        configuration, evaluations.front());
+    } else {
+      configurations.assign(batch.size(), current.configuration_);
+#pragma omp parallel for num_threads((int)batch.size()) schedule(static, 1)
+      for (int i = 0; i < (int)batch.size(); ++i)
+        evaluateCandidate(contactGenHelper, contactGenHelper.workers_[i], limbId, limb, validation, batch[i], current,
+                          configurations[i], evaluations[i]);
+    }
+    hppStopBenchmark(PROJECTION_STABILITY_CONTACT);
+    hppDisplayBenchmark(PROJECTION_STABILITY_CONTACT);
+    for (std::size_t i = 0; !found_sample && i < batch.size(); ++i) {
+      evaluatedCandidates++;
+      const CandidateEvaluation& evaluation = evaluations[i];
+      if (evaluation.error_) std::rethrow_exception(evaluation.error_);
+      if (batchSize > 1) configuration = configurations[i];
+      rep = evaluation.rep_;
+      hppDout(notice, "heuristic value = " << batch[i].value_);
+      hppDout(notice, "config : r([" << pinocchio::displayConfig(configuration) << "])");
+      hppDout(notice, "projection to obstacle success = " << rep.success_);
+      if (rep.success_) {
+        hppDout(notice, "CheckStabilityGenerate : " << contactGenHelper.checkStabilityGenerate_);
+        hppDout(notice, "StableOneContact" << contactGenHelper.stableForOneContact_);
+        hppDout(notice, "Num contact : " << rep.result_.nbContacts);
+        if (!checkStability(contactGenHelper, rep.result_)) {  // only check projection, success !
+          hppDout(notice, "Don't check stability : one contact or not the last contact");
+          position = rep.result_.contactPositions_.at(limbId);
+          rotation = rep.result_.contactRotation_.at(limbId);
+          normal = rep.result_.contactNormals_.at(limbId);
+          found_sample = true;
+        } else {  // check stability and reachability
+          robustness = evaluation.robustness_;
+          hppDout(notice, "stability rob = " << robustness);
+          if (robustness >= contactGenHelper.robustnessTreshold_) {
+            hppDout(notice, "stability OK, test reachability : ");
+            if (contactGenHelper.testReachability_) {
+              reachability::Result resReachability;
+              if (contactGenHelper.quasiStatic_) {
+                resReachability = reachability::isReachable(contactGenHelper.context_, intermediateState, rep.result_);
+                // resReachability = reachability::isReachable(contactGenHelper.fullBody_,previous,rep.result_); // TODO
+                // : use a parameter to choose between both cases
+              } else {
+                hppStartBenchmark(REACHABILITY_CONTACT);
+                resReachability = reachability::isReachableDynamic(
+                    contactGenHelper.fullBody_, previous, rep.result_, contactGenHelper.tryQuasiStatic_,
+                    std::vector<double>(), contactGenHelper.reachabilityPointPerPhases_);
+                hppStopBenchmark(REACHABILITY_CONTACT);
+                hppDisplayBenchmark(REACHABILITY_CONTACT);
+              }
+              isReachable = resReachability.success();
             } else {
-              hppStartBenchmark(REACHABILITY_CONTACT);
-              resReachability = reachability::isReachableDynamic(
-                  contactGenHelper.fullBody_, previous, rep.result_, contactGenHelper.tryQuasiStatic_,
-                  std::vector<double>(), contactGenHelper.reachabilityPointPerPhases_);
-              hppStopBenchmark(REACHABILITY_CONTACT);
-              hppDisplayBenchmark(REACHABILITY_CONTACT);
+              isReachable = true;
             }
-            isReachable = resReachability.success();
-          } else {
-            isReachable = true;
-          }
-          if (isReachable) {  // reachable
-            position = rep.result_.contactPositions_.at(limbId);
-            rotation = rep.result_.contactRotation_.at(limbId);
-            normal = rep.result_.contactNormals_.at(limbId);
-            found_sample = true;
-            // TODO : save path (if not quasistatic)??
-          } else {
-            hppDout(notice, "NOT REACHABLE");
-            if (!found_stable) {
-              maxRob = std::max(robustness, maxRob);
-              // if no reachable state are found, we keep the first stable configuration found (ie. the one with the
-              // best heuristic score)
-              bestUnreachable = configuration;
-              found_stable = true;
+            if (isReachable) {  // reachable
               position = rep.result_.contactPositions_.at(limbId);
               rotation = rep.result_.contactRotation_.at(limbId);
               normal = rep.result_.contactNormals_.at(limbId);
+              found_sample = true;
+              // TODO : save path (if not quasistatic)??
+            } else {
+              hppDout(notice, "NOT REACHABLE");
+              if (!found_stable) {
+                maxRob = std::max(robustness, maxRob);
+                // if no reachable state are found, we keep the first stable configuration found (ie. the one with the
+                // best heuristic score)
+                bestUnreachable = configuration;
+                found_stable = true;
+                position = rep.result_.contactPositions_.at(limbId);
+                rotation = rep.result_.contactRotation_.at(limbId);
+                normal = rep.result_.contactNormals_.at(limbId);
+              }
+              /*   // DEBUGING PURPOSE : call again evaluate on the sample found
+                hppDout(notice,"found sample, evaluate : "); // remove
+                Eigen::Vector3d eDir(contactGenHelper.direction_[0], contactGenHelper.direction_[1],
+                contactGenHelper.direction_[2]); // remove eDir.normalize();       // remove hppDout(notice,"sample =
+                "<<(*(bestReport.sample_)).startRank_); // remove sampling::heuristic eval =  evaluate == 0 ?
+                limb->evaluate_ : evaluate;// remove
+                (*eval)(*(bestReport.sample_), eDir, normal, params); // TODO : comment when not debugging
+                core::Configuration_t confBefore= current.configuration_; // remove
+                sampling::Load(*(bestReport.sample_),confBefore); //remove
+                hppDout(notice,"config before projection : r(["<<pinocchio::displayConfig(confBefore)<<"])"); //remove
+               */
             }
-            /*   // DEBUGING PURPOSE : call again evaluate on the sample found
-              hppDout(notice,"found sample, evaluate : "); // remove
-              Eigen::Vector3d eDir(contactGenHelper.direction_[0], contactGenHelper.direction_[1],
-              contactGenHelper.direction_[2]); // remove eDir.normalize();       // remove hppDout(notice,"sample =
-              "<<(*(bestReport.sample_)).startRank_); // remove sampling::heuristic eval =  evaluate == 0 ?
-              limb->evaluate_ : evaluate;// remove
-              (*eval)(*(bestReport.sample_), eDir, normal, params); // TODO : comment when not debugging
-              core::Configuration_t confBefore= current.configuration_; // remove
-              sampling::Load(*(bestReport.sample_),confBefore); //remove
-              hppDout(notice,"config before projection : r(["<<pinocchio::displayConfig(confBefore)<<"])"); //remove
-             */
           }
-        }
-        // if no stable candidate is found, select best contact
-        // anyway
-        else if ((robustness > maxRob) && contactGenHelper.contactIfFails_) {
-          hppDout(notice, "unstable contact, but the most robust yet.");
-          moreRobust = configuration;
-          maxRob = robustness;
-          position = rep.result_.contactPositions_.at(limbId);
-          rotation = rep.result_.contactRotation_.at(limbId);
-          normal = rep.result_.contactNormals_.at(limbId);
-          unstableContact = true;
+          // if no stable candidate is found, select best contact
+          // anyway
+          else if ((robustness > maxRob) && contactGenHelper.contactIfFails_) {
+            hppDout(notice, "unstable contact, but the most robust yet.");
+            moreRobust = configuration;
+            maxRob = robustness;
+            position = rep.result_.contactPositions_.at(limbId);
+            rotation = rep.result_.contactRotation_.at(limbId);
+            normal = rep.result_.contactNormals_.at(limbId);
+            unstableContact = true;
+          }
         }
       }
     }
@@ -663,7 +719,7 @@ ProjectionReport gen_contacts(ContactGenHelper& contactGenHelper) {
         (contactGenHelper.workingState_.nbContacts >= 2 || contactGenHelper.stableForOneContact_)) {
       hppDout(notice,
               "List of free limbs empty in gen_contact, check stability for workingState with contact maintained");
-      double robustness = stability::IsStable(contactGenHelper.fullBody_, contactGenHelper.workingState_,
+      double robustness = stability::IsStable(contactGenHelper.context_, contactGenHelper.workingState_,
                                               contactGenHelper.acceleration_);
       hppDout(notice, "stability rob = " << robustness);
       if (robustness >= contactGenHelper.robustnessTreshold_) {
@@ -684,9 +740,8 @@ ProjectionReport gen_contacts(ContactGenHelper& contactGenHelper) {
       hppDout(notice, "Try to generate contact for limb : " << *cit);
       sampling::HeuristicParam params;
       params.contactPositions_ = cState.first.contactPositions_;
-      contactGenHelper.fullBody_->device_->currentConfiguration(cState.first.configuration_);
-      contactGenHelper.fullBody_->device_->computeForwardKinematics();
-      params.comPosition_ = contactGenHelper.fullBody_->device_->positionCenterOfMass();
+      contactGenHelper.context_->setConfiguration(cState.first.configuration_);
+      params.comPosition_ = contactGenHelper.context_->positionCenterOfMass();
       size_type cfgSize(cState.first.configuration_.rows());
       params.comSpeed_ = fcl::Vec3f(cState.first.configuration_[cfgSize - 6], cState.first.configuration_[cfgSize - 5],
                                     cState.first.configuration_[cfgSize - 4]);
@@ -738,9 +793,8 @@ projection::ProjectionReport repositionContacts(ContactGenHelper& helper) {
 
       sampling::HeuristicParam params;
       params.contactPositions_ = helper.workingState_.contactPositions_;
-      helper.fullBody_->device_->currentConfiguration(result.configuration_);
-      helper.fullBody_->device_->computeForwardKinematics();
-      params.comPosition_ = helper.fullBody_->device_->positionCenterOfMass();
+      helper.context_->setConfiguration(result.configuration_);
+      params.comPosition_ = helper.context_->positionCenterOfMass();
       size_type cfgSize(helper.workingState_.configuration_.rows());
       params.comSpeed_ = fcl::Vec3f(helper.workingState_.configuration_[cfgSize - 6],
                                     helper.workingState_.configuration_[cfgSize - 5],
@@ -7,6 +7,8 @@
 #include <pinocchio/utils/file-explorer.hpp>
 #include <pinocchio/parsers/utils.hpp>
 #include <pinocchio/multibody/geometry.hpp>
+#include <map>
+#include <memory>
 
 namespace hpp {
 namespace rbprm {
@@ -108,10 +110,10 @@ std::pair<hpp::rbprm::MatrixX3, hpp::rbprm::MatrixX3> hpp::rbprm::reachability::
 namespace hpp {
 namespace rbprm {
 namespace reachability {
-std::pair<MatrixX3, VectorX> computeAllKinematicsConstraints(const RbPrmFullBodyPtr_t& fullBody,
+std::pair<MatrixX3, VectorX> computeAllKinematicsConstraints(const KinematicContextPtr_t& context,
                                                              const pinocchio::ConfigurationPtr_t& configuration) {
-  fullBody->device_->currentConfiguration(*configuration);
-  fullBody->device_->computeForwardKinematics();
+  const RbPrmFullBodyPtr_t& fullBody = context->fullBody();
+  context->setConfiguration(*configuration);
   // first loop to compute size required :
   size_t numIneq = 0;
   for (CIT_Limb lit = fullBody->GetLimbs().begin(); lit != fullBody->GetLimbs().end(); ++lit) {
@@ -119,12 +121,11 @@ std::pair<MatrixX3, VectorX> computeAllKinematicsConstraints(const RbPrmFullBody
   }
   MatrixX3 A(numIneq, 3);
   VectorX b(numIneq);
-  std::pair<MatrixX3, VectorX> Ab_limb;
   size_t currentId = 0;
   for (CIT_Limb lit = fullBody->GetLimbs().begin(); lit != fullBody->GetLimbs().end(); ++lit) {
     if (lit->second->kinematicConstraints_.first.size() > 0) {
-      Ab_limb = getInequalitiesAtTransform(lit->second->kinematicConstraints_,
-                                           lit->second->effector_.currentTransformation());
+      const std::pair<MatrixX3, VectorX>& Ab_limb =
+          getInequalitiesAtTransform(lit->second, context->effectorTransformation(lit->second));
       A.block(currentId, 0, Ab_limb.first.rows(), 3) = Ab_limb.first;
       b.segment(currentId, Ab_limb.first.rows()) = Ab_limb.second;
       currentId += Ab_limb.first.rows();
@@ -134,10 +135,15 @@ std::pair<MatrixX3, VectorX> computeAllKinematicsConstraints(const RbPrmFullBody
   return std::make_pair(A, b);
 }
 
-std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const RbPrmFullBodyPtr_t& fullBody,
+std::pair<MatrixX3, VectorX> computeAllKinematicsConstraints(const RbPrmFullBodyPtr_t& fullBody,
+                                                             const pinocchio::ConfigurationPtr_t& configuration) {
+  return computeAllKinematicsConstraints(KinematicContext::shared(fullBody), configuration);
+}
+
+std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const KinematicContextPtr_t& context,
                                                                   const State& state) {
-  fullBody->device_->currentConfiguration(state.configuration_);
-  fullBody->device_->computeForwardKinematics();
+  const RbPrmFullBodyPtr_t& fullBody = context->fullBody();
+  context->setConfiguration(state.configuration_);
   hppDout(notice, "Compute kinematics constraints :");
   // first loop to compute size required :
   size_t numIneq = 0;
@@ -150,14 +156,14 @@ std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const RbPrmFul
   }
   MatrixX3 A(numIneq, 3);
   VectorX b(numIneq);
-  std::pair<MatrixX3, VectorX> Ab_limb;
   size_t currentId = 0;
   RbPrmLimbPtr_t limb;
   for (std::map<std::string, bool>::const_iterator cit = state.contacts_.begin(); cit != state.contacts_.end();
        ++cit) {
     if (cit->second) {  // limb with name cit->first is in contact
       limb = fullBody->GetLimb(cit->first);
-      Ab_limb = getInequalitiesAtTransform(limb->kinematicConstraints_, limb->effector_.currentTransformation());
+      const std::pair<MatrixX3, VectorX>& Ab_limb =
+          getInequalitiesAtTransform(limb, context->effectorTransformation(limb));
       A.block(currentId, 0, Ab_limb.first.rows(), 3) = Ab_limb.first;
       b.segment(currentId, Ab_limb.first.rows()) = Ab_limb.second;
       currentId += Ab_limb.first.rows();
@@ -167,10 +173,14 @@ std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const RbPrmFul
   return std::make_pair(A, b);
 }
 
-std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForLimb(const RbPrmFullBodyPtr_t& fullBody,
+std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForState(const RbPrmFullBodyPtr_t& fullBody,
+                                                                  const State& state) {
+  return computeKinematicsConstraintsForState(KinematicContext::shared(fullBody), state);
+}
+
+std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForLimb(const KinematicContextPtr_t& context,
                                                                  const State& state, const std::string& limbName) {
-  fullBody->device_->currentConfiguration(state.configuration_);
-  fullBody->device_->computeForwardKinematics();
+  context->setConfiguration(state.configuration_);
   hppDout(notice, "Compute kinematics constraints for limb :" << limbName);
   // first loop to compute size required :
   if (state.contacts_.find(limbName) == state.contacts_.end()) {
@@ -182,29 +192,51 @@ std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForLimb(const RbPrmFull
     return std::pair<MatrixX3, VectorX>();
   }
 
-  RbPrmLimbPtr_t limb = fullBody->GetLimb(limbName);
-  return getInequalitiesAtTransform(limb->kinematicConstraints_, limb->effector_.currentTransformation());
+  RbPrmLimbPtr_t limb = context->fullBody()->GetLimb(limbName);
+  return getInequalitiesAtTransform(limb, context->effectorTransformation(limb));
+}
+
+std::pair<MatrixX3, VectorX> computeKinematicsConstraintsForLimb(const RbPrmFullBodyPtr_t& fullBody,
+                                                                 const State& state, const std::string& limbName) {
+  return computeKinematicsConstraintsForLimb(KinematicContext::shared(fullBody), state, limbName);
 }
 
 std::pair<MatrixX3, VectorX> getInequalitiesAtTransform(const std::pair<MatrixX3, MatrixX3>& NV,
                                                         const hpp::pinocchio::Transform3f& transformPin) {
-  fcl::Transform3f transform(transformPin.rotation(), transformPin.translation());
-  size_t numIneq = NV.first.rows();
-  MatrixX3 A(numIneq, 3);
-  VectorX b(numIneq);
-  VectorX n, v;
-  for (size_t i = 0; i < numIneq; ++i) {
-    n = transform.getRotation() * (NV.first.block<1, 3>(i, 0).transpose());
-    v = transform.transform(NV.second.block<1, 3>(i, 0).transpose());
-    A.block<1, 3>(i, 0) = n;
-    b[i] = v.dot(n);
-  }
-  // hppDout(notice,"Transform : "<<transform);
-  //  hppDout(notice,"A : "<<A);
-  //  hppDout(notice,"b : "<<b);
+  // the normals n_i are rotated (A = N R^T), and the vertices v_i transformed:
+  // b_i = (R v_i + t).(R n_i) = v_i.n_i + t.(R n_i)
+  MatrixX3 A(NV.first * transformPin.rotation().transpose());
+  VectorX b(NV.second.cwiseProduct(NV.first).rowwise().sum() + A * transformPin.translation());
   return std::make_pair(A, b);
 }
 
+namespace {
+// inequalities of the kinematic constraints of a limb at the last effector transform queried by the thread
+struct LimbConstraints {
+  std::weak_ptr<RbPrmLimb> limb_;
+  const double* normals_;
+  pinocchio::Transform3f transform_;
+  std::pair<MatrixX3, VectorX> Ab_;
+};
+typedef std::map<const RbPrmLimb*, LimbConstraints> T_LimbConstraints;
+}  // namespace
+
+const std::pair<MatrixX3, VectorX>& getInequalitiesAtTransform(const RbPrmLimbPtr_t& limb,
+                                                               const hpp::pinocchio::Transform3f& transform) {
+  thread_local T_LimbConstraints cache;
+  LimbConstraints& constraints = cache[limb.get()];
+  // the address of a destroyed limb may be reused by a new one, and the constraints of a limb may be reloaded
+  if (constraints.limb_.lock() != limb || constraints.normals_ != limb->kinematicConstraints_.first.data() ||
+      constraints.transform_.rotation() != transform.rotation() ||
+      constraints.transform_.translation() != transform.translation()) {
+    constraints.limb_ = limb;
+    constraints.normals_ = limb->kinematicConstraints_.first.data();
+    constraints.transform_ = transform;
+    constraints.Ab_ = getInequalitiesAtTransform(limb->kinematicConstraints_, transform);
+  }
+  return constraints.Ab_;
+}
+
 bool verifyKinematicConstraints(const std::pair<MatrixX3, MatrixX3>& NV, const hpp::pinocchio::Transform3f& transform,
                                 const fcl::Vec3f& point) {
   return verifyKinematicConstraints(getInequalitiesAtTransform(NV, transform), point);
@@ -228,6 +260,10 @@ bool verifyKinematicConstraints(const RbPrmFullBodyPtr_t& fullbody, const State&
   return verifyKinematicConstraints(computeKinematicsConstraintsForState(fullbody, state), point);
 }
 
+bool verifyKinematicConstraints(const KinematicContextPtr_t& context, const State& state, fcl::Vec3f point) {
+  return verifyKinematicConstraints(computeKinematicsConstraintsForState(context, state), point);
+}
+
 }  // namespace reachability
 }  // namespace rbprm
 }  // namespace hpp
@@ -5,6 +5,8 @@
 #include <hpp/rbprm/stability/stability.hh>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <hpp/util/timer.hh>
 
 #ifndef QHULL
@@ -152,14 +154,14 @@ std::pair<MatrixXX, VectorX> computeStabilityConstraints(const centroidal_dynami
   return std::make_pair(A, b);
 }
 
-centroidal_dynamics::Equilibrium computeContactConeForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
+centroidal_dynamics::Equilibrium computeContactConeForState(const KinematicContextPtr_t& context, State& state,
                                                             bool& success) {
   hppStartBenchmark(REACHABLE_CALL_CENTROIDAL);
-  centroidal_dynamics::Equilibrium contactCone(fullbody->device_->name(), fullbody->device_->mass(), 4,
+  centroidal_dynamics::Equilibrium contactCone(context->device()->name(), context->device()->mass(), 4,
                                                centroidal_dynamics::SOLVER_LP_QPOASES, true, 1000, false);
   centroidal_dynamics::EquilibriumAlgorithm alg = centroidal_dynamics::EQUILIBRIUM_ALGORITHM_PP;
   try {
-    stability::setupLibrary(fullbody, state, contactCone, alg, fullbody->getFriction(), 0.05,
+    stability::setupLibrary(context, state, contactCone, alg, context->fullBody()->getFriction(), 0.05,
                             0.05);  // 0.01 : 'safe' support zone, under the flexibility
     success = true;
   } catch (std::runtime_error e) {
@@ -171,11 +173,11 @@ centroidal_dynamics::Equilibrium computeContactConeForState(const RbPrmFullBodyP
   return contactCone;
 }
 
-std::pair<MatrixXX, VectorX> computeStabilityConstraintsForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
+std::pair<MatrixXX, VectorX> computeStabilityConstraintsForState(const KinematicContextPtr_t& context, State& state,
                                                                  bool& success, const fcl::Vec3f& acc) {
   hppDout(notice, "contact order : ");
   hppDout(notice, "  " << state.contactOrder_.front());
-  centroidal_dynamics::Equilibrium cone(computeContactConeForState(fullbody, state, success));
+  centroidal_dynamics::Equilibrium cone(computeContactConeForState(context, state, success));
   std::pair<MatrixXX, VectorX> Ab;
   if (success) {
     Ab = computeStabilityConstraints(cone, state.contactPositions_.at(state.contactOrder_.front()), acc);
@@ -188,16 +190,27 @@ std::pair<MatrixXX, VectorX> computeStabilityConstraintsForState(const RbPrmFull
   return Ab;
 }
 
-std::pair<MatrixXX, VectorX> computeConstraintsForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
+std::pair<MatrixXX, VectorX> computeStabilityConstraintsForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
+                                                                 bool& success, const fcl::Vec3f& acc) {
+  return computeStabilityConstraintsForState(KinematicContext::shared(fullbody), state, success, acc);
+}
+
+std::pair<MatrixXX, VectorX> computeConstraintsForState(const KinematicContextPtr_t& context, State& state,
                                                         bool& success, const fcl::Vec3f& acc) {
-  std::pair<MatrixXX, VectorX> Ab = computeStabilityConstraintsForState(fullbody, state, success, acc);
+  std::pair<MatrixXX, VectorX> Ab = computeStabilityConstraintsForState(context, state, success, acc);
   if (success)
-    return stackConstraints(computeKinematicsConstraintsForState(fullbody, state), Ab);
+    return stackConstraints(computeKinematicsConstraintsForState(context, state), Ab);
   else
     return Ab;
 }
 
-Result isReachableIntermediate(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& intermediate, State& next) {
+std::pair<MatrixXX, VectorX> computeConstraintsForState(const RbPrmFullBodyPtr_t& fullbody, State& state,
+                                                        bool& success, const fcl::Vec3f& acc) {
+  return computeConstraintsForState(KinematicContext::shared(fullbody), state, success, acc);
+}
+
+Result isReachableIntermediate(const KinematicContextPtr_t& context, State& previous, State& intermediate,
+                               State& next) {
   // TODO
   hppDout(notice, "isReachableIntermadiate :");
   std::vector<std::string> contactsNames = next.contactVariations(previous);
@@ -205,8 +218,8 @@ Result isReachableIntermediate(const RbPrmFullBodyPtr_t& fullbody, State& previo
   Result resBreak, resCreate;
   Result res;
   std::pair<MatrixXX, VectorX> Ab, Cd;
-  resBreak = isReachable(fullbody, previous, intermediate);
-  resCreate = isReachable(fullbody, intermediate, next);
+  resBreak = isReachable(context, previous, intermediate);
+  resCreate = isReachable(context, intermediate, next);
   hppDout(notice, "isReachableIntermediate : ");
   hppDout(notice, "resBreak status    : " << resBreak.status);
   hppDout(notice, "resCreation status : " << resCreate.status);
@@ -237,7 +250,27 @@ Result isReachableIntermediate(const RbPrmFullBodyPtr_t& fullbody, State& previo
   return res;
 }
 
-Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& next, const fcl::Vec3f& acc,
+// The candidates for a new contact are tested successively with the same previous state,
+// the kinematic constraints of the last previous state are thus kept by each thread.
+// The constraints only depend on the full body, not on the device of the context used to compute them.
+const std::pair<MatrixXX, VectorX>& previousKinematicsConstraints(const KinematicContextPtr_t& context,
+                                                                  const State& previous) {
+  const RbPrmFullBodyPtr_t& fullbody = context->fullBody();
+  thread_local std::weak_ptr<RbPrmFullBody> lastFullBody;
+  thread_local core::Configuration_t lastConfiguration;
+  thread_local std::map<std::string, bool> lastContacts;
+  thread_local std::pair<MatrixXX, VectorX> K_p;
+  if (lastFullBody.lock() != fullbody || lastContacts != previous.contacts_ ||
+      lastConfiguration.size() != previous.configuration_.size() || lastConfiguration != previous.configuration_) {
+    K_p = computeKinematicsConstraintsForState(context, previous);
+    lastFullBody = fullbody;
+    lastConfiguration = previous.configuration_;
+    lastContacts = previous.contacts_;
+  }
+  return K_p;
+}
+
+Result isReachable(const KinematicContextPtr_t& context, State& previous, State& next, const fcl::Vec3f& acc,
                    bool useIntermediateState) {
   hppStartBenchmark(IS_REACHABLE);
   assert(previous.nbContacts > 0 && "Reachability : previous state have less than 1 contact.");
@@ -272,7 +305,7 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
       hppDout(notice, "Contact repositionning between the 2 states, create intermediate state");
       if (useIntermediateState) {
         hppDout(notice, "call isReachableIntermediate.");
-        return isReachableIntermediate(fullbody, previous, intermediate, next);
+        return isReachableIntermediate(context, previous, intermediate, next);
       }
     } else {
       hppDout(notice, "Contact break and creation are different. You need to call isReachable with 2 adjacent states");
@@ -285,12 +318,12 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
   Result res;
   std::pair<MatrixXX, VectorX> Ab, K_p, K_n, A_p, A_n;
   if (contactsBreak.size() == 1 && contactsCreation.size() == 1) {
-    A_p = computeConstraintsForState(fullbody, previous, successCone, acc);
+    A_p = computeConstraintsForState(context, previous, successCone, acc);
     if (!successCone) {
       hppDout(warning, "Unable to compute computeStabilityConstraintsForState.");
       return Result(UNABLE_TO_COMPUTE);
     }
-    A_n = computeConstraintsForState(fullbody, next, successCone, acc);
+    A_n = computeConstraintsForState(context, next, successCone, acc);
     if (!successCone) {
       hppDout(warning, "Unable to compute computeStabilityConstraintsForState.");
       return Result(UNABLE_TO_COMPUTE);
@@ -305,13 +338,13 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
     // A_n \inside A_p, thus  A_p is redunbdant
     // K_p \inside K_n, thus  K_n is redunbdant
     // So, we only need to test A_n \inter K_p
-    // TODO : K_p can be given as parameter to avoid re-computation
+    // K_p is kept from the previous call when previous did not change (see previousKinematicsConstraints)
     // std::pair<MatrixXX,VectorX> A_n = computeStabilityConstraintsForState(fullbody,next);
     // std::pair<MatrixXX,VectorX> K_p = computeKinematicsConstraintsForState(fullbody,previous);
     // Ab = stackConstraints(A_n,K_p);
     // develloped computation, needed to display the differents constraints :
     hppStartBenchmark(REACHABLE_STABILITY);
-    A_n = computeStabilityConstraintsForState(fullbody, next, successCone, acc);
+    A_n = computeStabilityConstraintsForState(context, next, successCone, acc);
     if (!successCone) {
       hppDout(warning, "Unable to compute computeStabilityConstraintsForState.");
       return Result(UNABLE_TO_COMPUTE);
@@ -320,7 +353,7 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
     hppStopBenchmark(REACHABLE_STABILITY);
     hppDisplayBenchmark(REACHABLE_STABILITY);
     hppStartBenchmark(REACHABLE_KINEMATIC);
-    K_p = computeKinematicsConstraintsForState(fullbody, previous);
+    K_p = previousKinematicsConstraints(context, previous);
     hppStopBenchmark(REACHABLE_KINEMATIC);
     hppDisplayBenchmark(REACHABLE_KINEMATIC);
     hppStartBenchmark(REACHABLE_STACK);
@@ -337,7 +370,7 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
     // std::pair<MatrixXX,VectorX> K_n_m = computeKinematicsConstraintsForLimb(fullbody,previous,contactsCreation[0]);
     // // kinematic constraint only for the moving contact for state previous Ab = stackConstraints(C_p,K_n_m);
     hppStartBenchmark(REACHABLE_STABILITY);
-    A_p = computeStabilityConstraintsForState(fullbody, previous, successCone, acc);
+    A_p = computeStabilityConstraintsForState(context, previous, successCone, acc);
     if (!successCone) {
       hppDout(warning, "Unable to compute computeStabilityConstraintsForState.");
       return Result(UNABLE_TO_COMPUTE);
@@ -346,7 +379,7 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
     hppDisplayBenchmark(REACHABLE_STABILITY);
     // K_p = computeKinematicsConstraintsForState(fullbody,previous);
     hppStartBenchmark(REACHABLE_KINEMATIC);
-    K_n = computeKinematicsConstraintsForState(fullbody, next);
+    K_n = computeKinematicsConstraintsForState(context, next);
     hppStopBenchmark(REACHABLE_KINEMATIC);
     hppDisplayBenchmark(REACHABLE_KINEMATIC);
     hppStartBenchmark(REACHABLE_STACK);
@@ -356,17 +389,16 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
   }
 
   // compute COM positions :
-  pinocchio::Computation_t flag = fullbody->device_->computationFlag();
+  const pinocchio::DevicePtr_t& device = context->device();
+  pinocchio::Computation_t flag = device->computationFlag();
   pinocchio::Computation_t newflag =
       static_cast<pinocchio::Computation_t>(pinocchio::JOINT_POSITION | pinocchio::JACOBIAN | pinocchio::COM);
-  fullbody->device_->controlComputation(newflag);
-  fullbody->device_->currentConfiguration(previous.configuration_);
-  fullbody->device_->computeForwardKinematics();
-  fcl::Vec3f com_previous = fullbody->device_->positionCenterOfMass();
-  fullbody->device_->currentConfiguration(next.configuration_);
-  fullbody->device_->computeForwardKinematics();
-  fcl::Vec3f com_next = fullbody->device_->positionCenterOfMass();
-  fullbody->device_->controlComputation(flag);
+  device->controlComputation(newflag);
+  context->setConfiguration(previous.configuration_);
+  fcl::Vec3f com_previous = context->positionCenterOfMass();
+  context->setConfiguration(next.configuration_);
+  fcl::Vec3f com_next = context->positionCenterOfMass();
+  device->controlComputation(flag);
 
   // compute the position in the middle of the most constrained support polygon (used for the cost function):
   State smaller_state;
@@ -381,7 +413,7 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
   for (std::map<std::string, fcl::Vec3f>::const_iterator cit = smaller_state.contactPositions_.begin();
        cit != smaller_state.contactPositions_.end(); ++cit) {
     fcl::Transform3f jointT(smaller_state.contactRotation_.at(cit->first), cit->second);
-    fcl::Vec3f position = jointT.transform(fullbody->GetLimb(cit->first)->offset_);
+    fcl::Vec3f position = jointT.transform(context->fullBody()->GetLimb(cit->first)->offset_);
     c_robust += position;
   }
   c_robust /= (fcl::FCL_REAL)smaller_state.contactPositions_.size();
@@ -444,6 +476,11 @@ Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& n
   return res;
 }
 
+Result isReachable(const RbPrmFullBodyPtr_t& fullbody, State& previous, State& next, const fcl::Vec3f& acc,
+                   bool useIntermediateState) {
+  return isReachable(KinematicContext::shared(fullbody), previous, next, acc, useIntermediateState);
+}
+
 void printTimingFile(std::ofstream& file, const VectorX& timings, bool success, bool quasiStaticSuccess) {
   using std::endl;
   file << timings[0] << " " << timings[1] << " " << timings[2] << " " << (success ? "1 " : "0 ")
@@ -50,17 +50,16 @@ bool DynamicPathValidation::validate(const core::PathPtr_t& path, bool reverse,
   hppDout(notice, "dynamic path validation called with filters");
   hppStartBenchmark(PATH_VALIDATION);
   core::ValidationReportPtr_t configReport;
-  Configuration_t q;
-  if (reverse)
-    (*path)(q, path->timeRange().second);
-  else
-    (*path)(q, path->timeRange().first);
-
-  rbprmValidation_->validate(q, configReport);
-  dynamicValidation_->setInitialReport(configReport);
-  hppDout(notice, "dynamic validation set initial report OK");
+  startValidation(path, reverse);
 
   assert(path);
+  if (adaptiveStep() || bisectionOrder()) {
+    bool valid = adaptiveStep() ? validateAdaptive(path, reverse, validPart, validationReport, filter)
+                                : validateBisection(path, reverse, &validPart, validationReport, filter);
+    hppStopBenchmark(PATH_VALIDATION);
+    hppDisplayBenchmark(PATH_VALIDATION);
+    return valid;
+  }
   bool valid = true;
   if (reverse) {
     value_type tmin = path->timeRange().first;
@@ -135,12 +134,7 @@ bool DynamicPathValidation::validate(const core::PathPtr_t& path, bool reverse,
   hppDisplayBenchmark(PATH_VALIDATION);
 }
 
-bool DynamicPathValidation::validate(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
-                                     core::PathValidationReportPtr_t& validationReport) {
-  hppDout(info, "dynamic path validation called");
-  hppDout(info, "path begin : " << path->timeRange().first);
-  hppDout(info, "path end : " << path->timeRange().second);
-  hppStartBenchmark(PATH_VALIDATION);
+void DynamicPathValidation::startValidation(const core::PathPtr_t& path, bool reverse) {
   core::ValidationReportPtr_t configReport;
   Configuration_t q(path->outputSize());
   if (reverse)
@@ -150,11 +144,37 @@ bool DynamicPathValidation::validate(const core::PathPtr_t& path, bool reverse,
 
   hppDout(info, "q = " << pinocchio::displayConfig(q));
   rbprmValidation_->validate(q, configReport);
-
   hppDout(info, "rbprmValidation called");
   dynamicValidation_->setInitialReport(configReport);
   hppDout(info, "dynamic validation set initial report OK");
-  bool valid = core::pathValidation::Discretized::validate(path, reverse, validPart, validationReport);
+}
+
+bool DynamicPathValidation::validateConfiguration(const Configuration_t& q, core::ValidationReportPtr_t& report,
+                                                  const std::vector<std::string>& filter) {
+  return RbPrmPathValidation::validateConfiguration(q, report, filter) && dynamicValidation_->validate(q, report);
+}
+
+bool DynamicPathValidation::validateConfiguration(const Configuration_t& q, core::ValidationReportPtr_t& report,
+                                                  const std::vector<std::string>& filter, value_type& step) {
+  // the dynamic validation reads the contacts from the report of the rbprm validation
+  return RbPrmPathValidation::validateConfiguration(q, report, filter, step) &&
+         dynamicValidation_->validate(q, report);
+}
+
+bool DynamicPathValidation::validate(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
+                                     core::PathValidationReportPtr_t& validationReport) {
+  hppDout(info, "dynamic path validation called");
+  hppDout(info, "path begin : " << path->timeRange().first);
+  hppDout(info, "path end : " << path->timeRange().second);
+  hppStartBenchmark(PATH_VALIDATION);
+  startValidation(path, reverse);
+  bool valid;
+  if (adaptiveStep())
+    valid = validateAdaptive(path, reverse, validPart, validationReport, rbprmValidation_->defaultFilter_);
+  else if (bisectionOrder())
+    valid = validateBisection(path, reverse, &validPart, validationReport, rbprmValidation_->defaultFilter_);
+  else
+    valid = core::pathValidation::Discretized::validate(path, reverse, validPart, validationReport);
   hppStopBenchmark(PATH_VALIDATION);
   hppDisplayBenchmark(PATH_VALIDATION);
   return valid;
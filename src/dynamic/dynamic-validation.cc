@@ -97,7 +97,7 @@ bool DynamicValidation::validate(const core::Configuration_t& config, core::Vali
     lastReport_ = rbReport;
     core::ConfigurationPtr_t q = core::ConfigurationPtr_t(new core::Configuration_t(config));
     core::RbprmNode node(q);
-    node.fillNodeMatrices(rbReport, rectangularContact_, sizeFootX_, sizeFootY_, mass_, mu_, robot_);
+    node.fillNodeMatrices(rbReport, rectangularContact_, sizeFootX_, sizeFootY_, mass_, mu_, robot_, contactSurfaces_);
     sEq_->setG(node.getG());
     h_ = node.geth();
     H_ = node.getH();
@@ -130,7 +130,8 @@ DynamicValidation::DynamicValidation(bool rectangularContact, double sizeFootX,
       mu_(mu),
       robot_(std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(robot)),
       sEq_(new centroidal_dynamics::Equilibrium("dynamic_val", mass, 4, centroidal_dynamics::SOLVER_LP_QPOASES, true,
-                                                10, false)) {
+                                                10, false)),
+      contactSurfaces_(core::ContactSurfaceCache::create()) {
   assert(robot_ && "Error in dynamic cast of problem device to rbprmDevice");
   hppDout(info, "Dynamic validation created with attribut : rectangular contact = " << rectangularContact
                                                                                     << " size foot : " << sizeFootX);
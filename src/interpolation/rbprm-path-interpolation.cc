@@ -22,6 +22,10 @@
 #include <hpp/rbprm/interpolation/interpolation-constraints.hh>
 #include <hpp/rbprm/sampling/heuristic-tools.hh>
 #include <hpp/rbprm/contact_generation/reachability.hh>
+#include <hpp/rbprm/contact_generation/kinematics_constraints.hh>
+#include <hpp/rbprm/stability/stability.hh>
+#include <exception>
+#include <functional>
 #ifdef PROFILE
 #include "hpp/rbprm/rbprm-profiler.hh"
 #endif
@@ -184,6 +188,103 @@ core::Configuration_t loadPreviousConfiguration(const DevicePtr_t& device, const
   return res;
 }
 
+// projects previous to the configurations [first, first + workers.size()) of configs maintaining all its contacts,
+// in parallel on the contexts of workers.
+// errors[i] holds the exception raised for the configuration first + i, which is then projected again by the main
+// thread when it is reached
+void maintainContactsAhead(const T_KinematicContext& workers, const State& previous, const T_Configuration& configs,
+                           const std::size_t first, std::vector<projection::ProjectionReport>& maintained,
+                           std::vector<std::exception_ptr>& errors) {
+  const std::size_t nbConfigs = std::min(workers.size(), configs.size() - first);
+  maintained.assign(nbConfigs, projection::ProjectionReport());
+  errors.assign(nbConfigs, std::exception_ptr());
+#pragma omp parallel for num_threads((int)nbConfigs) schedule(static, 1)
+  for (int i = 0; i < (int)nbConfigs; ++i) {
+    try {
+      const core::Configuration_t configuration =
+          loadPreviousConfiguration(workers[i]->device(), previous.configuration_, configs[first + i]);
+      maintained[i] = contact::maintain_all_contacts(workers[i], previous, configuration);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+}
+
+// acceleration of the center of mass stored in the extra configuration space, zero if it is not stored
+fcl::Vec3f comAcceleration(const DevicePtr_t& device, const core::Configuration_t& configuration) {
+  const size_t accIndex = device->configSize() - device->extraConfigSpace().dimension() + 3;
+  if (accIndex < (std::size_t)configuration.size()) return configuration.segment<3>(accIndex);
+  return fcl::Vec3f::Zero();
+}
+
+// true if state maintains all the contacts of previous and is accepted by ComputeContacts as it would be
+// for previous and the configuration of state: reachable from previous in quasi-static and balanced
+bool maintainsContacts(const KinematicContextPtr_t& context, const State& previous, State& state,
+                       const double robustnessTreshold, const bool testReachability, const bool quasiStatic) {
+  if (!state.contactBreaks(previous).empty() || !state.contactCreations(previous).empty() || state.nbContacts < 2)
+    return false;
+  if (quasiStatic && testReachability) {
+    State workingState(previous);
+    workingState.configuration_ = state.configuration_;
+    workingState.stable = false;
+    if (!reachability::isReachable(context, workingState, state).success()) return false;
+  }
+  return stability::IsStable(context, state, comAcceleration(context->device(), state.configuration_)) >=
+         robustnessTreshold;
+}
+
+std::size_t RbPrmInterpolation::skipMaintainedConfigurations(const T_Configuration& configs,
+                                                             const CIT_Configuration& cit, const State& previous,
+                                                             const Configuration_t& lastConfig,
+                                                             const double robustnessTreshold, std::size_t& stride,
+                                                             contact::ContactReport& report) {
+  if (stride == 0) {
+    // the last probe failed next to this configuration, which is not probed
+    stride = 1;
+    return 0;
+  }
+  // ComputeContacts tries to create a contact for each free limb, at any configuration
+  for (T_Limb::const_iterator lit = robot_->GetLimbs().begin(); lit != robot_->GetLimbs().end(); ++lit) {
+    std::map<std::string, bool>::const_iterator cit2 = previous.contacts_.find(lit->first);
+    if (cit2 == previous.contacts_.end() || !cit2->second) return 0;
+  }
+  const std::size_t index = cit - configs.begin();
+  std::size_t nbSkipped = std::min(stride, configs.size() - 1 - index);
+  // the contacts of previous cannot all be maintained once the center of mass leaves their kinematic constraints:
+  // the probe stops before the first configuration where it does
+  const KinematicContextPtr_t context = KinematicContext::shared(robot_);
+  const std::pair<MatrixX3, VectorX> Ab = reachability::computeKinematicsConstraintsForState(context, previous);
+  for (std::size_t i = 0; i <= nbSkipped; ++i) {
+    context->setConfiguration(loadPreviousConfiguration(robot_->device_, lastConfig, configs[index + i]));
+    if (!reachability::verifyKinematicConstraints(Ab, context->positionCenterOfMass())) {
+      hppDout(notice, "kinematic constraints of the last state violated at configuration " << index + i);
+      nbSkipped = i > 0 ? i - 1 : 0;
+      break;
+    }
+  }
+  // bisect the probe while the contacts change
+  for (; nbSkipped > 0; nbSkipped /= 2) {
+    const core::Configuration_t configuration =
+        loadPreviousConfiguration(robot_->device_, lastConfig, configs[index + nbSkipped]);
+    hppDout(notice, "probe configuration " << index + nbSkipped);
+    // only the projection maintaining all the contacts is tried
+    projection::ProjectionReport maintained = contact::maintain_all_contacts(context, previous, configuration);
+    if (maintained.success_ && maintainsContacts(context, previous, maintained.result_, robustnessTreshold,
+                                                 testReachability_, quasiStatic_)) {
+      report = contact::ContactReport(maintained);
+      const pinocchio::size_type extraDim = robot_->device_->extraConfigSpace().dimension();
+      report.result_.configuration_.tail(extraDim) = configuration.tail(extraDim);
+      report.result_.stable = true;
+      report.status_ = quasiStatic_ && testReachability_ ? REACHABLE_CONTACT : STABLE_CONTACT;
+      report.contactMaintained_ = true;
+      stride = 2 * nbSkipped;
+      return nbSkipped;
+    }
+    stride = nbSkipped / 2;
+  }
+  return 0;
+}
+
 rbprm::T_StateFrame RbPrmInterpolation::Interpolate(const affMap_t& affordances,
                                                     const std::map<std::string, std::vector<std::string> >& affFilters,
                                                     const hpp::rbprm::T_Configuration& configs,
@@ -206,6 +307,13 @@ rbprm::T_StateFrame RbPrmInterpolation::Interpolate(const affMap_t& affordances,
   Eigen::Vector3d dir, acc;
   acc = Eigen::Vector3d::Zero();
   const PathConstPtr_t comPath = std::dynamic_pointer_cast<const core::Path>(path_);
+  // contacts maintained ahead for the configurations [firstMaintained, firstMaintained + maintained.size())
+  // of configs, valid while the last state is the one of index maintainedState
+  std::vector<projection::ProjectionReport> maintained;
+  std::vector<std::exception_ptr> maintainErrors;
+  std::size_t firstMaintained = 0, maintainedState = 0;
+  // number of configurations probed ahead in adaptive mode
+  std::size_t stride = 1;
 #ifdef PROFILE
   RbPrmProfiler& watch = getRbPrmProfiler();
   watch.reset_all();
@@ -213,6 +321,14 @@ rbprm::T_StateFrame RbPrmInterpolation::Interpolate(const affMap_t& affordances,
 #endif
   for (CIT_Configuration cit = configs.begin() + 1; cit != configs.end(); ++cit, currentVal += timeStep) {
     const State& previous = states.back().second;
+    hpp::rbprm::contact::ContactReport rep;
+    std::size_t nbSkipped = 0;
+    if (adaptiveStep_ && allowFailure) {
+      nbSkipped =
+          skipMaintainedConfigurations(configs, cit, previous, lastConfig, robustnessTreshold, stride, rep);
+      cit += nbSkipped;
+      currentVal += (double)nbSkipped * timeStep;
+    }
     core::Configuration_t configuration = loadPreviousConfiguration(robot_->device_, lastConfig, *cit);
     if (accIndex < (std::size_t)configuration.size()) {
       acc = configuration.segment<3>(accIndex);
@@ -224,10 +340,25 @@ rbprm::T_StateFrame RbPrmInterpolation::Interpolate(const affMap_t& affordances,
     direction.normalize();
     if (!nonZero) direction = fcl::Vec3f(0, 0, 1.);
     // TODO Direction 6d
+    const projection::ProjectionReport* maintainedContacts = 0;
+    if (workers_.size() > 1 && !adaptiveStep_) {
+      const std::size_t index = cit - configs.begin();
+      if (maintained.empty() || maintainedState != states.size() - 1 || index < firstMaintained ||
+          index >= firstMaintained + maintained.size()) {
+        hppDout(notice, "maintain the contacts of state " << states.size() - 1 << " from configuration " << index);
+        maintainedState = states.size() - 1;
+        firstMaintained = index;
+        maintainContactsAhead(workers_, previous, configs, firstMaintained, maintained, maintainErrors);
+      }
+      if (!maintainErrors[index - firstMaintained]) maintainedContacts = &maintained[index - firstMaintained];
+    }
     hppDout(notice, "#call ComputeContact, looking for state " << states.size() - 1);
-    hpp::rbprm::contact::ContactReport rep =
-        contact::ComputeContacts(previous, robot_, configuration, affordances, affFilters, direction,
-                                 robustnessTreshold, acc, comPath, currentVal, testReachability_, quasiStatic_);
+    if (nbSkipped == 0)
+      rep = contact::ComputeContacts(previous, robot_, configuration, affordances, affFilters, direction,
+                                     robustnessTreshold, acc, comPath, currentVal, testReachability_, quasiStatic_,
+                                     maintainedContacts);
+    else
+      hppDout(notice, "configurations skipped : " << nbSkipped);
     State& newState = rep.result_;
 
     const bool sameAsPrevious = rep.success_ && rep.contactMaintained_ && !rep.contactCreated_;
@@ -323,6 +454,7 @@ rbprm::T_StateFrame RbPrmInterpolation::Interpolate(const affMap_t& affordances,
 
     // code to add the first valid config of each states :
     if (!sameAsPrevious) {
+      stride = 1;
       states.push_back(std::make_pair(currentVal, newState));
       hppDout(notice, "new state added at index " << states.size() - 1 << " conf = r(["
                                                   << pinocchio::displayConfig(states.back().second.configuration_)
@@ -371,6 +503,7 @@ RbPrmInterpolation::RbPrmInterpolation(const core::PathVectorConstPtr_t path,
       end_(end),
       testReachability_(testReachability),
       quasiStatic_(quasiStatic),
+      adaptiveStep_(false),
       robot_(robot) {
   // TODO
 }
@@ -407,8 +540,66 @@ StateFrame RbPrmInterpolation::findBestRepositionState(T_StateFrame candidates,
   return bestState;
 }
 
+// combines value into the hash seed, as boost::hash_combine
+void hashCombine(std::size_t& seed, const std::size_t value) {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// hash of the content of a state used by the reachability test: its configuration and its contacts
+std::size_t hashState(const State& state) {
+  std::size_t seed = 0;
+  for (pinocchio::size_type i = 0; i < state.configuration_.size(); ++i)
+    hashCombine(seed, std::hash<double>()(state.configuration_[i]));
+  for (std::map<std::string, bool>::const_iterator cit = state.contacts_.begin(); cit != state.contacts_.end();
+       ++cit) {
+    if (!cit->second) continue;
+    hashCombine(seed, std::hash<std::string>()(cit->first));
+    const fcl::Vec3f& position = state.contactPositions_.at(cit->first);
+    const fcl::Vec3f& normal = state.contactNormals_.at(cit->first);
+    for (int i = 0; i < 3; ++i) {
+      hashCombine(seed, std::hash<double>()(position[i]));
+      hashCombine(seed, std::hash<double>()(normal[i]));
+    }
+  }
+  return seed;
+}
+
+// true if both states have the same configuration and the same contacts
+bool sameState(const State& s0, const State& s1) {
+  if (s0.configuration_.size() != s1.configuration_.size() || s0.configuration_ != s1.configuration_) return false;
+  std::map<std::string, bool>::const_iterator cit0 = s0.contacts_.begin();
+  std::map<std::string, bool>::const_iterator cit1 = s1.contacts_.begin();
+  while (cit0 != s0.contacts_.end() || cit1 != s1.contacts_.end()) {
+    if (cit0 != s0.contacts_.end() && !cit0->second) {
+      ++cit0;
+      continue;
+    }
+    if (cit1 != s1.contacts_.end() && !cit1->second) {
+      ++cit1;
+      continue;
+    }
+    if (cit0 == s0.contacts_.end() || cit1 == s1.contacts_.end() || cit0->first != cit1->first) return false;
+    const std::string& name = cit0->first;
+    if (s0.contactPositions_.at(name) != s1.contactPositions_.at(name) ||
+        s0.contactNormals_.at(name) != s1.contactNormals_.at(name))
+      return false;
+    std::map<std::string, fcl::Matrix3f>::const_iterator rit0 = s0.contactRotation_.find(name);
+    std::map<std::string, fcl::Matrix3f>::const_iterator rit1 = s1.contactRotation_.find(name);
+    if ((rit0 == s0.contactRotation_.end()) != (rit1 == s1.contactRotation_.end())) return false;
+    if (rit0 != s0.contactRotation_.end() && rit0->second != rit1->second) return false;
+    ++cit0;
+    ++cit1;
+  }
+  return true;
+}
+
 bool RbPrmInterpolation::testReachability(const State& s0, const State& s1) {
   if (testReachability_) {
+    typedef std::multimap<std::pair<std::size_t, std::size_t>, ReachabilityResult>::const_iterator CIT_Result;
+    const std::pair<std::size_t, std::size_t> key(hashState(s0), hashState(s1));
+    const std::pair<CIT_Result, CIT_Result> range = reachabilityResults_.equal_range(key);
+    for (CIT_Result it = range.first; it != range.second; ++it)
+      if (sameState(it->second.from_, s0) && sameState(it->second.to_, s1)) return it->second.success_;
     State state0(s0);
     State state1(s1);
     reachability::Result resReachability;
@@ -417,6 +608,8 @@ bool RbPrmInterpolation::testReachability(const State& s0, const State& s1) {
     } else {
       resReachability = reachability::isReachableDynamic(robot_, state0, state1);
     }
+    const ReachabilityResult result = {s0, s1, resReachability.success()};
+    reachabilityResults_.insert(std::make_pair(key, result));
     return resReachability.success();
   } else {
     return true;
@@ -424,75 +617,80 @@ bool RbPrmInterpolation::testReachability(const State& s0, const State& s1) {
 }
 
 void RbPrmInterpolation::FilterRepositioning(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res) {
-  if (from == to) return;
-  State current = (from)->second;
-  State current_m1 = (from - 1)->second;
-  State current_p1 = (from + 1)->second;
-  if (EqStringVec(current.contactBreaks(current_m1), current_p1.contactBreaks(current_m1)) &&
-      EqStringVec(current.contactCreations(current_m1), current_p1.contactCreations(current)) &&
-      testReachability(current_m1, current_p1)) {
-    if (from + 1 == to) return;
-    // Check if there is others state with the same contacts, and only add the one with the best score for the
-    // heuristic :
-    /*bool reposition(true);
-    size_t id = 2;
-    T_StateFrame repositionnedStates;
-    repositionnedStates.push_back(std::make_pair((from)->first, (from)->second));
-    repositionnedStates.push_back(std::make_pair((from+1)->first, (from+1)->second));
-    while(reposition && (from+id != to)){
-      current_m1=(from+id-1)->second;
-      current=(from+id)->second;
-      current_p1 = (from+id+1)->second;
-      if(EqStringVec(current.contactBreaks(current_m1),
-                     current_p1.contactBreaks(current_m1)) &&
-         EqStringVec(current.contactCreations(current_m1),
-                     current_p1.contactCreations(current))){
-        repositionnedStates.push_back(std::make_pair((from+id)->first, (from+id)->second));
-        repositionnedStates.push_back(std::make_pair((from+id+1)->first, (from+id+1)->second));
-        id+=2;
-      }
-      else
-        reposition = false;
+  CIT_StateFrame cit = from;
+  while (cit != to) {
+    const State& current = (cit)->second;
+    const State& current_m1 = (cit - 1)->second;
+    const State& current_p1 = (cit + 1)->second;
+    if (EqStringVec(current.contactBreaks(current_m1), current_p1.contactBreaks(current_m1)) &&
+        EqStringVec(current.contactCreations(current_m1), current_p1.contactCreations(current)) &&
+        testReachability(current_m1, current_p1)) {
+      if (cit + 1 == to) return;
+      // Check if there is others state with the same contacts, and only add the one with the best score for the
+      // heuristic :
+      /*bool reposition(true);
+      size_t id = 2;
+      T_StateFrame repositionnedStates;
+      repositionnedStates.push_back(std::make_pair((from)->first, (from)->second));
+      repositionnedStates.push_back(std::make_pair((from+1)->first, (from+1)->second));
+      while(reposition && (from+id != to)){
+        current_m1=(from+id-1)->second;
+        current=(from+id)->second;
+        current_p1 = (from+id+1)->second;
+        if(EqStringVec(current.contactBreaks(current_m1),
+                       current_p1.contactBreaks(current_m1)) &&
+           EqStringVec(current.contactCreations(current_m1),
+                       current_p1.contactCreations(current))){
+          repositionnedStates.push_back(std::make_pair((from+id)->first, (from+id)->second));
+          repositionnedStates.push_back(std::make_pair((from+id+1)->first, (from+id+1)->second));
+          id+=2;
+        }
+        else
+          reposition = false;
 
+      }
+      hppDout(notice,"repositionned contacts found : number of states = "<<repositionnedStates.size());
+      // iterate over respoitionnedStates and find the one with the best score with the heuristic (for the limb that
+      move)
+
+      T_StateFrame repositionnedStates;
+      repositionnedStates.push_back(std::make_pair((from)->first, (from)->second));
+      repositionnedStates.push_back(std::make_pair((from+1)->first, (from+1)->second));
+      std::vector<std::string> limbsNames = current.contactCreations(current_m1);
+      StateFrame bestState = findBestRepositionState(repositionnedStates,limbsNames);
+      */
+      res.push_back(*(cit + 1));
+      cit += 2;
+    } else {
+      res.push_back(*cit);
+      ++cit;
     }
-    hppDout(notice,"repositionned contacts found : number of states = "<<repositionnedStates.size());
-    // iterate over respoitionnedStates and find the one with the best score with the heuristic (for the limb that
-    move)
-
-    T_StateFrame repositionnedStates;
-    repositionnedStates.push_back(std::make_pair((from)->first, (from)->second));
-    repositionnedStates.push_back(std::make_pair((from+1)->first, (from+1)->second));
-    std::vector<std::string> limbsNames = current.contactCreations(current_m1);
-    StateFrame bestState = findBestRepositionState(repositionnedStates,limbsNames);
-    */
-    res.push_back(std::make_pair((from + 1)->first, (from + 1)->second));
-    FilterRepositioning(from + 2, to, res);
-  } else {
-    res.push_back(std::make_pair(from->first, from->second));
-    FilterRepositioning(from + 1, to, res);
   }
 }
 
 void RbPrmInterpolation::FilterBreakCreate(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res) {
-  if (from == to) return;
-  const State& current = (from)->second;
-  const State& current_m1 = (from - 1)->second;
-  const State& current_p1 = (from + 1)->second;
-  if (current.contactCreations(current_m1).empty() && current_p1.contactBreaks(current).empty() &&
-      EqStringVec(current_p1.contactCreations(current), current.contactBreaks(current_m1)) &&
-      testReachability(current_m1, current_p1)) {
-    if (from + 1 == to) return;
-    res.push_back(std::make_pair((from + 1)->first, (from + 1)->second));
-    FilterBreakCreate(from + 2, to, res);
-  } else {
-    res.push_back(std::make_pair(from->first, from->second));
-    FilterBreakCreate(from + 1, to, res);
+  CIT_StateFrame cit = from;
+  while (cit != to) {
+    const State& current = (cit)->second;
+    const State& current_m1 = (cit - 1)->second;
+    const State& current_p1 = (cit + 1)->second;
+    if (current.contactCreations(current_m1).empty() && current_p1.contactBreaks(current).empty() &&
+        EqStringVec(current_p1.contactCreations(current), current.contactBreaks(current_m1)) &&
+        testReachability(current_m1, current_p1)) {
+      if (cit + 1 == to) return;
+      res.push_back(*(cit + 1));
+      cit += 2;
+    } else {
+      res.push_back(*cit);
+      ++cit;
+    }
   }
 }
 
 T_StateFrame RbPrmInterpolation::FilterRepositioning(const T_StateFrame& originStates) {
   if (originStates.size() < 3) return originStates;
   T_StateFrame res;
+  res.reserve(originStates.size());
   res.push_back(originStates.front());
   FilterRepositioning(originStates.begin() + 1, originStates.end() - 1, res);
   res.push_back(originStates.back());
@@ -502,6 +700,7 @@ T_StateFrame RbPrmInterpolation::FilterRepositioning(const T_StateFrame& originS
 T_StateFrame RbPrmInterpolation::FilterBreakCreate(const T_StateFrame& originStates) {
   if (originStates.size() < 3) return originStates;
   T_StateFrame res;
+  res.reserve(originStates.size());
   res.push_back(originStates.front());
   FilterBreakCreate(originStates.begin() + 1, originStates.end() - 1, res);
   res.push_back(originStates.back());
@@ -511,6 +710,7 @@ T_StateFrame RbPrmInterpolation::FilterBreakCreate(const T_StateFrame& originSta
 T_StateFrame FilterObsolete(const T_StateFrame& originStates) {
   if (originStates.size() < 3) return originStates;
   T_StateFrame res;
+  res.reserve(originStates.size());
   res.push_back(originStates.front());
   CIT_StateFrame cit = originStates.begin();
   for (CIT_StateFrame cit2 = originStates.begin() + 1; cit2 != originStates.end() - 1; ++cit, ++cit2) {
@@ -526,8 +726,8 @@ T_StateFrame FilterObsolete(const T_StateFrame& originStates) {
   cit = res.begin();
   std::size_t idx = 0;
   for (T_StateFrame::const_iterator cit2 = res.begin() + 1; cit2 != res.end() - 1; ++cit, ++cit2, ++idx) {
-    const State prev = cit->second;
-    const State next = cit2->second;
+    const State& prev = cit->second;
+    const State& next = cit2->second;
     std::vector<std::string> breaks = next.contactBreaks(prev);
     std::vector<std::string> creations = next.contactCreations(prev);
     if (breaks.size() > 1 || creations.size() > 1) {
@@ -545,145 +745,189 @@ T_StateFrame FilterObsolete(const T_StateFrame& originStates) {
   return res;
 }
 
-void RbPrmInterpolation::tryReplaceStates(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res) {
-  if (from == to) {
-    res.push_back(std::make_pair(from->first, from->second));
-    res.push_back(std::make_pair((from + 1)->first, (from + 1)->second));
-    return;
+// hash of the states [from, from + 4), with the kind of substitution tried on them
+std::size_t hashSubstitution(const CIT_StateFrame& from, const std::size_t kind) {
+  std::size_t seed = kind;
+  for (CIT_StateFrame cit = from; cit != from + 4; ++cit) hashCombine(seed, hashState(cit->second));
+  return seed;
+}
+
+bool RbPrmInterpolation::substitutionFailed(const CIT_StateFrame& from, const std::size_t kind) const {
+  typedef std::multimap<std::size_t, FailedSubstitution>::const_iterator CIT_Failed;
+  const std::pair<CIT_Failed, CIT_Failed> range = failedSubstitutions_.equal_range(hashSubstitution(from, kind));
+  for (CIT_Failed it = range.first; it != range.second; ++it) {
+    if (it->second.kind_ != kind) continue;
+    bool same = true;
+    for (std::size_t i = 0; i < 4 && same; ++i) same = sameState(it->second.states_[i], (from + i)->second);
+    if (same) return true;
   }
+  return false;
+}
+
+void RbPrmInterpolation::addFailedSubstitution(const CIT_StateFrame& from, const std::size_t kind) {
+  FailedSubstitution failed;
+  failed.kind_ = kind;
+  for (CIT_StateFrame cit = from; cit != from + 4; ++cit) failed.states_.push_back(cit->second);
+  failedSubstitutions_.insert(std::make_pair(hashSubstitution(from, kind), failed));
+}
+
+bool RbPrmInterpolation::tryReplaceState(const CIT_StateFrame& from, State& replaced) {
   const State& ci0 = (from)->second;
   const State& ci1 = (from + 1)->second;
   const State& ci2 = (from + 2)->second;
   const State& ci3 = (from + 3)->second;
 
   hppDout(notice, "Try Replace State : ");
-  if (ci3.contactCreations(ci2).size() == 1 && EqStringVec(ci1.contactBreaks(ci0), ci3.contactBreaks(ci2)) &&
-      EqStringVec(ci1.contactBreaks(ci0), ci1.contactCreations(ci0)) &&
-      EqStringVec(ci1.contactBreaks(ci0), ci3.contactCreations(ci2)) &&
-      !EqStringVec(ci1.contactBreaks(ci0), ci2.contactBreaks(ci1)) &&
-      !EqStringVec(ci1.contactCreations(ci0), ci2.contactCreations(ci1))) {
-    hppDout(notice, "condition on contact OK");
-    // try to create a state s1_bis : s1 with the new contact in the same position as in s3
-    // robot_->device_->currentConfiguration(ci3.configuration_);
-    // robot_->device_->computeForwardKinematics();
-    State s1_bis(ci1);
-    s1_bis.configuration_ = ci3.configuration_;
-    // get contact information from state 3 :
-    std::string contactCreate = ci3.contactCreations(ci2)[0];
-    hppDout(notice, "contact to change : " << contactCreate);
-    fcl::Vec3f n = ci3.contactNormals_.at(contactCreate);
-    fcl::Vec3f p = ci3.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
-    fcl::Vec3f p1 = ci1.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
-    hppDout(notice, "position : " << p);
-    hppDout(notice, "normal   : " << n);
-    hppDout(notice, "difference with previous position : " << (p1 - p).norm());
-    // fcl::Matrix3f r = ci3.contactRotation_.at(contactCreate);
-    projection::ProjectionReport rep =
-        projection::projectStateToObstacle(robot_, contactCreate, robot_->GetLimb(contactCreate), s1_bis, n, p);
-    hppDout(notice, "projection success : " << rep.success_);
-    if (rep.success_) {
-      rep = projection::projectToRootConfiguration(robot_, ci1.configuration_, rep.result_);
-    }
-    ValidationReportPtr_t rport(ValidationReportPtr_t(new CollisionValidationReport));
-    if ((p1 - p).norm() < 0.2 && rep.success_ &&
-        robot_->GetCollisionValidation()->validate(rep.result_.configuration_, rport) &&
-        testReachability(rep.result_, ci3)) {
-      hppDout(notice, "projection is collision free !");
+  if (!(ci3.contactCreations(ci2).size() == 1 && EqStringVec(ci1.contactBreaks(ci0), ci3.contactBreaks(ci2)) &&
+        EqStringVec(ci1.contactBreaks(ci0), ci1.contactCreations(ci0)) &&
+        EqStringVec(ci1.contactBreaks(ci0), ci3.contactCreations(ci2)) &&
+        !EqStringVec(ci1.contactBreaks(ci0), ci2.contactBreaks(ci1)) &&
+        !EqStringVec(ci1.contactCreations(ci0), ci2.contactCreations(ci1))))
+    return false;
+  hppDout(notice, "condition on contact OK");
+  // the result only depends on the four states: projectStateToObstacle does not lock the other joints to the
+  // current configuration of the device, so a substitution that failed fails again in the next iterations
+  if (substitutionFailed(from, 0)) return false;
+  // try to create a state s1_bis : s1 with the new contact in the same position as in s3
+  // robot_->device_->currentConfiguration(ci3.configuration_);
+  // robot_->device_->computeForwardKinematics();
+  State s1_bis(ci1);
+  s1_bis.configuration_ = ci3.configuration_;
+  // get contact information from state 3 :
+  std::string contactCreate = ci3.contactCreations(ci2)[0];
+  hppDout(notice, "contact to change : " << contactCreate);
+  fcl::Vec3f n = ci3.contactNormals_.at(contactCreate);
+  fcl::Vec3f p = ci3.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
+  fcl::Vec3f p1 = ci1.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
+  hppDout(notice, "position : " << p);
+  hppDout(notice, "normal   : " << n);
+  hppDout(notice, "difference with previous position : " << (p1 - p).norm());
+  // fcl::Matrix3f r = ci3.contactRotation_.at(contactCreate);
+  projection::ProjectionReport rep =
+      projection::projectStateToObstacle(robot_, contactCreate, robot_->GetLimb(contactCreate), s1_bis, n, p);
+  hppDout(notice, "projection success : " << rep.success_);
+  if (rep.success_) {
+    rep = projection::projectToRootConfiguration(robot_, ci1.configuration_, rep.result_);
+  }
+  ValidationReportPtr_t rport(ValidationReportPtr_t(new CollisionValidationReport));
+  if ((p1 - p).norm() < 0.2 && rep.success_ &&
+      robot_->GetCollisionValidation()->validate(rep.result_.configuration_, rport) &&
+      testReachability(rep.result_, ci3)) {
+    hppDout(notice, "projection is collision free !");
+    replaced = rep.result_;
+    return true;
+  }
+  addFailedSubstitution(from, 0);
+  return false;
+}
+
+void RbPrmInterpolation::tryReplaceStates(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res) {
+  State replaced;
+  CIT_StateFrame cit = from;
+  while (cit != to) {
+    res.push_back(*cit);
+    if (tryReplaceState(cit, replaced)) {
       // success ! add s1_bis instead of s1, and skip s2 :
-      res.push_back(std::make_pair(from->first, from->second));
-      res.push_back(std::make_pair((from + 1)->first, rep.result_));
-      if (from + 1 == to) return;
-      if (from + 2 == to) {
-        res.push_back(std::make_pair((from + 3)->first, (from + 3)->second));
+      res.push_back(std::make_pair((cit + 1)->first, replaced));
+      if (cit + 1 == to) return;
+      if (cit + 2 == to) {
+        res.push_back(*(cit + 3));
         return;
       }
-      tryReplaceStates(from + 3, to, res);
+      cit += 3;
     } else {
-      res.push_back(std::make_pair(from->first, from->second));
-      tryReplaceStates(from + 1, to, res);
+      ++cit;
     }
-  } else {
-    res.push_back(std::make_pair(from->first, from->second));
-    tryReplaceStates(from + 1, to, res);
   }
+  res.push_back(*cit);
+  res.push_back(*(cit + 1));
 }
 
 T_StateFrame RbPrmInterpolation::tryReplaceStates(const T_StateFrame& originStates) {
   hppDout(notice, "Begin tryReplaceStates, size of list : " << originStates.size());
   if (originStates.size() < 4) return originStates;
   T_StateFrame res;
+  res.reserve(originStates.size());
   tryReplaceStates(originStates.begin(), originStates.end() - 3, res);
   res.push_back(originStates.back());
   return res;
 }
 
-void RbPrmInterpolation::trySkipStates(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res) {
-  if (from == to) {
-    res.push_back(std::make_pair(from->first, from->second));
-    res.push_back(std::make_pair((from + 1)->first, (from + 1)->second));
-    return;
-  }
+bool RbPrmInterpolation::trySkipState(const CIT_StateFrame& from, State& replaced) {
   const State& ci0 = (from)->second;
   const State& ci1 = (from + 1)->second;
   const State& ci2 = (from + 2)->second;
   const State& ci3 = (from + 3)->second;
 
   hppDout(notice, "Try Skip State : ");
-  if (ci2.contactCreations(ci1).size() == 1 && EqStringVec(ci1.contactBreaks(ci0), ci3.contactBreaks(ci2)) &&
-      EqStringVec(ci1.contactBreaks(ci0), ci1.contactCreations(ci0)) &&
-      EqStringVec(ci1.contactBreaks(ci0), ci3.contactCreations(ci2)) &&
-      !EqStringVec(ci1.contactBreaks(ci0), ci2.contactBreaks(ci1)) &&
-      !EqStringVec(ci1.contactCreations(ci0), ci2.contactCreations(ci1))) {
-    hppDout(notice, "condition on contact OK");
-    // try to create a state s2_bis : s2 with the previous contact in the same position as in s0
-    State s2_bis(ci2);
-    s2_bis.configuration_ = ci0.configuration_;
-    // get contact information from state 0 :
-    std::string contactCreate = ci1.contactCreations(ci0)[0];
-    hppDout(notice, "contact to change : " << contactCreate);
-    fcl::Vec3f n = ci0.contactNormals_.at(contactCreate);
-    fcl::Vec3f p = ci0.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
-    p -= n * 10e-3;  // FIXME see 'epsilon' in projection::computeProjectionMatrix, why is it added ?
-    fcl::Vec3f p1 = ci1.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
-    p1 -= ci1.contactNormals_.at(contactCreate) * 10e-3;
-    hppDout(notice, "position : " << p);
-    hppDout(notice, "normal   : " << n);
-    hppDout(notice, "difference with previous position : " << (p1 - p).norm());
-    // fcl::Matrix3f r = ci3.contactRotation_.at(contactCreate);
-    projection::ProjectionReport rep =
-        projection::projectStateToObstacle(robot_, contactCreate, robot_->GetLimb(contactCreate), s2_bis, n, p);
-    hppDout(notice, "projection success : " << rep.success_);
-    if (rep.success_) {
-      rep = projection::projectToRootConfiguration(robot_, ci2.configuration_, rep.result_);
-    }
-    ValidationReportPtr_t rport(ValidationReportPtr_t(new CollisionValidationReport));
-    if ((p1 - p).norm() < 0.1 && rep.success_ &&
-        robot_->GetCollisionValidation()->validate(rep.result_.configuration_, rport) &&
-        testReachability(ci0, rep.result_) && testReachability(rep.result_, ci3)) {
-      hppDout(notice, "projection is collision free !");
+  if (!(ci2.contactCreations(ci1).size() == 1 && EqStringVec(ci1.contactBreaks(ci0), ci3.contactBreaks(ci2)) &&
+        EqStringVec(ci1.contactBreaks(ci0), ci1.contactCreations(ci0)) &&
+        EqStringVec(ci1.contactBreaks(ci0), ci3.contactCreations(ci2)) &&
+        !EqStringVec(ci1.contactBreaks(ci0), ci2.contactBreaks(ci1)) &&
+        !EqStringVec(ci1.contactCreations(ci0), ci2.contactCreations(ci1))))
+    return false;
+  hppDout(notice, "condition on contact OK");
+  if (substitutionFailed(from, 1)) return false;
+  // try to create a state s2_bis : s2 with the previous contact in the same position as in s0
+  State s2_bis(ci2);
+  s2_bis.configuration_ = ci0.configuration_;
+  // get contact information from state 0 :
+  std::string contactCreate = ci1.contactCreations(ci0)[0];
+  hppDout(notice, "contact to change : " << contactCreate);
+  fcl::Vec3f n = ci0.contactNormals_.at(contactCreate);
+  fcl::Vec3f p = ci0.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
+  p -= n * 10e-3;  // FIXME see 'epsilon' in projection::computeProjectionMatrix, why is it added ?
+  fcl::Vec3f p1 = ci1.contactPositions_.at(contactCreate) + robot_->GetLimb(contactCreate)->offset_;
+  p1 -= ci1.contactNormals_.at(contactCreate) * 10e-3;
+  hppDout(notice, "position : " << p);
+  hppDout(notice, "normal   : " << n);
+  hppDout(notice, "difference with previous position : " << (p1 - p).norm());
+  // fcl::Matrix3f r = ci3.contactRotation_.at(contactCreate);
+  projection::ProjectionReport rep =
+      projection::projectStateToObstacle(robot_, contactCreate, robot_->GetLimb(contactCreate), s2_bis, n, p);
+  hppDout(notice, "projection success : " << rep.success_);
+  if (rep.success_) {
+    rep = projection::projectToRootConfiguration(robot_, ci2.configuration_, rep.result_);
+  }
+  ValidationReportPtr_t rport(ValidationReportPtr_t(new CollisionValidationReport));
+  if ((p1 - p).norm() < 0.1 && rep.success_ &&
+      robot_->GetCollisionValidation()->validate(rep.result_.configuration_, rport) &&
+      testReachability(ci0, rep.result_) && testReachability(rep.result_, ci3)) {
+    hppDout(notice, "projection is collision free !");
+    replaced = rep.result_;
+    return true;
+  }
+  addFailedSubstitution(from, 1);
+  return false;
+}
+
+void RbPrmInterpolation::trySkipStates(const CIT_StateFrame& from, const CIT_StateFrame to, T_StateFrame& res) {
+  State replaced;
+  CIT_StateFrame cit = from;
+  while (cit != to) {
+    res.push_back(*cit);
+    if (trySkipState(cit, replaced)) {
       // success ! add s2_bis instead of s2, and skip s1 :
-      res.push_back(std::make_pair(from->first, from->second));
-      res.push_back(std::make_pair((from + 2)->first, rep.result_));
-      if (from + 1 == to) return;
-      if (from + 2 == to) {
-        res.push_back(std::make_pair((from + 3)->first, (from + 3)->second));
+      res.push_back(std::make_pair((cit + 2)->first, replaced));
+      if (cit + 1 == to) return;
+      if (cit + 2 == to) {
+        res.push_back(*(cit + 3));
         return;
       }
-      trySkipStates(from + 3, to, res);
+      cit += 3;
     } else {
-      res.push_back(std::make_pair(from->first, from->second));
-      trySkipStates(from + 1, to, res);
+      ++cit;
     }
-  } else {
-    res.push_back(std::make_pair(from->first, from->second));
-    trySkipStates(from + 1, to, res);
   }
+  res.push_back(*cit);
+  res.push_back(*(cit + 1));
 }
 
 T_StateFrame RbPrmInterpolation::trySkipStates(const T_StateFrame& originStates) {
   hppDout(notice, "Begin trySkipStates, size of list : " << originStates.size());
   if (originStates.size() < 4) return originStates;
   T_StateFrame res;
+  res.reserve(originStates.size());
   trySkipStates(originStates.begin(), originStates.end() - 3, res);
   res.push_back(originStates.back());
   return res;
@@ -702,12 +946,15 @@ T_StateFrame RbPrmInterpolation::FilterStates(const T_StateFrame& originStates,
     hppDout(notice, "Return original state list");
     return originStates;
   }
+  // the states compared in the previous calls may have been modified
+  reachabilityResults_.clear();
+  failedSubstitutions_.clear();
   T_StateFrame::const_iterator cit = originStates.begin();
   std::size_t idx = 0;
   for (T_StateFrame::const_iterator cit2 = originStates.begin() + 1; cit2 != originStates.end() - 1;
        ++cit, ++cit2, ++idx) {
-    const State prev = cit->second;
-    const State next = cit2->second;
+    const State& prev = cit->second;
+    const State& next = cit2->second;
     std::vector<std::string> breaks = next.contactBreaks(prev);
     std::vector<std::string> creations = next.contactCreations(prev);
     if (breaks.size() > 1 || creations.size() > 1) {
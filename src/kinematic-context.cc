@@ -0,0 +1,98 @@
+// Copyright (c) 2026, LAAS-CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-rbprm. If not, see <http://www.gnu.org/licenses/>.
+
+#include <hpp/rbprm/kinematic-context.hh>
+#include <hpp/rbprm/rbprm-fullbody.hh>
+#include <hpp/pinocchio/joint.hh>
+
+namespace hpp {
+namespace rbprm {
+
+namespace {
+void addLimbs(const pinocchio::DevicePtr_t& device, const T_Limb& limbs,
+              std::map<std::string, pinocchio::Frame>& effectors,
+              std::map<std::string, pinocchio::JointPtr_t>& joints) {
+  for (CIT_Limb lit = limbs.begin(); lit != limbs.end(); ++lit) {
+    const std::string& name = lit->second->effector_.name();
+    if (effectors.find(name) == effectors.end())
+      effectors.insert(std::make_pair(name, device->getFrameByName(name)));
+    const std::string& jointName = lit->second->limb_->name();
+    if (joints.find(jointName) == joints.end())
+      joints.insert(std::make_pair(jointName, device->getJointByName(jointName)));
+  }
+}
+}  // namespace
+
+KinematicContextPtr_t KinematicContext::create(const RbPrmFullBodyPtr_t& fullBody) {
+  return KinematicContextPtr_t(new KinematicContext(fullBody, fullBody->device_->clone()));
+}
+
+KinematicContextPtr_t KinematicContext::shared(const RbPrmFullBodyPtr_t& fullBody) {
+  return KinematicContextPtr_t(new KinematicContext(fullBody, fullBody->device_));
+}
+
+KinematicContext::KinematicContext(const RbPrmFullBodyPtr_t& fullBody, const pinocchio::DevicePtr_t& device)
+    : fullBody_(fullBody), device_(device) {
+  if (ownsDevice()) {
+    addLimbs(device_, fullBody_->GetLimbs(), effectors_, joints_);
+    addLimbs(device_, fullBody_->GetNonContactingLimbs(), effectors_, joints_);
+    projectorCache_ = projection::ProjectorCache::create();
+  }
+}
+
+bool KinematicContext::ownsDevice() const { return device_ != fullBody_->device_; }
+
+void KinematicContext::setConfiguration(pinocchio::ConfigurationIn_t configuration) {
+  device_->currentConfiguration(configuration);
+  device_->computeForwardKinematics();
+}
+
+pinocchio::JointPtr_t KinematicContext::joint(const pinocchio::JointPtr_t& joint) const {
+  if (!ownsDevice()) return joint;
+  std::map<std::string, pinocchio::JointPtr_t>::const_iterator cit = joints_.find(joint->name());
+  if (cit == joints_.end()) return device_->getJointByName(joint->name());
+  return cit->second;
+}
+
+pinocchio::Frame KinematicContext::effector(const RbPrmLimbPtr_t& limb) const {
+  if (!ownsDevice()) return limb->effector_;
+  std::map<std::string, pinocchio::Frame>::const_iterator cit = effectors_.find(limb->effector_.name());
+  // limbs added to the full body after the creation of the context are not indexed
+  if (cit == effectors_.end()) return device_->getFrameByName(limb->effector_.name());
+  return cit->second;
+}
+
+pinocchio::Transform3f KinematicContext::effectorTransformation(const RbPrmLimbPtr_t& limb) const {
+  return effector(limb).currentTransformation();
+}
+
+fcl::Vec3f KinematicContext::positionCenterOfMass() const { return device_->positionCenterOfMass(); }
+
+const projection::ProjectorCachePtr_t& KinematicContext::projectorCache() const {
+  if (!ownsDevice()) return fullBody_->projectorCache();
+  return projectorCache_;
+}
+
+T_KinematicContext createKinematicContexts(const RbPrmFullBodyPtr_t& fullBody, const std::size_t nbContexts) {
+  if (fullBody->device_->numberDeviceData() < (size_type)nbContexts)
+    fullBody->device_->numberDeviceData((size_type)nbContexts);
+  T_KinematicContext res;
+  for (std::size_t i = 0; i < nbContexts; ++i) res.push_back(KinematicContext::create(fullBody));
+  return res;
+}
+
+}  // namespace rbprm
+}  // namespace hpp
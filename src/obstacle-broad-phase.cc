@@ -0,0 +1,206 @@
+// Copyright (c) 2026, LAAS-CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-rbprm. If not, see <http://www.gnu.org/licenses/>.
+
+#include <hpp/rbprm/obstacle-broad-phase.hh>
+#include <hpp/core/collision-validation-report.hh>
+#include <hpp/pinocchio/collision-object.hh>
+#include <hpp/pinocchio/device-sync.hh>
+#include <hpp/fcl/collision.h>
+
+#include <algorithm>
+#include <map>
+
+namespace hpp {
+namespace rbprm {
+
+using core::CollisionObjectConstPtr_t;
+using core::value_type;
+
+namespace {
+// nodes with at most leafSize obstacles are not split
+const std::size_t leafSize = 4;
+// index of the children of a leaf
+const std::size_t noChild = (std::size_t)-1;
+
+// bounding box of an obstacle, from the bounding box of its geometry in its local frame
+hpp::fcl::AABB obstacleBox(const CollisionObjectConstPtr_t& obstacle) {
+  pinocchio::FclConstCollisionObjectPtr_t object = obstacle->fcl();
+  const hpp::fcl::AABB& local = object->collisionGeometry()->aabb_local;
+  const hpp::fcl::Transform3f& transform = object->getTransform();
+  hpp::fcl::AABB res(transform.transform(local.min_));
+  for (int i = 1; i < 8; ++i) {
+    const hpp::fcl::Vec3f corner((i & 1) ? local.max_[0] : local.min_[0], (i & 2) ? local.max_[1] : local.min_[1],
+                                 (i & 4) ? local.max_[2] : local.min_[2]);
+    res += transform.transform(corner);
+  }
+  return res;
+}
+
+// bounding box of a body, from the bounding sphere of its geometry
+hpp::fcl::AABB bodyBox(pinocchio::FclConstCollisionObjectPtr_t body, const value_type margin) {
+  const hpp::fcl::CollisionGeometry& geometry = *body->collisionGeometry();
+  const hpp::fcl::Vec3f center = body->getTransform().transform(geometry.aabb_center);
+  const hpp::fcl::Vec3f radius = hpp::fcl::Vec3f::Constant(geometry.aabb_radius + margin);
+  return hpp::fcl::AABB(center - radius, center + radius);
+}
+
+struct CompareCenter {
+  CompareCenter(const int axis) : axis_(axis) {}
+  template <typename Entry>
+  bool operator()(const Entry& a, const Entry& b) const {
+    return a.box_.min_[axis_] + a.box_.max_[axis_] < b.box_.min_[axis_] + b.box_.max_[axis_];
+  }
+  const int axis_;
+};
+}  // namespace
+
+ObstacleBroadPhasePtr_t ObstacleBroadPhase::create() { return ObstacleBroadPhasePtr_t(new ObstacleBroadPhase()); }
+
+ObstacleBroadPhase::ObstacleBroadPhase() : built_(true) {}
+
+void ObstacleBroadPhase::addObstacle(const CollisionObjectConstPtr_t& obstacle) {
+  std::vector<const pinocchio::CollisionObject*>::iterator it =
+      std::lower_bound(obstacles_.begin(), obstacles_.end(), obstacle.get());
+  if (it != obstacles_.end() && *it == obstacle.get()) return;
+  obstacles_.insert(it, obstacle.get());
+  Entry entry;
+  entry.obstacle_ = obstacle;
+  entry.box_ = obstacleBox(obstacle);
+  entries_.push_back(entry);
+  built_ = false;
+}
+
+void ObstacleBroadPhase::addObstacles(const core::CollisionValidation& validation) {
+  const core::CollisionPairs_t& pairs = validation.pairs();
+  for (core::CollisionPairs_t::const_iterator cit = pairs.begin(); cit != pairs.end(); ++cit)
+    addObstacle(cit->second);
+}
+
+void ObstacleBroadPhase::clear() {
+  entries_.clear();
+  obstacles_.clear();
+  nodes_.clear();
+  built_ = true;
+}
+
+void ObstacleBroadPhase::build() {
+  if (built_) return;
+  nodes_.clear();
+  if (!entries_.empty()) buildNode(0, entries_.size());
+  built_ = true;
+}
+
+std::size_t ObstacleBroadPhase::buildNode(const std::size_t begin, const std::size_t end) {
+  const std::size_t index = nodes_.size();
+  nodes_.push_back(Node());
+  hpp::fcl::AABB box(entries_[begin].box_);
+  for (std::size_t i = begin + 1; i < end; ++i) box += entries_[i].box_;
+  nodes_[index].box_ = box;
+  nodes_[index].begin_ = begin;
+  nodes_[index].end_ = end;
+  nodes_[index].left_ = noChild;
+  nodes_[index].right_ = noChild;
+  if (end - begin <= leafSize) return index;
+  // median split along the largest dimension of the box
+  int axis = 0;
+  for (int i = 1; i < 3; ++i)
+    if (box.max_[i] - box.min_[i] > box.max_[axis] - box.min_[axis]) axis = i;
+  const std::size_t mid = begin + (end - begin) / 2;
+  std::nth_element(entries_.begin() + begin, entries_.begin() + mid, entries_.begin() + end, CompareCenter(axis));
+  // nodes_ may be reallocated by the recursive calls
+  const std::size_t left = buildNode(begin, mid);
+  const std::size_t right = buildNode(mid, end);
+  nodes_[index].left_ = left;
+  nodes_[index].right_ = right;
+  return index;
+}
+
+void ObstacleBroadPhase::query(const hpp::fcl::AABB& box, std::vector<const pinocchio::CollisionObject*>& obstacles) {
+  build();
+  if (nodes_.empty()) return;
+  std::vector<std::size_t> stack(1, 0);
+  while (!stack.empty()) {
+    const Node& node = nodes_[stack.back()];
+    stack.pop_back();
+    if (!node.box_.overlap(box)) continue;
+    if (node.left_ == noChild) {
+      for (std::size_t i = node.begin_; i < node.end_; ++i)
+        if (entries_[i].box_.overlap(box)) obstacles.push_back(entries_[i].obstacle_.get());
+    } else {
+      stack.push_back(node.left_);
+      stack.push_back(node.right_);
+    }
+  }
+}
+
+bool ObstacleBroadPhase::validate(const pinocchio::DevicePtr_t& robot, core::CollisionValidation& validation,
+                                  const core::Configuration_t& config, const bool computeAllContacts,
+                                  core::ValidationReportPtr_t& validationReport) {
+  build();
+  pinocchio::DeviceSync device(robot);
+  device.currentConfiguration(config);
+  device.computeForwardKinematics(pinocchio::JOINT_POSITION);
+  device.updateGeometryPlacements();
+  const core::CollisionPairs_t& pairs = validation.pairs();
+  const core::CollisionRequests_t& requests = validation.requests();
+  // the bounding boxes of the bodies are inflated by the largest security margin
+  value_type margin = 0.;
+  for (core::CollisionRequests_t::const_iterator cit = requests.begin(); cit != requests.end(); ++cit)
+    margin = std::max(margin, (value_type)cit->security_margin);
+  // obstacles near each body, sorted to be searched, queried once per body
+  std::map<const pinocchio::CollisionObject*, std::vector<const pinocchio::CollisionObject*> > nearObstacles;
+  core::AllCollisionsValidationReportPtr_t allReport;
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    const CollisionObjectConstPtr_t& body = pairs[i].first;
+    const CollisionObjectConstPtr_t& obstacle = pairs[i].second;
+    std::map<const pinocchio::CollisionObject*, std::vector<const pinocchio::CollisionObject*> >::iterator it =
+        nearObstacles.find(body.get());
+    if (it == nearObstacles.end()) {
+      it = nearObstacles.insert(std::make_pair(body.get(), std::vector<const pinocchio::CollisionObject*>())).first;
+      query(bodyBox(body->fcl(device.d()), margin), it->second);
+      std::sort(it->second.begin(), it->second.end());
+    }
+    if (!std::binary_search(it->second.begin(), it->second.end(), obstacle.get()) &&
+        std::binary_search(obstacles_.begin(), obstacles_.end(), obstacle.get()))
+      continue;
+    hpp::fcl::CollisionResult result;
+    if (hpp::fcl::collide(body->fcl(device.d()), obstacle->fcl(device.d()), requests[i], result) == 0) continue;
+    core::CollisionValidationReportPtr_t report(new core::CollisionValidationReport);
+    report->object1 = body;
+    report->object2 = obstacle;
+    report->result = result;
+    if (!computeAllContacts) {
+      validationReport = report;
+      return false;
+    }
+    // as core::CollisionValidation, the first collision is also the one of the report
+    if (!allReport) {
+      allReport.reset(new core::AllCollisionsValidationReport);
+      allReport->object1 = body;
+      allReport->object2 = obstacle;
+      allReport->result = result;
+    }
+    allReport->collisionReports.push_back(report);
+  }
+  if (allReport) {
+    validationReport = allReport;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace rbprm
+}  // namespace hpp
@@ -45,6 +45,7 @@
 #include <hpp/core/path-validation-report.hh>
 #include <hpp/rbprm/rbprm-path-validation.hh>
 #include <hpp/rbprm/rbprm-device.hh>
+#include <exception>
 
 namespace hpp {
 namespace rbprm {
@@ -68,6 +69,30 @@ typedef centroidal_dynamics::Matrix63 Matrix63;
 typedef centroidal_dynamics::Vector6 Vector6;
 typedef centroidal_dynamics::VectorX VectorX;
 
+namespace {
+core::RoadmapPtr_t createRoadmap(core::ProblemConstPtr_t problem) {
+  // with the kinodynamic distance, the nodes are indexed by the position and velocity of the root
+  if (std::dynamic_pointer_cast<core::KinodynamicDistance>(problem->distance()) &&
+      problem->robot()->extraConfigSpace().dimension() >= 6) {
+    const value_type vMax = problem->getParameter(std::string("Kinodynamic/velocityBound")).floatValue();
+    const value_type aMax = problem->getParameter(std::string("Kinodynamic/accelerationBound")).floatValue();
+    return core::RbprmRoadmap::create(problem->distance(), problem->robot(), vMax, aMax);
+  }
+  return core::RbprmRoadmap::create(problem->distance(), problem->robot());
+}
+
+// projects target before steering from near to it, returns false if the constraints can not be applied
+bool projectTarget(const core::ConstraintSetPtr_t& constraints, const core::NodePtr_t& near,
+                   const core::ConfigurationPtr_t& target, core::Configuration_t& qProj) {
+  core::ConfigProjectorPtr_t configProjector(constraints->configProjector());
+  if (configProjector)
+    configProjector->projectOnKernel(*(near->configuration()), *target, qProj);
+  else
+    qProj = *target;
+  return constraints->apply(qProj);
+}
+}  // namespace
+
 DynamicPlannerPtr_t DynamicPlanner::createWithRoadmap(core::ProblemConstPtr_t problem, const RoadmapPtr_t& roadmap) {
   DynamicPlanner* ptr = new DynamicPlanner(problem, roadmap);
   return DynamicPlannerPtr_t(ptr);
@@ -81,11 +106,11 @@ DynamicPlannerPtr_t DynamicPlanner::create(core::ProblemConstPtr_t problem) {
 DynamicPlanner::DynamicPlanner(core::ProblemConstPtr_t problem)
     : BiRRTPlanner(problem),
       qProj_(new core::Configuration_t(problem->robot()->configSize())),
-      roadmap_(
-          std::dynamic_pointer_cast<core::Roadmap>(core::RbprmRoadmap::create(problem->distance(), problem->robot()))),
+      roadmap_(createRoadmap(problem)),
       sm_(std::dynamic_pointer_cast<SteeringMethodKinodynamic>(problem->steeringMethod())),
       smParabola_(rbprm::SteeringMethodParabola::create(problem)),
-      rbprmPathValidation_(std::dynamic_pointer_cast<RbPrmPathValidation>(problem->pathValidation())) {
+      rbprmPathValidation_(std::dynamic_pointer_cast<RbPrmPathValidation>(problem->pathValidation())),
+      contactSurfaces_(core::ContactSurfaceCache::create()) {
   assert(sm_ && "steering method should be a kinodynamic steering method for this solver");
   assert(rbprmPathValidation_ && "Path validation should be a RbPrmPathValidation class for this solver");
   assert(problem->robot()->mass() > 0. && "When using dynamic planner, the robot mass should be correctly defined.");
@@ -107,11 +132,11 @@ DynamicPlanner::DynamicPlanner(core::ProblemConstPtr_t problem)
 DynamicPlanner::DynamicPlanner(core::ProblemConstPtr_t problem, const RoadmapPtr_t& roadmap)
     : BiRRTPlanner(problem, roadmap),
       qProj_(new core::Configuration_t(problem->robot()->configSize())),
-      roadmap_(
-          std::dynamic_pointer_cast<core::Roadmap>(core::RbprmRoadmap::create(problem->distance(), problem->robot()))),
+      roadmap_(createRoadmap(problem)),
       sm_(std::dynamic_pointer_cast<SteeringMethodKinodynamic>(problem->steeringMethod())),
       smParabola_(rbprm::SteeringMethodParabola::create(problem)),
-      rbprmPathValidation_(std::dynamic_pointer_cast<RbPrmPathValidation>(problem->pathValidation())) {
+      rbprmPathValidation_(std::dynamic_pointer_cast<RbPrmPathValidation>(problem->pathValidation())),
+      contactSurfaces_(core::ContactSurfaceCache::create()) {
   assert(sm_ && "steering method should be a kinodynamic steering method for this solver");
   assert(rbprmPathValidation_ && "Path validation should be a RbPrmPathValidation class for this solver");
   assert(problem->robot()->mass() > 0. && "When using dynamic planner, the robot mass should be correctly defined.");
@@ -135,24 +160,39 @@ void DynamicPlanner::init(const DynamicPlannerWkPtr_t& weak) {
   weakPtr_ = weak;
 }
 
+void DynamicPlanner::addWorker(const core::PathValidationPtr_t& pathValidation) {
+  Worker worker;
+  worker.sm_ = std::dynamic_pointer_cast<SteeringMethodKinodynamic>(sm_->copy());
+  worker.pathValidation_ = pathValidation;
+  worker.qProj_ = core::ConfigurationPtr_t(new core::Configuration_t(problem()->robot()->configSize()));
+  workers_.push_back(worker);
+  // the collision validations of the workers are computed on the data of the robot and of its ROMs
+  const size_type nbData = (size_type)workers_.size();
+  const pinocchio::DevicePtr_t& robot = problem()->robot();
+  if (robot->numberDeviceData() < nbData) robot->numberDeviceData(nbData);
+  pinocchio::RbPrmDevicePtr_t rbprmDevice = std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(robot);
+  if (rbprmDevice) {
+    for (std::map<std::string, pinocchio::DevicePtr_t>::const_iterator cit = rbprmDevice->robotRoms_.begin();
+         cit != rbprmDevice->robotRoms_.end(); ++cit) {
+      if (cit->second->numberDeviceData() < nbData) cit->second->numberDeviceData(nbData);
+    }
+  }
+}
+
 core::PathPtr_t DynamicPlanner::extendInternal(core::ConfigurationPtr_t& qProj_, const core::NodePtr_t& near,
                                                const core::ConfigurationPtr_t& target, bool reverse) {
-  const core::ConstraintSetPtr_t& constraints(sm_->constraints());
-  if (constraints) {
-    core::ConfigProjectorPtr_t configProjector(constraints->configProjector());
-    if (configProjector) {
-      configProjector->projectOnKernel(*(near->configuration()), *target, *qProj_);
-    } else {
-      *qProj_ = *target;
-    }
+  return extendInternal(sm_, qProj_, near, target, reverse);
+}
 
-    if (constraints->apply(*qProj_)) {
-      return reverse ? (*sm_)(*qProj_, near) : (*sm_)(near, *qProj_);
-    } else {
-      return PathPtr_t();
-    }
+core::PathPtr_t DynamicPlanner::extendInternal(const SteeringMethodKinodynamicPtr_t& sm,
+                                               core::ConfigurationPtr_t& qProj_, const core::NodePtr_t& near,
+                                               const core::ConfigurationPtr_t& target, bool reverse) {
+  const core::ConstraintSetPtr_t& constraints(sm->constraints());
+  if (constraints) {
+    if (!projectTarget(constraints, near, target, *qProj_)) return PathPtr_t();
+    return reverse ? (*sm)(*qProj_, near) : (*sm)(near, *qProj_);
   }
-  return reverse ? (*sm_)(*target, near) : (*sm_)(near, *target);
+  return reverse ? (*sm)(*target, near) : (*sm)(near, *target);
 }
 
 core::PathPtr_t DynamicPlanner::extendParabola(const core::ConfigurationPtr_t& from,
@@ -257,6 +297,10 @@ bool DynamicPlanner::tryParabolaPath(const core::NodePtr_t& x_near, core::Config
 }
 
 void DynamicPlanner::oneStep() {
+  if (!workers_.empty()) {
+    oneStepParallel();
+    return;
+  }
   hppDout(info, "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ new Step ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~");
   PathPtr_t validPath, path;
   core::PathValidationPtr_t pathValidation(problem()->pathValidation());
@@ -360,6 +404,115 @@ void DynamicPlanner::oneStep() {
   }
 }
 
+void DynamicPlanner::oneStepParallel() {
+  hppDout(info, "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ new parallel Step ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~");
+  const std::size_t nbWorkers = workers_.size();
+  // the configuration shooter is not thread safe
+  hppStartBenchmark(SHOOT);
+  std::vector<ConfigurationPtr_t> q_rands(nbWorkers);
+  for (std::size_t i = 0; i < nbWorkers; ++i) q_rands[i] = configurationShooter_->shoot();
+  hppStopBenchmark(SHOOT);
+  hppDisplayBenchmark(SHOOT);
+
+  // the roadmap is only read while the workers extend it
+  std::vector<T_Extension> extensions(nbWorkers, T_Extension(1 + endComponents_.size()));
+  std::vector<std::exception_ptr> errors(nbWorkers);
+  hppStartBenchmark(EXTEND);
+#pragma omp parallel for num_threads((int)nbWorkers) schedule(static, 1)
+  for (int i = 0; i < (int)nbWorkers; ++i) {
+    try {
+      extend(workers_[i], q_rands[i], extensions[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  hppStopBenchmark(EXTEND);
+  hppDisplayBenchmark(EXTEND);
+  for (std::size_t i = 0; i < nbWorkers; ++i)
+    if (errors[i]) std::rethrow_exception(errors[i]);
+
+  // nodes, edges and their GIWC are added sequentially, in the order of the workers
+  for (std::size_t i = 0; i < nbWorkers; ++i) {
+    if (addExtensions(q_rands[i], extensions[i])) return;
+  }
+}
+
+void DynamicPlanner::extend(Worker& worker, const core::ConfigurationPtr_t& q_rand, T_Extension& extensions) {
+  value_type distance;
+  for (std::size_t i = 0; i < extensions.size(); ++i) {
+    Extension& extension = extensions[i];
+    const bool reverse = i > 0;
+    if (reverse)
+      extension.near_ = roadmap()->nearestNode(q_rand, endComponents_[i - 1], distance, true);
+    else
+      extension.near_ = roadmap()->nearestNode(q_rand, startComponent_, distance);
+    extension.path_ = extendInternal(worker.sm_, worker.qProj_, extension.near_, q_rand, reverse);
+    if (extension.path_) {
+      core::PathValidationReportPtr_t report;
+      extension.valid_ = worker.pathValidation_->validate(extension.path_, reverse, extension.validPath_, report);
+    }
+  }
+}
+
+bool DynamicPlanner::addExtensions(const core::ConfigurationPtr_t& q_rand, const T_Extension& extensions) {
+  PathPtr_t validPath, path;
+  core::PathValidationPtr_t pathValidation(problem()->pathValidation());
+  core::NodePtr_t reachedNodeFromStart;
+  bool startComponentConnected(false), pathValidFromStart(false), pathValidFromEnd(false);
+  ConfigurationPtr_t q_new;
+
+  const Extension& fromStart = extensions[0];
+  if (fromStart.path_ && fromStart.validPath_) {
+    pathValidFromStart = fromStart.valid_;
+    validPath = fromStart.validPath_;
+    if (validPath->timeRange().second != fromStart.path_->timeRange().first) {
+      pathValidFromStart = pathValidFromStart && (validPath->end() == *q_rand);
+      startComponentConnected = true;
+      q_new = ConfigurationPtr_t(new Configuration_t(validPath->end()));
+      reachedNodeFromStart = roadmap()->addNodeAndEdge(fromStart.near_, q_new, validPath);
+      computeGIWC(reachedNodeFromStart);
+      hppDout(info, "~~~~~~~~~~~~~~~~~~~~ New node added to start component : " << displayConfig(*q_new));
+    } else {
+      pathValidFromStart = false;
+    }
+  }
+
+  for (std::size_t i = 1; i < extensions.size(); ++i) {
+    const Extension& fromEnd = extensions[i];
+    if (!fromEnd.path_) continue;
+    validPath = fromEnd.validPath_;
+    pathValidFromEnd = fromEnd.valid_;
+    if (pathValidFromStart && validPath) {
+      pathValidFromEnd = pathValidFromEnd && (validPath->initial() == *q_new);
+    }
+    if (pathValidFromStart && pathValidFromEnd) {  // qrand was successfully connected to both trees
+      roadmap()->addEdge(reachedNodeFromStart, fromEnd.near_, validPath);
+      hppDout(info, "~~~~~~~~~~~~~~~~~~~~ Start and goal component connected !!!!!! " << displayConfig(*q_new));
+      return true;
+    } else if (validPath) {
+      if (validPath->timeRange().second != fromEnd.path_->timeRange().first) {
+        ConfigurationPtr_t q_newEnd = ConfigurationPtr_t(new Configuration_t(validPath->initial()));
+        core::NodePtr_t newNode = roadmap()->addNodeAndEdge(q_newEnd, fromEnd.near_, validPath);
+        computeGIWC(newNode);
+        hppDout(info, "~~~~~~~~~~~~~~~~~~~~~~ New node added to end component : " << displayConfig(*q_newEnd));
+
+        if (startComponentConnected) {  // now try to connect both nodes (qnew -> qnewEnd)
+          core::PathValidationReportPtr_t report;
+          path = extendInternal(qProj_, reachedNodeFromStart, q_newEnd, false);
+          if (path && pathValidation->validate(path, false, validPath, report)) {
+            if (validPath->end() == *q_newEnd) {
+              roadmap()->addEdge(reachedNodeFromStart, newNode, path);
+              hppDout(info, "~~~~~~~~ both new nodes connected together !!!!!! " << displayConfig(*q_new));
+              return true;
+            }
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
 void DynamicPlanner::computeGIWC(const core::NodePtr_t x, bool use_bestReport) {
   core::ValidationReportPtr_t report;
   // randomnize the collision pair, in order to get a different surface of contact each time
@@ -373,7 +526,8 @@ void DynamicPlanner::computeGIWC(const core::NodePtr_t x, bool use_bestReport) {
   rbprmPathValidation_->getValidator()->computeAllContacts(false);
   if (use_bestReport) {
     core::RbprmNodePtr_t node = static_cast<core::RbprmNodePtr_t>(x);
-    node->chooseBestContactSurface(report, std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()));
+    node->chooseBestContactSurface(report, std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()),
+                                   contactSurfaces_);
   }
   computeGIWC(x, report);
 }
@@ -392,7 +546,9 @@ void DynamicPlanner::computeGIWC(const core::NodePtr_t xNode, core::ValidationRe
 
   hppDout(info, "~~ q = " << displayConfig(*q));
   node->fillNodeMatrices(report, rectangularContact_, sizeFootX_, sizeFootY_, problem()->robot()->mass(), mu_,
-                         std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()));
+                         std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()), contactSurfaces_);
+  // the nodes of the roadmap are steered from many times, the admissible accelerations are computed once
+  node->computeAccelerationPolytope();
 }  // computeGIWC
 
 // re implement virtual method, same as base class but without the symetric edge (goal -> start)
@@ -404,17 +560,30 @@ void DynamicPlanner::tryConnectInitAndGoals() {
   core::NodePtr_t initNode = roadmap()->initNode();
   core::NodePtr_t x_jump;
   computeGIWC(initNode, true);
-  for (core::NodeVector_t::const_iterator itn = roadmap()->goalNodes().begin(); itn != roadmap()->goalNodes().end();
-       ++itn) {
-    computeGIWC(*itn, true);
-    core::ConfigurationPtr_t q1((initNode)->configuration());
-    core::ConfigurationPtr_t q2((*itn)->configuration());
-    assert(*q1 != *q2);
-    hppStartBenchmark(EXTEND);
-    path = extendInternal(qProj_, initNode, q2);
-    hppStopBenchmark(EXTEND);
-    hppDisplayBenchmark(EXTEND);
-    hppDout(notice, "try direction path, after extendInternal");
+  // the goals are steered to from the init node in one batch, projected as in extendInternal
+  const core::NodeVector_t goals(roadmap()->goalNodes());
+  const core::ConstraintSetPtr_t& constraints(sm_->constraints());
+  std::vector<core::ConfigurationPtr_t> targets(goals.size());
+  for (std::size_t i = 0; i < goals.size(); ++i) {
+    computeGIWC(goals[i], true);
+    core::ConfigurationPtr_t q2(goals[i]->configuration());
+    assert(*(initNode->configuration()) != *q2);
+    if (!constraints) {
+      targets[i] = q2;
+      continue;
+    }
+    core::ConfigurationPtr_t qProj(new core::Configuration_t(q2->size()));
+    if (projectTarget(constraints, initNode, q2, *qProj)) targets[i] = qProj;
+  }
+  hppStartBenchmark(EXTEND);
+  const std::vector<core::PathPtr_t> paths = (*sm_)(initNode, targets);
+  hppStopBenchmark(EXTEND);
+  hppDisplayBenchmark(EXTEND);
+  for (std::size_t i = 0; i < goals.size(); ++i) {
+    const core::NodePtr_t& goal(goals[i]);
+    core::ConfigurationPtr_t q2(goal->configuration());
+    path = paths[i];
+    hppDout(notice, "try direction path, after steering");
     if (!path) continue;
     hppDout(notice, "try direction path, after continue");
 
@@ -425,17 +594,17 @@ void DynamicPlanner::tryConnectInitAndGoals() {
     }
     if (projPath) {
       core::PathValidationReportPtr_t report;
-      // roadmap ()->addEdge (initNode, *itn, projPath);  // (TODO a supprimer)display the path no matter if it's
+      // roadmap ()->addEdge (initNode, goal, projPath);  // (TODO a supprimer)display the path no matter if it's
       // successful or not
 
       bool pathValid = pathValidation->validate(projPath, false, validPath, report);
 
-      // roadmap ()->addEdge (initNode, *itn, validPath);  // (TODO a supprimer)display the path no matter if it's
+      // roadmap ()->addEdge (initNode, goal, validPath);  // (TODO a supprimer)display the path no matter if it's
       // successful or not
 
       if (pathValid && validPath->timeRange().second !=
                            path->timeRange().first) {  // connection to goal config successfull, add the edge
-        roadmap()->addEdge(initNode, *itn, projPath);
+        roadmap()->addEdge(initNode, goal, projPath);
       } else if (validPath) {
         if (tryJump_) {
           std::vector<std::string> filter;
@@ -453,7 +622,7 @@ void DynamicPlanner::tryConnectInitAndGoals() {
             hppDout(notice, "parabola success = " << parabolaSuccess);
             if (parabolaSuccess) {
               hppDout(notice, "x_goal conf = " << displayConfig(*(x_goal->configuration())));
-              roadmap()->addEdge(x_jump, *itn, paraPath);
+              roadmap()->addEdge(x_jump, goal, paraPath);
             }
           } else {
             hppDout(notice, "trunk in collision");
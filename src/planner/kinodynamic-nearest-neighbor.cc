@@ -0,0 +1,262 @@
+// Copyright (c) 2026, LAAS-CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-rbprm. If not, see <http://www.gnu.org/licenses/>.
+
+#include <hpp/rbprm/planner/kinodynamic-nearest-neighbor.hh>
+#include <hpp/core/node.hh>
+#include <hpp/core/connected-component.hh>
+#include <hpp/core/roadmap.hh>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace hpp {
+namespace rbprm {
+
+using core::ConfigurationIn_t;
+using core::value_type;
+
+namespace {
+// ranges of at most leafSize entries are not split
+const std::size_t leafSize = 8;
+
+bool closer(const std::pair<value_type, core::NodePtr_t>& a, const std::pair<value_type, core::NodePtr_t>& b) {
+  return a.first < b.first;
+}
+
+struct CompareDimension {
+  CompareDimension(const unsigned char dimension) : dimension_(dimension) {}
+  bool operator()(const KinodynamicNearestNeighbor::Entry& a, const KinodynamicNearestNeighbor::Entry& b) const {
+    return a.key_[dimension_] < b.key_[dimension_];
+  }
+  const unsigned char dimension_;
+};
+}  // namespace
+
+// K nearest nodes found so far, kept in a max heap on their distance to the query
+struct KinodynamicNearestNeighbor::Query {
+  Query(const core::DistancePtr_t& distance, ConfigurationIn_t configuration, const Key& key, const Key& weights,
+        const core::ConnectedComponentPtr_t& connectedComponent, const std::size_t K, const value_type maxDistance,
+        const bool reverse)
+      : distance_(distance),
+        configuration_(configuration),
+        key_(key),
+        weights_(weights),
+        connectedComponent_(connectedComponent),
+        K_(K),
+        maxDistance_(maxDistance),
+        reverse_(reverse) {}
+
+  value_type bound() const { return nodes_.size() < K_ ? maxDistance_ : nodes_.front().first; }
+
+  value_type lowerBound(const Key& key) const { return (key - key_).cwiseAbs().cwiseProduct(weights_).maxCoeff(); }
+
+  void test(const Entry& entry) {
+    if (connectedComponent_ && entry.node_->connectedComponent() != connectedComponent_) return;
+    if (lowerBound(entry.key_) >= bound()) return;
+    const value_type d = reverse_ ? (*distance_)(configuration_, *(entry.node_->configuration()))
+                                  : (*distance_)(*(entry.node_->configuration()), configuration_);
+    if (d >= bound()) return;
+    if (nodes_.size() == K_) {
+      std::pop_heap(nodes_.begin(), nodes_.end(), closer);
+      nodes_.pop_back();
+    }
+    nodes_.push_back(std::make_pair(d, entry.node_));
+    std::push_heap(nodes_.begin(), nodes_.end(), closer);
+  }
+
+  const core::DistancePtr_t distance_;
+  const core::Configuration_t configuration_;
+  const Key key_;
+  const Key weights_;
+  const core::ConnectedComponentPtr_t connectedComponent_;
+  const std::size_t K_;
+  const value_type maxDistance_;
+  const bool reverse_;
+  std::vector<std::pair<value_type, core::NodePtr_t> > nodes_;
+};
+
+KinodynamicNearestNeighborPtr_t KinodynamicNearestNeighbor::create(const core::DistancePtr_t& distance,
+                                                                   const pinocchio::DevicePtr_t& robot,
+                                                                   const value_type vMax, const value_type aMax) {
+  return KinodynamicNearestNeighborPtr_t(new KinodynamicNearestNeighbor(distance, robot, vMax, aMax));
+}
+
+KinodynamicNearestNeighbor::KinodynamicNearestNeighbor(const core::DistancePtr_t& distance,
+                                                       const pinocchio::DevicePtr_t& robot, const value_type vMax,
+                                                       const value_type aMax)
+    : distance_(distance),
+      velocityIndex_(robot->configSize() - robot->extraConfigSpace().dimension()),
+      vMax_(vMax),
+      aMax_(aMax),
+      size_(0),
+      maxVelocity_(0.) {
+  if (robot->extraConfigSpace().dimension() < 3)
+    throw std::runtime_error("KinodynamicNearestNeighbor requires the velocity of the root in the extra config space");
+}
+
+KinodynamicNearestNeighbor::Key KinodynamicNearestNeighbor::key(ConfigurationIn_t configuration) const {
+  Key res;
+  res.head<3>() = configuration.head<3>();
+  res.tail<3>() = configuration.segment<3>(velocityIndex_);
+  return res;
+}
+
+KinodynamicNearestNeighbor::Key KinodynamicNearestNeighbor::weights(const Key& queryKey) const {
+  // the nodes and the query may exceed the velocity bound, the position of the root can not move faster
+  // than the largest of these velocities
+  const value_type vMax = std::max(std::max(vMax_, maxVelocity_), queryKey.tail<3>().cwiseAbs().maxCoeff());
+  Key res;
+  res.head<3>().setConstant(vMax > 0. ? 1. / vMax : 0.);
+  res.tail<3>().setConstant(aMax_ > 0. ? 1. / aMax_ : 0.);
+  return res;
+}
+
+void KinodynamicNearestNeighbor::clear() {
+  trees_.clear();
+  size_ = 0;
+  maxVelocity_ = 0.;
+}
+
+void KinodynamicNearestNeighbor::addNode(const core::NodePtr_t& node) {
+  Tree tree;
+  Entry entry;
+  entry.key_ = key(*(node->configuration()));
+  entry.node_ = node;
+  tree.entries_.push_back(entry);
+  // as a binary counter, the new node and the trees of 1, 2, 4 ... nodes are merged until an empty slot is found
+  std::size_t i = 0;
+  for (; i < trees_.size() && !trees_[i].entries_.empty(); ++i) {
+    tree.entries_.insert(tree.entries_.end(), trees_[i].entries_.begin(), trees_[i].entries_.end());
+    trees_[i] = Tree();
+  }
+  if (i == trees_.size()) trees_.push_back(Tree());
+  tree.dimensions_.resize(tree.entries_.size(), 0);
+  build(tree, 0, tree.entries_.size());
+  std::swap(trees_[i], tree);
+  ++size_;
+  maxVelocity_ = std::max(maxVelocity_, entry.key_.tail<3>().cwiseAbs().maxCoeff());
+}
+
+void KinodynamicNearestNeighbor::build(Tree& tree, const std::size_t begin, const std::size_t end) {
+  if (end - begin <= leafSize) return;
+  // split along the dimension of largest extent, scaled as in the lower bound of the distance
+  Key lower(tree.entries_[begin].key_), upper(tree.entries_[begin].key_);
+  for (std::size_t i = begin + 1; i < end; ++i) {
+    lower = lower.cwiseMin(tree.entries_[i].key_);
+    upper = upper.cwiseMax(tree.entries_[i].key_);
+  }
+  Key extent = upper - lower;
+  if (vMax_ > 0.) extent.head<3>() /= vMax_;
+  if (aMax_ > 0.) extent.tail<3>() /= aMax_;
+  Key::Index dimension;
+  extent.maxCoeff(&dimension);
+  const std::size_t mid = begin + (end - begin) / 2;
+  std::nth_element(tree.entries_.begin() + begin, tree.entries_.begin() + mid, tree.entries_.begin() + end,
+                   CompareDimension((unsigned char)dimension));
+  tree.dimensions_[mid] = (unsigned char)dimension;
+  build(tree, begin, mid);
+  build(tree, mid + 1, end);
+}
+
+void KinodynamicNearestNeighbor::search(const Tree& tree, const std::size_t begin, const std::size_t end,
+                                        const value_type lowerBound, Query& query) const {
+  if (begin >= end || lowerBound >= query.bound()) return;
+  if (end - begin <= leafSize) {
+    for (std::size_t i = begin; i < end; ++i) query.test(tree.entries_[i]);
+    return;
+  }
+  const std::size_t mid = begin + (end - begin) / 2;
+  const unsigned char dimension = tree.dimensions_[mid];
+  const value_type diff = query.key_[dimension] - tree.entries_[mid].key_[dimension];
+  const value_type farBound = std::max(lowerBound, std::abs(diff) * query.weights_[dimension]);
+  query.test(tree.entries_[mid]);
+  if (diff < 0) {
+    search(tree, begin, mid, lowerBound, query);
+    search(tree, mid + 1, end, farBound, query);
+  } else {
+    search(tree, mid + 1, end, lowerBound, query);
+    search(tree, begin, mid, farBound, query);
+  }
+}
+
+void KinodynamicNearestNeighbor::search(Query& query) const {
+  for (std::vector<Tree>::const_iterator cit = trees_.begin(); cit != trees_.end(); ++cit)
+    search(*cit, 0, cit->entries_.size(), 0., query);
+  std::sort_heap(query.nodes_.begin(), query.nodes_.end(), closer);
+}
+
+core::Nodes_t KinodynamicNearestNeighbor::KnearestSearch(ConfigurationIn_t configuration,
+                                                         const core::ConnectedComponentPtr_t& connectedComponent,
+                                                         const std::size_t K, value_type& distance, bool reverse) {
+  const Key queryKey = key(configuration);
+  Query query(distance_, configuration, queryKey, weights(queryKey), connectedComponent, K,
+              std::numeric_limits<value_type>::infinity(), reverse);
+  search(query);
+  core::Nodes_t res;
+  distance = std::numeric_limits<value_type>::infinity();
+  for (std::size_t i = 0; i < query.nodes_.size(); ++i) {
+    res.push_back(query.nodes_[i].second);
+    distance = query.nodes_[i].first;
+  }
+  return res;
+}
+
+core::NodePtr_t KinodynamicNearestNeighbor::search(ConfigurationIn_t configuration,
+                                                   const core::ConnectedComponentPtr_t& connectedComponent,
+                                                   value_type& distance, bool reverse) {
+  core::Nodes_t nodes = KnearestSearch(configuration, connectedComponent, 1, distance, reverse);
+  return nodes.empty() ? core::NodePtr_t() : nodes.front();
+}
+
+core::NodePtr_t KinodynamicNearestNeighbor::search(const core::NodePtr_t& node,
+                                                   const core::ConnectedComponentPtr_t& connectedComponent,
+                                                   value_type& distance) {
+  return search(*(node->configuration()), connectedComponent, distance, false);
+}
+
+core::Nodes_t KinodynamicNearestNeighbor::KnearestSearch(ConfigurationIn_t configuration,
+                                                         const core::ConnectedComponentPtr_t& connectedComponent,
+                                                         const std::size_t K, value_type& distance) {
+  return KnearestSearch(configuration, connectedComponent, K, distance, false);
+}
+
+core::Nodes_t KinodynamicNearestNeighbor::KnearestSearch(const core::NodePtr_t& node,
+                                                         const core::ConnectedComponentPtr_t& connectedComponent,
+                                                         const std::size_t K, value_type& distance) {
+  return KnearestSearch(*(node->configuration()), connectedComponent, K, distance, false);
+}
+
+core::Nodes_t KinodynamicNearestNeighbor::KnearestSearch(ConfigurationIn_t configuration,
+                                                         const core::RoadmapPtr_t& /*roadmap*/, const std::size_t K,
+                                                         value_type& distance) {
+  return KnearestSearch(configuration, core::ConnectedComponentPtr_t(), K, distance, false);
+}
+
+core::NodeVector_t KinodynamicNearestNeighbor::withinBall(ConfigurationIn_t configuration,
+                                                          const core::ConnectedComponentPtr_t& connectedComponent,
+                                                          value_type maxDistance) {
+  const Key queryKey = key(configuration);
+  Query query(distance_, configuration, queryKey, weights(queryKey), connectedComponent, size_ + 1, maxDistance,
+              false);
+  search(query);
+  core::NodeVector_t res;
+  for (std::size_t i = 0; i < query.nodes_.size(); ++i) res.push_back(query.nodes_[i].second);
+  return res;
+}
+
+}  // namespace rbprm
+}  // namespace hpp
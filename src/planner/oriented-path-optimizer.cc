@@ -79,7 +79,6 @@ PathVectorPtr_t OrientedPathOptimizer::optimize(const PathVectorPtr_t& path) {
   hppStartBenchmark(ORIENTED_OPTIMIZER);
   using std::make_pair;
   using std::numeric_limits;
-  PathPtr_t unusedValidPart;
   core::PathValidationReportPtr_t unusedReport;
   PathVectorPtr_t result = PathVector::create(path->outputSize(), path->outputDerivativeSize());
   const size_t numPaths = path->numberPaths();
@@ -97,7 +96,7 @@ PathVectorPtr_t OrientedPathOptimizer::optimize(const PathVectorPtr_t& path) {
       resultPaths[i] = castedPath;
       orientedPaths[i] = core::KinodynamicOrientedPath::create(castedPath, orientationIgnoreZValue_);
       if (orientedPaths[i]) {
-        orientedValid[i] = rbprmPathValidation_->validate(orientedPaths[i], false, unusedValidPart, unusedReport);
+        orientedValid[i] = rbprmPathValidation_->isValid(orientedPaths[i], unusedReport);
       }
     } else
       hppDout(error, "paths inside path vector could not be casted to kinodyamic paths");
@@ -149,7 +148,6 @@ bool OrientedPathOptimizer::checkReplaceOrientation(const size_t index, const si
                                                     std::vector<core::KinodynamicPathPtr_t> resultPaths) {
   KinodynamicPathPtr_t previousPath, nextPath;
   bool previousValid(false);
-  PathPtr_t unusedValidPart;
   core::PathValidationReportPtr_t unusedReport;
 
   if (!orientedValid[index]) return false;
@@ -161,7 +159,7 @@ bool OrientedPathOptimizer::checkReplaceOrientation(const size_t index, const si
       previousPath = KinodynamicPath::createCopy(resultPaths[index - 1]);
       if (previousPath) {
         previousPath->endConfig(orientedPaths[index]->initial());
-        previousValid = rbprmPathValidation_->validate(previousPath, false, unusedValidPart, unusedReport);
+        previousValid = rbprmPathValidation_->isValid(previousPath, unusedReport);
       }
     }
   } else {  // if first element of the pathvector : always valid
@@ -182,7 +180,7 @@ bool OrientedPathOptimizer::checkReplaceOrientation(const size_t index, const si
       nextPath = KinodynamicPath::createCopy(resultPaths[index + 1]);
       if (nextPath) {
         nextPath->initialConfig(orientedPaths[index]->end());
-        replaceValid[index] = rbprmPathValidation_->validate(nextPath, false, unusedValidPart, unusedReport);
+        replaceValid[index] = rbprmPathValidation_->isValid(nextPath, unusedReport);
       }
     }
   } else {  // if last element of the pathVector : always valid
@@ -31,6 +31,8 @@
 #include <hpp/core/path-validation.hh>
 #include <hpp/core/config-validations.hh>
 #include <hpp/util/timer.hh>
+#include <hpp/rbprm/rbprm-device.hh>
+#include <exception>
 
 namespace hpp {
 namespace rbprm {
@@ -48,6 +50,24 @@ using core::PathVectorPtr_t;
 using core::Problem;
 using pinocchio::value_type;
 
+namespace {
+// sample t[1] < t[2] in [t[0], t[3]], at least minBetweenPoint apart from each other and from the bounds
+void sampleParameters(value_type t[4], const value_type minBetweenPoint) {
+  do {  // avoid to sample point too close of eachother, FIXME : remove hardcoded value of 1 and find a way to
+        // compute it (a percentage of total time ?)
+    value_type u2 = t[0] + minBetweenPoint + (t[3] - t[0] - 2 * minBetweenPoint) * rand() / RAND_MAX;
+    value_type u1 = t[0] + minBetweenPoint + (t[3] - t[0] - 2 * minBetweenPoint) * rand() / RAND_MAX;
+    if (u1 < u2) {
+      t[1] = u1;
+      t[2] = u2;
+    } else {
+      t[1] = u2;
+      t[2] = u1;
+    }
+  } while (((t[1] - t[0]) < minBetweenPoint) || ((t[3] - t[2]) < minBetweenPoint) || t[2] - t[1] < minBetweenPoint);
+}
+}  // namespace
+
 RandomShortcutDynamicPtr_t RandomShortcutDynamic::create(core::ProblemConstPtr_t problem) {
   RandomShortcutDynamic* ptr = new RandomShortcutDynamic(problem);
   return RandomShortcutDynamicPtr_t(ptr);
@@ -91,7 +111,27 @@ struct PathLength {
   }
 };
 
+void RandomShortcutDynamic::addWorker(const RbPrmPathValidationPtr_t& pathValidation) {
+  Worker worker;
+  worker.sm_ = std::dynamic_pointer_cast<SteeringMethodKinodynamic>(sm_->copy());
+  worker.pathValidation_ = pathValidation;
+  workers_.push_back(worker);
+  // the collision validations of the workers are computed on the data of the robot and of its ROMs
+  const core::size_type nbData = (core::size_type)workers_.size();
+  const pinocchio::DevicePtr_t& robot = problem()->robot();
+  if (robot->numberDeviceData() < nbData) robot->numberDeviceData(nbData);
+  pinocchio::RbPrmDevicePtr_t rbprmDevice = std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(robot);
+  if (rbprmDevice) {
+    for (std::map<std::string, pinocchio::DevicePtr_t>::const_iterator cit = rbprmDevice->robotRoms_.begin();
+         cit != rbprmDevice->robotRoms_.end(); ++cit) {
+      if (cit->second->numberDeviceData() < nbData) cit->second->numberDeviceData(nbData);
+    }
+  }
+}
+
 PathVectorPtr_t RandomShortcutDynamic::optimize(const PathVectorPtr_t& path) {
+  // the path projector is shared, the projections can not be computed in parallel
+  if (!workers_.empty() && !problem()->pathProjector()) return optimizeParallel(path);
   hppDout(notice, "!! Start optimize()");
   hppStartBenchmark(RANDOM_SHORTCUT);
   using std::make_pair;
@@ -118,18 +158,7 @@ PathVectorPtr_t RandomShortcutDynamic::optimize(const PathVectorPtr_t& path) {
   while (!finished && projectionError != 0) {
     t[0] = tmpPath->timeRange().first;
     t[3] = tmpPath->timeRange().second;
-    do {  // avoid to sample point too close of eachother, FIXME : remove hardcoded value of 1 and find a way to
-          // compute it (a percentage of total time ?)
-      value_type u2 = t[0] + minBetweenPoint + (t[3] - t[0] - 2 * minBetweenPoint) * rand() / RAND_MAX;
-      value_type u1 = t[0] + minBetweenPoint + (t[3] - t[0] - 2 * minBetweenPoint) * rand() / RAND_MAX;
-      if (u1 < u2) {
-        t[1] = u1;
-        t[2] = u2;
-      } else {
-        t[1] = u2;
-        t[2] = u1;
-      }
-    } while (((t[1] - t[0]) < minBetweenPoint) || ((t[3] - t[2]) < minBetweenPoint) || t[2] - t[1] < minBetweenPoint);
+    sampleParameters(t, minBetweenPoint);
     if (!(*tmpPath)(q[1], t[1])) {
       hppDout(error, "Configuration at param " << t[1]
                                                << " could not be "
@@ -148,7 +177,6 @@ PathVectorPtr_t RandomShortcutDynamic::optimize(const PathVectorPtr_t& path) {
     bool valid[3];
     PathPtr_t straight[3];
     core::PathValidationReportPtr_t report;
-    PathPtr_t validPart;
 
     for (unsigned i = 0; i < 3; ++i) {
       straight[i] = steer(q[i], q[i + 1]);
@@ -159,7 +187,7 @@ PathVectorPtr_t RandomShortcutDynamic::optimize(const PathVectorPtr_t& path) {
         valid[i] = (straight[i]->length() <
                     PathLength<true>::run(tmpPath->extract(make_pair(t[i], t[i + 1]))->as<PathVector>(),
                                           problem()->distance()));
-        if (valid[i]) valid[i] = problem()->pathValidation()->validate(straight[i], false, validPart, report);
+        if (valid[i]) valid[i] = rbprmPathValidation_->isValid(straight[i], report);
       }
     }
     hppDout(notice, "t0 = " << t[0] << " ; t1 = " << t[1] << " ; t2 = " << t[2] << " ; t3 = " << t[3]);
@@ -208,20 +236,137 @@ PathVectorPtr_t RandomShortcutDynamic::optimize(const PathVectorPtr_t& path) {
   return result;
 }  // optimize
 
+PathVectorPtr_t RandomShortcutDynamic::optimizeParallel(const PathVectorPtr_t& path) {
+  hppDout(notice, "!! Start optimizeParallel()");
+  hppStartBenchmark(RANDOM_SHORTCUT);
+  using std::make_pair;
+  const std::size_t nbWorkers = workers_.size();
+  bool finished = false;
+  PathVectorPtr_t tmpPath = path;
+  PathVectorPtr_t result = path;
+
+  // Maximal number of iterations without improvements
+  std::size_t n = problem()->getParameter("PathOptimization/RandomShortcut/NumberOfLoops").intValue();
+  std::size_t projectionError = n;
+  std::deque<value_type> length(n - 1, std::numeric_limits<value_type>::infinity());
+  length.push_back(PathLength<>::run(tmpPath, problem()->distance()));
+  // the mass is read once, the workers do not compute the forward kinematics of the robot
+  const value_type mass = problem()->robot()->mass();
+  double minBetweenPoint = std::min(1., tmpPath->length() * 0.2);
+  while (!finished && projectionError != 0) {
+    // the parameters are sampled sequentially, rand() is not thread safe
+    std::vector<Shortcut> shortcuts;
+    for (std::size_t k = 0; k < nbWorkers; ++k) {
+      Shortcut shortcut;
+      shortcut.t_[0] = tmpPath->timeRange().first;
+      shortcut.t_[3] = tmpPath->timeRange().second;
+      sampleParameters(shortcut.t_, minBetweenPoint);
+      shortcut.q_[0] = tmpPath->initial();
+      shortcut.q_[3] = tmpPath->end();
+      shortcut.q_[1].resize(path->outputSize());
+      shortcut.q_[2].resize(path->outputSize());
+      if (!(*tmpPath)(shortcut.q_[1], shortcut.t_[1]) || !(*tmpPath)(shortcut.q_[2], shortcut.t_[2])) {
+        hppDout(error, "Configuration at param " << shortcut.t_[1] << " or " << shortcut.t_[2]
+                                                 << " could not be projected");
+        continue;
+      }
+      try {
+        for (std::size_t i = 0; i < 3; ++i) {
+          shortcut.original_[i] = tmpPath->extract(make_pair(shortcut.t_[i], shortcut.t_[i + 1]))->as<PathVector>();
+          shortcut.originalLength_[i] = PathLength<true>::run(shortcut.original_[i], problem()->distance());
+          shortcut.valid_[i] = false;
+        }
+      } catch (const core::projection_error& e) {
+        hppDout(error, "Caught exception at with time " << shortcut.t_[1] << " and " << shortcut.t_[2] << ": "
+                                                        << e.what());
+        continue;
+      }
+      shortcuts.push_back(shortcut);
+    }
+    if (shortcuts.empty()) {
+      projectionError--;
+      continue;
+    }
+
+    // the segments of the shortcuts are distributed among the workers
+    const std::size_t nbSegments = 3 * shortcuts.size();
+    std::vector<std::exception_ptr> errors(nbWorkers);
+#pragma omp parallel for num_threads((int)nbWorkers) schedule(static, 1)
+    for (int w = 0; w < (int)nbWorkers; ++w) {
+      try {
+        for (std::size_t k = (std::size_t)w; k < nbSegments; k += nbWorkers)
+          validateSegment(workers_[w], mass, shortcuts[k / 3], k % 3);
+      } catch (...) {
+        errors[w] = std::current_exception();
+      }
+    }
+    for (std::size_t w = 0; w < nbWorkers; ++w)
+      if (errors[w]) std::rethrow_exception(errors[w]);
+
+    // Replace valid parts of the shortcut giving the shortest path
+    PathVectorPtr_t best;
+    value_type bestLength = length[n - 1];
+    for (std::size_t k = 0; k < shortcuts.size(); ++k) {
+      const Shortcut& shortcut = shortcuts[k];
+      hppDout(notice, "t1 = " << shortcut.t_[1] << " ; t2 = " << shortcut.t_[2] << " ; valid : " << shortcut.valid_[0]
+                              << " " << shortcut.valid_[1] << " " << shortcut.valid_[2]);
+      if (!shortcut.valid_[0] && !shortcut.valid_[1] && !shortcut.valid_[2]) continue;
+      PathVectorPtr_t candidate = PathVector::create(path->outputSize(), path->outputDerivativeSize());
+      for (std::size_t i = 0; i < 3; ++i) {
+        if (shortcut.valid_[i])
+          candidate->appendPath(shortcut.straight_[i]);
+        else
+          candidate->concatenate(shortcut.original_[i]);
+      }
+      const value_type newLength = PathLength<>::run(candidate, problem()->distance());
+      if ((bestLength - newLength) > 10. * std::numeric_limits<core::value_type>::epsilon()) {
+        best = candidate;
+        bestLength = newLength;
+      }
+    }
+    if (!best) {
+      hppDout(info, "no shortcut reduces the length: " << length[n - 1]);
+      projectionError--;
+    } else {
+      length.push_back(bestLength);
+      length.pop_front();
+      finished = (length[0] - length[n - 1]) <= 1e-4 * length[n - 1];
+      hppDout(info, "length = " << length[n - 1]);
+      tmpPath = best;
+      result = best;
+      projectionError = n;
+    }
+  }
+  hppStopBenchmark(RANDOM_SHORTCUT);
+  hppDisplayBenchmark(RANDOM_SHORTCUT);
+  return result;
+}  // optimizeParallel
+
+void RandomShortcutDynamic::validateSegment(const Worker& worker, const value_type mass, Shortcut& shortcut,
+                                            const std::size_t i) const {
+  shortcut.straight_[i] = steer(worker, mass, shortcut.q_[i], shortcut.q_[i + 1]);
+  // with kinodynamic path, we are not assured that a 'straight line' is shorter than the previously found path
+  shortcut.valid_[i] = shortcut.straight_[i] && shortcut.straight_[i]->length() < shortcut.originalLength_[i];
+  if (shortcut.valid_[i]) {
+    core::PathValidationReportPtr_t report;
+    shortcut.valid_[i] = worker.pathValidation_->isValid(shortcut.straight_[i], report);
+  }
+}
+
 PathPtr_t RandomShortcutDynamic::steer(ConfigurationIn_t q1, ConfigurationIn_t q2) const {
   // according to optimize() method : the path is always in the direction q1 -> q2
   // first : create a node and fill all informations about contacts for the initial state (q1):
-  core::RbprmNodePtr_t x1(new core::RbprmNode(ConfigurationPtr_t(new Configuration_t(q1))));
+  core::RbprmNode x1(ConfigurationPtr_t(new Configuration_t(q1)));
   core::ValidationReportPtr_t report;
   rbprmPathValidation_->getValidator()->computeAllContacts(true);
   problem()->configValidations()->validate(q1, report);
   rbprmPathValidation_->getValidator()->computeAllContacts(false);
   hppDout(notice, "Random shortucut, fillNodeMatrices : ");
-  x1->fillNodeMatrices(report, rectangularContact_, sizeFootX_, sizeFootY_, problem()->robot()->mass(), mu_,
-                       std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()));
+  x1.fillNodeMatrices(report, rectangularContact_, sizeFootX_, sizeFootY_, problem()->robot()->mass(), mu_,
+                      std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()));
   // call steering method kinodynamic with the newly created node
   hppDout(notice, "Random shortucut, steering method  : ");
-  PathPtr_t dp = (*sm_)(x1, q2);
+  PathPtr_t dp = (*sm_)(&x1, q2);
   if (dp) {
     hppDout(notice, "Random shortucut, path exist ");
     if ((dp->initial() != q1) || (dp->end() != q2)) {
@@ -242,5 +387,21 @@ PathPtr_t RandomShortcutDynamic::steer(ConfigurationIn_t q1, ConfigurationIn_t q
   return PathPtr_t();
 }
 
+PathPtr_t RandomShortcutDynamic::steer(const Worker& worker, const value_type mass, ConfigurationIn_t q1,
+                                       ConfigurationIn_t q2) const {
+  // same as steer(q1, q2), with the validation and the steering method of the worker, without path projector
+  core::RbprmNode x1(ConfigurationPtr_t(new Configuration_t(q1)));
+  core::ValidationReportPtr_t report;
+  RbPrmValidationPtr_t validator = worker.pathValidation_->getValidator();
+  validator->computeAllContacts(true);
+  validator->validate(q1, report);
+  validator->computeAllContacts(false);
+  x1.fillNodeMatrices(report, rectangularContact_, sizeFootX_, sizeFootY_, mass, mu_,
+                      std::dynamic_pointer_cast<pinocchio::RbPrmDevice>(problem()->robot()));
+  PathPtr_t dp = (*worker.sm_)(&x1, q2);
+  if (!dp || (dp->initial() != q1) || (dp->end() != q2) || dp->length() <= 0.001) return PathPtr_t();
+  return dp;
+}
+
 }  // namespace rbprm
 }  // namespace hpp
@@ -24,6 +24,9 @@
 #include <hpp/pinocchio/configuration.hh>
 #include <hpp/core/collision-validation-report.hh>
 #include <hpp/rbprm/rbprm-device.hh>
+#include <hpp/centroidal-dynamics/util.hh>
+#include <algorithm>
+#include <limits>
 namespace hpp {
 namespace core {
 
@@ -67,6 +70,37 @@ bool computeIntersectionSurface(const core::CollisionValidationReportPtr_t repor
     return true;
 }
 
+const ContactSurfaceCache::Surface& ContactSurfaceCache::surface(const CollisionObjectConstPtr_t& obstacle,
+                                                                 pinocchio::DeviceData& deviceData) {
+  const fcl::Transform3f& transform = obstacle->fcl(deviceData)->getTransform();
+  // the obstacle is kept in the entry, so its address can not be reused by another obstacle
+  Surface& surface = surfaces_[obstacle.get()];
+  if (surface.obstacle_ == obstacle && surface.transform_ == transform) return surface;
+  surface.obstacle_ = obstacle;
+  surface.transform_ = transform;
+  geom::BVHModelOBConst_Ptr_t model = geom::GetModel(obstacle, deviceData);
+  geom::computePlanEquation(model, surface.normal_, surface.point_);
+  surface.hull_ = geom::convertBVH(model);
+  return surface;
+}
+
+// same as above, the surface of the obstacle being read from the cache
+bool computeIntersectionSurface(const core::CollisionValidationReportPtr_t report, geom::T_Point& inter,
+                                geom::Point& pn, pinocchio::DeviceData& deviceData,
+                                const ContactSurfaceCachePtr_t& surfaces) {
+  if (!surfaces) return computeIntersectionSurface(report, inter, pn, deviceData);
+  const ContactSurfaceCache::Surface& surface = surfaces->surface(report->object2, deviceData);
+  pn = surface.normal_;
+  hppStartBenchmark(COMPUTE_INTERSECTION);
+  geom::T_Point plane = geom::intersectPolygonePlane(
+      geom::GetLocalModel(report->object1), report->object1->fcl(deviceData)->getTransform(), pn, surface.point_);
+  hppStopBenchmark(COMPUTE_INTERSECTION);
+  hppDisplayBenchmark(COMPUTE_INTERSECTION);
+  if (plane.empty()) return false;
+  inter = geom::compute3DIntersection(plane, surface.hull_);
+  return !inter.empty();
+}
+
 bool centerOfRomIntersection(const core::CollisionValidationReportPtr_t report, geom::Point& pn, geom::Point& center,
                              pinocchio::DeviceData& deviceData) {
   geom::T_Point hull;
@@ -88,15 +122,16 @@ bool centerOfRomIntersection(const core::CollisionValidationReportPtr_t report,
  * @param result output the contact point
  * @param config configuration of the robot (only the root's configuration is used here)
  * @param device
+ * @param surfaces cache of the contact surfaces of the obstacles, may be null
  * @return bool success
  */
 bool approximateContactPoint(const std::string romName, const core::CollisionValidationReportPtr_t report,
                              geom::Point& pn, geom::Point& result, core::ConfigurationPtr_t config,
-                             pinocchio::RbPrmDevicePtr_t device) {
+                             pinocchio::RbPrmDevicePtr_t device, const ContactSurfaceCachePtr_t& surfaces) {
   geom::T_Point hull;
   pinocchio::DeviceSync deviceSync(device);
   hppDout(notice, "Approximate contact point for rom " << romName);
-  bool success = computeIntersectionSurface(report, hull, pn, deviceSync.d());
+  bool success = computeIntersectionSurface(report, hull, pn, deviceSync.d(), surfaces);
   // hppDout(notice,"Number of points in the intersection : "<<hull.size());
   if (success) {
     fcl::Vec3f reference = device->getEffectorReference(romName);
@@ -204,7 +239,8 @@ void computeNodeMatrixForOnePoint(const geom::Point pn, const geom::Point center
 }
 
 void RbprmNode::fillNodeMatrices(ValidationReportPtr_t report, bool rectangularContact, double sizeFootX,
-                                 double sizeFootY, double m, double mu, pinocchio::RbPrmDevicePtr_t device) {
+                                 double sizeFootY, double m, double mu, pinocchio::RbPrmDevicePtr_t device,
+                                 const ContactSurfaceCachePtr_t& surfaces) {
   assert(device && "Error in dynamic cast of problem device to rbprmDevice");
   hppStartBenchmark(FILL_NODE_MATRICE);
 
@@ -241,7 +277,7 @@ void RbprmNode::fillNodeMatrices(ValidationReportPtr_t report, bool rectangularC
        it != rbReport->ROMReports.end(); ++it) {
     hppDout(info, "~~ for rom : " << it->first);
     geom::Point pn, contactPoint;
-    pointExist = approximateContactPoint(it->first, it->second, pn, contactPoint, configuration(), device);
+    pointExist = approximateContactPoint(it->first, it->second, pn, contactPoint, configuration(), device, surfaces);
     ssContact << "[" << contactPoint[0] << " , " << contactPoint[1] << " , " << contactPoint[2] << "],";
 
     if (!pointExist) {
@@ -304,7 +340,8 @@ void RbprmNode::fillNodeMatrices(ValidationReportPtr_t report, bool rectangularC
   hppDisplayBenchmark(FILL_NODE_MATRICE);
 }
 
-void RbprmNode::chooseBestContactSurface(ValidationReportPtr_t report, pinocchio::RbPrmDevicePtr_t device) {
+void RbprmNode::chooseBestContactSurface(ValidationReportPtr_t report, pinocchio::RbPrmDevicePtr_t device,
+                                         const ContactSurfaceCachePtr_t& surfaces) {
   assert(device && "Error in dynamic cast of problem device to rbprmDevice");
   core::RbprmValidationReportPtr_t rbReport = std::dynamic_pointer_cast<core::RbprmValidationReport>(report);
   for (std::map<std::string, core::CollisionValidationReportPtr_t>::const_iterator it = rbReport->ROMReports.begin();
@@ -344,7 +381,7 @@ void RbprmNode::chooseBestContactSurface(ValidationReportPtr_t report, pinocchio
       for (std::vector<CollisionValidationReportPtr_t>::const_iterator itAff = romReports->collisionReports.begin();
            itAff != romReports->collisionReports.end(); ++itAff) {
         pinocchio::DeviceSync deviceSync(device);
-        successInter = computeIntersectionSurface(*itAff, intersection, normal, deviceSync.d());
+        successInter = computeIntersectionSurface(*itAff, intersection, normal, deviceSync.d(), surfaces);
         if (successInter) {
           distance = geom::projectPointInsidePlan(intersection, refPoint, normal, intersection.front(), proj);
           hppDout(notice, "Distance found : " << distance);
@@ -362,5 +399,87 @@ void RbprmNode::chooseBestContactSurface(ValidationReportPtr_t report, pinocchio
   }  // end for all rom
 }
 
+namespace {
+// tolerance on the normalized inequalities of the acceleration polytope
+const double accelerationTolerance = 1e-8;
+}  // namespace
+
+bool RbprmNode::computeAccelerationPolytope() {
+  accelerationPolytopeComputed_ = false;
+  if (G_.cols() == 0) return false;
+  // inequalities of the cone generated by the columns of G: rows [d | -C] of d - C w >= 0
+  dd_MatrixPtr generators = centroidal_dynamics::cone_span_eigen_to_cdd(G_.transpose());
+  dd_ErrorType error = dd_NoError;
+  dd_PolyhedraPtr cone = dd_DDMatrix2Poly(generators, &error);
+  if (error != dd_NoError) {
+    hppDout(error, "Double description of the GIWC failed, error " << error);
+    dd_FreeMatrix(generators);
+    return false;
+  }
+  dd_MatrixPtr inequalities = dd_CopyInequalities(cone);
+  const long rowSize = inequalities->rowsize;
+  std::vector<long> equalities;
+  for (long i = 0; i < rowSize; ++i)
+    if (set_member(i + 1, inequalities->linset)) equalities.push_back(i);
+  // C w <= d, the equalities being added as two opposite inequalities
+  MatrixXX C(rowSize + (long)equalities.size(), 6);
+  VectorX d(C.rows());
+  for (long i = 0; i < rowSize; ++i) {
+    d(i) = (double)(*(inequalities->matrix[i][0]));
+    for (long j = 0; j < 6; ++j) C(i, j) = -(double)(*(inequalities->matrix[i][j + 1]));
+  }
+  for (std::size_t k = 0; k < equalities.size(); ++k) {
+    C.row(rowSize + (long)k) = -C.row(equalities[k]);
+    d(rowSize + (long)k) = -d(equalities[k]);
+  }
+  dd_FreeMatrix(generators);
+  dd_FreeMatrix(inequalities);
+  dd_FreePolyhedra(cone);
+  for (long i = 0; i < C.rows(); ++i) {
+    const double norm = C.row(i).norm();
+    if (norm > 0.) {
+      C.row(i) /= norm;
+      d(i) /= norm;
+    }
+  }
+  // C (H a - h) <= d
+  accelerationA_ = C * H_;
+  accelerationb_ = d + C * h_;
+  accelerationPolytopeComputed_ = true;
+  return true;
+}
+
+bool RbprmNode::isAccelerationAdmissible(const centroidal_dynamics::Vector3& a) const {
+  assert(accelerationPolytopeComputed_ && "The acceleration polytope of the node is not computed");
+  if (accelerationA_.rows() == 0) return true;
+  return (accelerationA_ * a - accelerationb_).maxCoeff() <= accelerationTolerance;
+}
+
+void RbprmNode::isAccelerationAdmissible(const Matrix3X& accelerations, std::vector<bool>& admissible) const {
+  assert(accelerationPolytopeComputed_ && "The acceleration polytope of the node is not computed");
+  admissible.assign(accelerations.cols(), true);
+  if (accelerationA_.rows() == 0) return;
+  const MatrixXX slack = (accelerationA_ * accelerations).colwise() - accelerationb_;
+  for (long i = 0; i < accelerations.cols(); ++i) admissible[i] = slack.col(i).maxCoeff() <= accelerationTolerance;
+}
+
+double RbprmNode::maximumAcceleration(const centroidal_dynamics::Vector3& direction) const {
+  assert(accelerationPolytopeComputed_ && "The acceleration polytope of the node is not computed");
+  double lower = -std::numeric_limits<double>::infinity();
+  double upper = std::numeric_limits<double>::infinity();
+  const VectorX Ad = accelerationA_ * direction;
+  for (long i = 0; i < Ad.size(); ++i) {
+    if (Ad(i) > accelerationTolerance)
+      upper = std::min(upper, accelerationb_(i) / Ad(i));
+    else if (Ad(i) < -accelerationTolerance)
+      lower = std::max(lower, accelerationb_(i) / Ad(i));
+    else if (accelerationb_(i) < -accelerationTolerance)
+      return 0.;
+  }
+  // as the LP of centroidal_dynamics, 0 when infeasible
+  if (lower > upper + accelerationTolerance) return 0.;
+  return upper;
+}
+
 }  // namespace core
 }  // namespace hpp
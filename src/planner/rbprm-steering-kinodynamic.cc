@@ -46,6 +46,8 @@ SteeringMethodKinodynamic::SteeringMethodKinodynamic(core::ProblemConstPtr_t pro
       sEq_(new centroidal_dynamics::Equilibrium(problem->robot()->name(), problem->robot()->mass(), 4,
                                                 centroidal_dynamics::SOLVER_LP_QPOASES, true, 10, false)),
       boundsUpToDate_(false),
+      gUpToDate_(false),
+      q_(problem->robot()->configSize()),
       weak_() {
   lastDirection_.setZero();
 }
@@ -64,6 +66,8 @@ SteeringMethodKinodynamic::SteeringMethodKinodynamic(const SteeringMethodKinodyn
       sEq_(new centroidal_dynamics::Equilibrium(problem()->robot()->name(), problem()->robot()->mass(), 4,
                                                 centroidal_dynamics::SOLVER_LP_QPOASES, true, 10, false)),
       boundsUpToDate_(false),
+      gUpToDate_(false),
+      q_(other.q_.size()),
       weak_() {}
 
 core::PathPtr_t SteeringMethodKinodynamic::impl_compute(core::ConfigurationIn_t q1, core::ConfigurationIn_t q2) const {
@@ -72,6 +76,29 @@ core::PathPtr_t SteeringMethodKinodynamic::impl_compute(core::ConfigurationIn_t
   return core::steeringMethod::Kinodynamic::impl_compute(q1, q2);
 }
 
+std::vector<core::PathPtr_t> SteeringMethodKinodynamic::operator()(const core::NodePtr_t x,
+                                                                   const std::vector<core::ConfigurationPtr_t>& targets,
+                                                                   bool reverse) {
+  std::vector<core::PathPtr_t> paths(targets.size());
+  core::RbprmNodePtr_t node = static_cast<core::RbprmNodePtr_t>(x);
+  if (!node) return paths;
+  if (!node->accelerationPolytopeComputed()) {
+    sEq_->setG(node->getG());
+    gUpToDate_ = true;
+  }
+  try {
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+      if (!targets[i]) continue;
+      paths[i] = reverse ? (*this)(*targets[i], x) : (*this)(x, *targets[i]);
+    }
+  } catch (...) {
+    gUpToDate_ = false;
+    throw;
+  }
+  gUpToDate_ = false;
+  return paths;
+}
+
 core::PathPtr_t SteeringMethodKinodynamic::impl_compute(core::NodePtr_t x, core::ConfigurationIn_t q2) {
   core::RbprmNodePtr_t node = static_cast<core::RbprmNodePtr_t>(x);
   assert(node && "Unable to cast near node to rbprmNode");
@@ -113,58 +140,43 @@ core::PathPtr_t SteeringMethodKinodynamic::impl_compute(core::NodePtr_t x, core:
   core::vector_t t1 = kinoPath->getT1();
   core::vector_t tv = kinoPath->getTv();
   double t = 0;
-  core::ConfigurationPtr_t q(new core::Configuration_t(problem()->robot()->configSize()));
   core::vector3_t a;
   bool aValid;
   double maxT = kinoPath->length();
   hppDout(info, "## start checking intermediate accelerations");
   double epsilon = 0.0001;
   t = epsilon;
-  (*kinoPath)(*q, t);
-  hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-  a = (*q).segment<3>(configSize + 3);
+  (*kinoPath)(q_, t);
+  hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(q_));
+  a = q_.segment<3>(configSize + 3);
   hppDout(info, "a = " << a);
-  sEq_->setG(node->getG());
-  aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
+  // the LP is only used when the acceleration polytope of the node is not computed
+  if (!node->accelerationPolytopeComputed() && !gUpToDate_) sEq_->setG(node->getG());
+  aValid = checkAdmissibleAcceleration(node, a);
   hppDout(info, "a valid : " << aValid);
   if (!aValid) {
     return core::PathPtr_t();
   }
+  // the accelerations after the sign changes of all the joints are checked together
+  times_.clear();
   for (size_t ijoint = 0; ijoint < 3; ijoint++) {
     t = epsilon;
     if (t0[ijoint] > 0) {
-      hppDout(info, "for joint " << ijoint);
       t = t0[ijoint] + epsilon;  // add an epsilon to get the value after the sign change
-      (*kinoPath)(*q, t);
-      hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-      a = (*q).segment<3>(configSize + 3);
-      hppDout(info, "a = " << a);
-      aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
-      hppDout(info, "a valid : " << aValid);
-      if (!aValid && t < maxT) maxT = t;
+      times_.push_back(t);
     }
     if (t1[ijoint] > 0) {
-      hppDout(info, "for joint " << ijoint);
-      t += t1[ijoint];  // add an epsilon to get the value after the sign change
-      (*kinoPath)(*q, t);
-      hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-      a = (*q).segment<3>(configSize + 3);
-      hppDout(info, "a = " << a);
-      aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
-      hppDout(info, "a valid : " << aValid);
-      if (!aValid && t < maxT) maxT = t;
+      t += t1[ijoint];
+      times_.push_back(t);
     }
     if (tv[ijoint] > 0) {
       t += tv[ijoint];
-      (*kinoPath)(*q, t);
-      hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-      a = (*q).segment<3>(configSize + 3);
-      hppDout(info, "a = " << a);
-      aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
-      hppDout(info, "a valid : " << aValid);
-      if (!aValid && t < maxT) maxT = t;
+      times_.push_back(t);
     }
   }
+  checkAdmissibleAccelerations(node, kinoPath, times_, admissible_);
+  for (std::size_t i = 0; i < times_.size(); ++i)
+    if (!admissible_[i] && times_[i] < maxT) maxT = times_[i];
 
   hppDout(info, "t = " << kinoPath->length() << " maxT = " << maxT);
   if (maxT < kinoPath->length()) {
@@ -221,7 +233,6 @@ core::PathPtr_t SteeringMethodKinodynamic::impl_compute(core::ConfigurationIn_t
   core::vector_t t1 = kinoPath->getT1();
   core::vector_t tv = kinoPath->getTv();
   double t = 0;
-  core::ConfigurationPtr_t q(new core::Configuration_t(problem()->robot()->configSize()));
   core::vector3_t a;
   bool aValid;
   double minT = 0;
@@ -229,51 +240,37 @@ core::PathPtr_t SteeringMethodKinodynamic::impl_compute(core::ConfigurationIn_t
   hppDout(info, "## start checking intermediate accelerations");
   double epsilon = 0.0001;
   t = kinoPath->length() - epsilon;
-  (*kinoPath)(*q, t);
-  hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-  a = (*q).segment<3>(configSize + 3);
+  (*kinoPath)(q_, t);
+  hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(q_));
+  a = q_.segment<3>(configSize + 3);
   hppDout(info, "a = " << a);
-  sEq_->setG(node->getG());
-  aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
+  // the LP is only used when the acceleration polytope of the node is not computed
+  if (!node->accelerationPolytopeComputed() && !gUpToDate_) sEq_->setG(node->getG());
+  aValid = checkAdmissibleAcceleration(node, a);
   hppDout(info, "a valid : " << aValid);
   if (!aValid) {
     return core::PathPtr_t();
   }
+  // the accelerations after the sign changes of all the joints are checked together
+  times_.clear();
   for (size_t ijoint = 0; ijoint < 3; ijoint++) {
-    hppDout(info, "for joint " << ijoint);
     t = -epsilon;
     if (t0[ijoint] > 0) {
-      hppDout(info, "for joint " << ijoint);
       t = t0[ijoint] - epsilon;  // add an epsilon to get the value after the sign change
-      (*kinoPath)(*q, t);
-      hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-      a = (*q).segment<3>(configSize + 3);
-      hppDout(info, "a = " << a);
-      aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
-      hppDout(info, "a valid : " << aValid);
-      if (!aValid && t > minT) minT = t;
+      times_.push_back(t);
     }
     if (t1[ijoint] > 0) {
       t += t1[ijoint];
-      (*kinoPath)(*q, t);
-      hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-      a = (*q).segment<3>(configSize + 3);
-      hppDout(info, "a = " << a);
-      aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
-      hppDout(info, "a valid : " << aValid);
-      if (!aValid && t > minT) minT = t;
+      times_.push_back(t);
     }
     if (tv[ijoint] > 0) {
       t += tv[ijoint];
-      (*kinoPath)(*q, t);
-      hppDout(info, "q(t=" << t << ") = " << pinocchio::displayConfig(*q));
-      a = (*q).segment<3>(configSize + 3);
-      hppDout(info, "a = " << a);
-      aValid = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
-      hppDout(info, "a valid : " << aValid);
-      if (!aValid && t > minT) minT = t;
+      times_.push_back(t);
     }
   }
+  checkAdmissibleAccelerations(node, kinoPath, times_, admissible_);
+  for (std::size_t i = 0; i < times_.size(); ++i)
+    if (!admissible_[i] && times_[i] > minT) minT = times_[i];
   hppDout(info, "t = " << kinoPath->length() << " minT = " << minT);
   if (minT > 0) {
     minT += epsilon;
@@ -313,6 +310,32 @@ core::PathPtr_t SteeringMethodKinodynamic::computeDirection(const core::Configur
   return path;
 }
 
+bool SteeringMethodKinodynamic::checkAdmissibleAcceleration(const core::RbprmNodePtr_t& node, const Vector3& a) {
+  if (node->accelerationPolytopeComputed()) return node->isAccelerationAdmissible(a);
+  return sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), a);
+}
+
+void SteeringMethodKinodynamic::checkAdmissibleAccelerations(const core::RbprmNodePtr_t& node,
+                                                             const core::KinodynamicPathPtr_t& path,
+                                                             const std::vector<double>& times,
+                                                             std::vector<bool>& admissible) {
+  const core::size_type configSize =
+      problem()->robot()->configSize() - problem()->robot()->extraConfigSpace().dimension();
+  accelerations_.resize(3, times.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    (*path)(q_, times[i]);
+    accelerations_.col(i) = q_.segment<3>(configSize + 3);
+  }
+  hppDout(info, "accelerations checked : " << std::endl << accelerations_);
+  if (node->accelerationPolytopeComputed()) {
+    node->isAccelerationAdmissible(accelerations_, admissible);
+    return;
+  }
+  admissible.resize(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i)
+    admissible[i] = sEq_->checkAdmissibleAcceleration(node->getH(), node->geth(), accelerations_.col(i));
+}
+
 core::PathPtr_t SteeringMethodKinodynamic::setSteeringMethodBounds(const core::RbprmNodePtr_t& node,
                                                                    const core::ConfigurationIn_t target,
                                                                    bool reverse) {
@@ -373,17 +396,21 @@ core::PathPtr_t SteeringMethodKinodynamic::setSteeringMethodBounds(const core::R
   hppDout(notice, "number of contacts :  " << node->getNumberOfContacts());
 
   // call to centroidal_dynamics_lib :
-  sEq_->setG(node->getG());
-  centroidal_dynamics::LP_status lpStatus =
-      sEq_->findMaximumAcceleration(node->getH(), node->geth(), lastDirection_, alpha0);
-  if (lpStatus == centroidal_dynamics::LP_STATUS_UNBOUNDED) {
-    hppDout(notice, "Primal LP problem is unbounded : " << (lpStatus));
-  } else if (lpStatus == centroidal_dynamics::LP_STATUS_OPTIMAL) {
-    hppDout(notice, "Primal LP correctly solved: " << (lpStatus));
-  } else if (lpStatus == centroidal_dynamics::LP_STATUS_INFEASIBLE) {
-    hppDout(notice, "Primal LP problem could not be solved: " << (lpStatus));
+  if (node->accelerationPolytopeComputed()) {
+    alpha0 = node->maximumAcceleration(lastDirection_);
   } else {
-    hppDout(notice, "Unknown error in LP : " << lpStatus);
+    if (!gUpToDate_) sEq_->setG(node->getG());
+    centroidal_dynamics::LP_status lpStatus =
+        sEq_->findMaximumAcceleration(node->getH(), node->geth(), lastDirection_, alpha0);
+    if (lpStatus == centroidal_dynamics::LP_STATUS_UNBOUNDED) {
+      hppDout(notice, "Primal LP problem is unbounded : " << (lpStatus));
+    } else if (lpStatus == centroidal_dynamics::LP_STATUS_OPTIMAL) {
+      hppDout(notice, "Primal LP correctly solved: " << (lpStatus));
+    } else if (lpStatus == centroidal_dynamics::LP_STATUS_INFEASIBLE) {
+      hppDout(notice, "Primal LP problem could not be solved: " << (lpStatus));
+    } else {
+      hppDout(notice, "Unknown error in LP : " << lpStatus);
+    }
   }
 
   hppDout(info, "Amax found : " << alpha0);
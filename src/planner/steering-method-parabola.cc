@@ -27,6 +27,8 @@
 #include <hpp/rbprm/rbprm-path-validation.hh>
 #include <hpp/rbprm/rbprm-validation-report.hh>
 #include <hpp/pinocchio/configuration.hh>
+#include <algorithm>
+#include <limits>
 
 namespace hpp {
 namespace rbprm {
@@ -298,22 +300,31 @@ core::PathPtr_t SteeringMethodParabola::compute_3D_path(core::ConfigurationIn_t
   hppDout(info, "pp->endROMnames_ size= " << pp->endROMnames_.size());
 
   bool hasCollisions = !rbPathValidation->validate(pp, false, validPart, pathReport, filter);
-  std::size_t n = 0;
   if (hasCollisions || !maxHeightRespected) {
     // problem.parabolaResults_ [0] ++; // not increased during dichotomy
     hppDout(info, "parabola has collisions, start dichotomy");
-    while ((hasCollisions || !maxHeightRespected) && n < nLimit_) {
+    // parabolas of the dichotomy, null if they exceed the maximal height
+    std::vector<ParabolaPathPtr_t> parabolas;
+    for (std::size_t n = 0; n < nLimit_; ++n) {
       alpha = dichotomy(alpha_inf_bound, alpha_sup_bound, n);
-
       hppDout(info, "alpha= " << alpha);
       coefs = computeCoefficients(alpha, theta, X_theta, Z, x_theta_0, z_0);
-      maxHeightRespected = parabMaxHeightRespected(coefs, x_theta_0, x_theta_imp);
-      pp = ParabolaPath::create(device_.lock(), q1, q2, computeLength(q1, q2, coefs), coefs, V0_, Vimp_,
-                                initialROMnames_, endROMnames_);
+      if (parabMaxHeightRespected(coefs, x_theta_0, x_theta_imp))
+        parabolas.push_back(ParabolaPath::create(device_.lock(), q1, q2, computeLength(q1, q2, coefs), coefs, V0_,
+                                                 Vimp_, initialROMnames_, endROMnames_));
+      else
+        parabolas.push_back(ParabolaPathPtr_t());
+    }
+    // the parabolas are only validated once they are known to be collision free at the sampled parameters
+    discardCollidingParabolas(rbPathValidation->getValidator(), rbPathValidation->stepSize(), parabolas);
+    hasCollisions = true;
+    maxHeightRespected = true;
+    for (std::size_t n = 0; n < parabolas.size() && hasCollisions; ++n) {
+      if (!parabolas[n]) continue;
+      pp = parabolas[n];
       hasCollisions = !rbPathValidation->validate(pp, false, validPart, pathReport, filter);
       hppDout(info, "Dichotomy iteration: " << n);
-      n++;
-    }  // while
+    }
   }
   if (hasCollisions || !maxHeightRespected) return core::PathPtr_t();
   core::Configuration_t init = pp->initial();
@@ -731,12 +742,22 @@ vector_t SteeringMethodParabola::computeCoefficients(const value_type alpha, con
   return coefs;
 }
 
+value_type SteeringMethodParabola::parabMaxHeight(const vector_t coefs, const value_type x_theta_0,
+                                                  const value_type x_theta_imp) const {
+  const value_type z_0 = coefs(0) * x_theta_0 * x_theta_0 + coefs(1) * x_theta_0 + coefs(2);
+  const value_type z_imp = coefs(0) * x_theta_imp * x_theta_imp + coefs(1) * x_theta_imp + coefs(2);
+  const value_type x_theta_max = -0.5 * coefs(1) / coefs(0);
+  if (x_theta_0 <= x_theta_max && x_theta_max <= x_theta_imp)
+    return coefs(2) - 0.25 * coefs(1) * coefs(1) / coefs(0);
+  return std::max(z_0, z_imp);
+}
+
 bool SteeringMethodParabola::parabMaxHeightRespected(const vector_t coefs, const value_type x_theta_0,
                                                      const value_type x_theta_imp) const {
   const value_type x_theta_max = -0.5 * coefs(1) / coefs(0);
-  const value_type z_x_theta_max = coefs(0) * x_theta_max * x_theta_max + coefs(1) * x_theta_max + coefs(2);
+  // outside of the apex, the extremities of the parabola are the configurations to link
   if (x_theta_0 <= x_theta_max && x_theta_max <= x_theta_imp) {
-    if (z_x_theta_max > device_.lock()->rootJoint()->upperBound(2)) {
+    if (parabMaxHeight(coefs, x_theta_0, x_theta_imp) > device_.lock()->rootJoint()->upperBound(2)) {
       // hppDout (info, "z_x_theta_max: " << z_x_theta_max);
       return false;
     }
@@ -744,6 +765,42 @@ bool SteeringMethodParabola::parabMaxHeightRespected(const vector_t coefs, const
   return true;
 }
 
+void SteeringMethodParabola::discardCollidingParabolas(const RbPrmValidationPtr_t& validation, const value_type step,
+                                                        std::vector<ParabolaPathPtr_t>& parabolas) {
+  value_type length = 0.;
+  for (std::size_t i = 0; i < parabolas.size(); ++i)
+    if (parabolas[i]) length = parabolas[i]->length();
+  if (step <= 0.) return;
+  bool success;
+  value_type trunkRadius;
+  // the extremities are the configurations linked by all the parabolas
+  for (value_type t = step; t < length; t += step) {
+    // height of the root of each parabola at t, in increasing order
+    std::vector<std::pair<value_type, std::size_t> > heights;
+    std::vector<core::Configuration_t> configurations(parabolas.size());
+    for (std::size_t i = 0; i < parabolas.size(); ++i) {
+      if (!parabolas[i]) continue;
+      configurations[i] = (*parabolas[i])(t, success);
+      heights.push_back(std::make_pair(configurations[i][2], i));
+    }
+    if (heights.empty()) return;
+    std::sort(heights.begin(), heights.end());
+    // the trunk is collision free below freeHeight, from the height of the last configuration tested
+    value_type freeHeight = -std::numeric_limits<value_type>::infinity();
+    for (std::size_t k = 0; k < heights.size(); ++k) {
+      if (heights[k].first < freeHeight) continue;
+      const std::size_t i = heights[k].second;
+      const value_type distance = validation->trunkDistance(configurations[i], trunkRadius);
+      if (distance <= 0.) {
+        hppDout(info, "parabola " << i << " discarded, collision at parameter " << t);
+        parabolas[i].reset();
+      } else {
+        freeHeight = heights[k].first + distance;
+      }
+    }
+  }
+}
+
 value_type SteeringMethodParabola::dichotomy(value_type a_inf, value_type a_plus, std::size_t n) const {
   value_type alpha, e;  // e in ]0,1[
   switch (n) {          // NLimit_ <= 6, otherwise fill missing values for n>5
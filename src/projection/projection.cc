@@ -17,11 +17,14 @@
 // <http://www.gnu.org/licenses/>.
 
 #include <hpp/rbprm/projection/projection.hh>
+#include <hpp/rbprm/projection/projector-cache.hh>
 #include <hpp/rbprm/interpolation/interpolation-constraints.hh>
 #include <hpp/pinocchio/joint.hh>
+#include <hpp/constraints/generic-transformation.hh>
 #include <hpp/constraints/relative-com.hh>
 #include <hpp/constraints/symbolic-calculus.hh>
 #include <hpp/constraints/symbolic-function.hh>
+#include <pinocchio/spatial/explog.hpp>
 
 #ifdef PROFILE
 #include "hpp/rbprm/rbprm-profiler.hh"
@@ -88,14 +91,74 @@ void CreateContactConstraints(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const hpp
   }
 }
 
-void CreateRootPosConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const fcl::Vec3f& target,
-                             core::ConfigProjectorPtr_t proj) {
-  pinocchio::Transform3f position(1);
-  position.translation(target);
+// position constraint of a frame of joint, its target in the world frame being the right hand side
+constraints::ImplicitPtr_t CreatePositionTarget(const pinocchio::DevicePtr_t& device,
+                                                const pinocchio::JointPtr_t& joint,
+                                                const pinocchio::Transform3f& frameInJoint) {
   const constraints::DifferentiableFunctionPtr_t& function = constraints::Position::create(
-      "", fullBody->device_, fullBody->device_->rootJoint(), pinocchio::Transform3f(1), position);
-  constraints::ComparisonTypes_t comp (function->outputDerivativeSize(), constraints::EqualToZero);
-  proj->add(constraints::Implicit::create(function, comp));
+      "", device, joint, frameInJoint, pinocchio::Transform3f(1), std::vector<bool>(3, true));
+  constraints::ComparisonTypes_t comp(function->outputDerivativeSize(), constraints::Equality);
+  return constraints::Implicit::create(function, comp);
+}
+
+// orientation constraint of a frame of joint, its target rotation in the world frame being the right hand side.
+// The output of the constraint is in SO(3), so that the error is the rotation between the frame and its target.
+constraints::ImplicitPtr_t CreateOrientationTarget(const pinocchio::DevicePtr_t& device,
+                                                   const pinocchio::JointPtr_t& joint,
+                                                   const pinocchio::Transform3f& frameInJoint) {
+  const constraints::DifferentiableFunctionPtr_t& function = constraints::OrientationSO3::create(
+      "", device, joint, frameInJoint, pinocchio::Transform3f(1), std::vector<bool>(3, true));
+  constraints::ComparisonTypes_t comp(function->outputDerivativeSize(), constraints::Equality);
+  return constraints::Implicit::create(function, comp);
+}
+
+// sets the target rotation of a constraint created by CreateOrientationTarget
+void SetOrientationTarget(const core::ConfigProjectorPtr_t& projector, const constraints::ImplicitPtr_t& orientation,
+                          const fcl::Matrix3f& rotation) {
+  // the rotation is integrated from the neutral element of the output space, which does not depend on the
+  // representation of SO(3) in this space
+  const pinocchio::LiegroupElement target =
+      orientation->function().outputSpace()->neutral() + ::pinocchio::log3(rotation);
+  projector->rightHandSide(orientation, target.vector());
+}
+
+// Projector of the cache of context for the fixed contacts of state and the projection described by key,
+// built with the contact constraints if it is not in the cache.
+// The right hand sides of the contact constraints are set to the positions and rotations of the contacts of state.
+// \retval created true if the projector was built, the other constraints of the projection must then be added
+ProjectorCache::Entry& CachedContactProjector(const KinematicContextPtr_t& context, const hpp::rbprm::State& state,
+                                              ProjectorCache::Key& key, const core::value_type errorThreshold,
+                                              const core::size_type maxIterations, bool& created) {
+  const pinocchio::DevicePtr_t& device = context->device();
+  key.contacts_ = state.fixedContacts(state);
+  ProjectorCache::Entry* entry = context->projectorCache()->find(key);
+  created = !entry;
+  if (created) {
+    entry = &context->projectorCache()->add(key);
+    entry->projector_ = core::ConfigProjector::create(device, "proj", errorThreshold, maxIterations);
+    for (std::vector<std::string>::const_iterator cit = key.contacts_.begin(); cit != key.contacts_.end(); ++cit) {
+      RbPrmLimbPtr_t limb = context->fullBody()->GetLimbs().at(*cit);
+      const pinocchio::Frame effectorFrame = context->effector(limb);
+      pinocchio::JointPtr_t effectorJoint = effectorFrame.joint();
+      const constraints::ImplicitPtr_t position =
+          CreatePositionTarget(device, effectorJoint, effectorFrame.pinocchio().placement);
+      entry->projector_->add(position);
+      entry->contacts_.push_back(position);
+      constraints::ImplicitPtr_t orientation;
+      if (limb->contactType_ == hpp::rbprm::_6_DOF) {
+        orientation = CreateOrientationTarget(device, effectorJoint, effectorFrame.pinocchio().placement);
+        entry->projector_->add(orientation);
+      }
+      entry->orientations_.push_back(orientation);
+    }
+  }
+  for (std::size_t i = 0; i < key.contacts_.size(); ++i) {
+    const std::string& effector = key.contacts_[i];
+    entry->projector_->rightHandSide(entry->contacts_[i], state.contactPositions_.at(effector));
+    if (entry->orientations_[i])
+      SetOrientationTarget(entry->projector_, entry->orientations_[i], state.contactRotation_.at(effector));
+  }
+  return *entry;
 }
 
 typedef constraints::PointCom PointCom;
@@ -103,8 +166,8 @@ typedef constraints::CalculusBaseAbstract<PointCom::ValueType_t, PointCom::Jacob
 typedef constraints::SymbolicFunction<s_t> PointComFunction;
 typedef constraints::SymbolicFunction<s_t>::Ptr_t PointComFunctionPtr_t;
 
-void CreateComPosConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const fcl::Vec3f& target,
-                            core::ConfigProjectorPtr_t proj) {
+constraints::ImplicitPtr_t CreateComPosConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const fcl::Vec3f& target,
+                                                  core::ConfigProjectorPtr_t proj) {
   pinocchio::DevicePtr_t device = fullBody->device_;
   pinocchio::CenterOfMassComputationPtr_t comComp = pinocchio::CenterOfMassComputation::create(device);
   comComp->add(device->rootJoint());
@@ -114,9 +177,11 @@ void CreateComPosConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const fcl::
   constraints::ImplicitPtr_t comEq = constraints::Implicit::create(comFunc, equals);
   proj->add(comEq);
   proj->rightHandSide(comEq, target);
+  return comEq;
 }
 
-void CreatePosturalTaskConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, core::ConfigProjectorPtr_t proj) {
+void CreatePosturalTaskConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const pinocchio::DevicePtr_t& device,
+                                  core::ConfigProjectorPtr_t proj) {
   // hppDout(notice,"create postural task, in projection.cc, ref config =
   // "<<pinocchio::displayConfig(fullBody->referenceConfig()));
   std::vector<bool> mask(fullBody->device_->numberDof(), false);
@@ -164,7 +229,7 @@ void CreatePosturalTaskConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, core:
   // constraints::ConfigurationConstraintPtr_t postFunc =
   // constraints::ConfigurationConstraint::create("Postural_Task",fullBody->device_,fullBody->referenceConfig(),weight,mask);
   constraints::ConfigurationConstraintPtr_t postFunc = constraints::ConfigurationConstraint::create(
-      "Postural_Task", fullBody->device_, fullBody->referenceConfig(), weight);
+      "Postural_Task", device, fullBody->referenceConfig(), weight);
   ComparisonTypes_t comps;
   comps.push_back(constraints::Equality);
   const constraints::ImplicitPtr_t posturalTask = constraints::Implicit::create(postFunc, comps);
@@ -175,11 +240,17 @@ void CreatePosturalTaskConstraint(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, core:
 ProjectionReport projectToRootPosition(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const fcl::Vec3f& target,
                                        const hpp::rbprm::State& currentState) {
   ProjectionReport res;
-  core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(fullBody->device_, "proj", 1e-4, 100);
-  CreateContactConstraints(fullBody, currentState, proj);
-  CreateRootPosConstraint(fullBody, target, proj);
+  ProjectorCache::Key key(ProjectorCache::ROOT_POSITION);
+  bool created;
+  ProjectorCache::Entry& entry =
+      CachedContactProjector(KinematicContext::shared(fullBody), currentState, key, 1e-4, 100, created);
+  if (created) {
+    entry.target_ = CreatePositionTarget(fullBody->device_, fullBody->device_->rootJoint(), pinocchio::Transform3f(1));
+    entry.projector_->add(entry.target_);
+  }
+  entry.projector_->rightHandSide(entry.target_, target);
   pinocchio::Configuration_t configuration = currentState.configuration_;
-  res.success_ = proj->apply(configuration);
+  res.success_ = entry.projector_->apply(configuration);
   res.result_ = currentState;
   res.result_.configuration_ = configuration;
   return res;
@@ -200,61 +271,84 @@ bool not_a_limb(pinocchio::JointPtr_t cJoint, T_Joint limbs) {
   return true;
 }
 
+// the joints are locked to their value in targetRootConfiguration, the locked joints can then be updated with
+// their right hand side
 void LockFromRootRec(pinocchio::JointPtr_t cJoint, const std::vector<pinocchio::JointPtr_t>& jointLimbs,
-                     pinocchio::ConfigurationIn_t targetRootConfiguration, core::ConfigProjectorPtr_t& projector) {
+                     pinocchio::ConfigurationIn_t targetRootConfiguration, core::ConfigProjectorPtr_t& projector,
+                     std::vector<constraints::ImplicitPtr_t>& lockedJoints) {
   if (not_a_limb(cJoint, jointLimbs)) {
     core::size_type rankInConfiguration = (cJoint->rankInConfiguration());
-    projector->add(core::LockedJoint::create(
+    core::LockedJointPtr_t lockedJoint = core::LockedJoint::create(
         cJoint, LiegroupElement(targetRootConfiguration.segment(rankInConfiguration, cJoint->configSize()),
-                                cJoint->configurationSpace())));
+                                cJoint->configurationSpace()));
+    lockedJoint->comparisonType(constraints::ComparisonTypes_t(cJoint->numberDof(), constraints::Equality));
+    projector->add(lockedJoint);
+    lockedJoints.push_back(lockedJoint);
     // if (cJoint->numberChildJoints() !=1)
     //    return;
     for (std::size_t i = 0; i < cJoint->numberChildJoints(); ++i)
-      LockFromRootRec(cJoint->childJoint(i), jointLimbs, targetRootConfiguration, projector);
+      LockFromRootRec(cJoint->childJoint(i), jointLimbs, targetRootConfiguration, projector, lockedJoints);
   }
 }
 
 void LockFromRoot(hpp::pinocchio::DevicePtr_t device, const rbprm::T_Limb& limbs,
-                  pinocchio::ConfigurationIn_t targetRootConfiguration, core::ConfigProjectorPtr_t& projector) {
+                  pinocchio::ConfigurationIn_t targetRootConfiguration, core::ConfigProjectorPtr_t& projector,
+                  std::vector<constraints::ImplicitPtr_t>& lockedJoints) {
   std::vector<pinocchio::JointPtr_t> jointLimbs = getJointsFromLimbs(limbs);
   pinocchio::JointPtr_t cJoint = device->rootJoint();
-  LockFromRootRec(cJoint, jointLimbs, targetRootConfiguration, projector);
+  LockFromRootRec(cJoint, jointLimbs, targetRootConfiguration, projector, lockedJoints);
 }
 
 ProjectionReport projectToRootConfiguration(hpp::rbprm::RbPrmFullBodyPtr_t fullBody,
                                             const pinocchio::ConfigurationIn_t conf,
                                             const hpp::rbprm::State& currentState, const Vector3 offset) {
+  if (offset == Vector3::Zero())
+    return projectToRootConfiguration(KinematicContext::shared(fullBody), conf, currentState);
   ProjectionReport res;
+  pinocchio::Configuration_t configuration = currentState.configuration_;
   core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(fullBody->device_, "proj", 1e-4, 100);
   CreateContactConstraints(fullBody, currentState, proj);
-  if (offset == Vector3::Zero())
-    LockFromRoot(fullBody->device_, fullBody->GetLimbs(), conf, proj);
-  else {
-    const std::string rootJointName("root_joint");
-    const fcl::Vec3f ppos = conf.head<3>();
-    const pinocchio::Frame effectorFrame = fullBody->device_->getFrameByName(rootJointName);
-    pinocchio::JointPtr_t effectorJoint = effectorFrame.joint();
+  const std::string rootJointName("root_joint");
+  const fcl::Vec3f ppos = conf.head<3>();
+  const pinocchio::Frame effectorFrame = fullBody->device_->getFrameByName(rootJointName);
+  pinocchio::JointPtr_t effectorJoint = effectorFrame.joint();
 
-    std::vector<bool> mask;
-    mask.push_back(true);
-    mask.push_back(true);
-    mask.push_back(true);
-    pinocchio::Transform3f localFrame(1), globalFrame(1);
-    localFrame.translation(offset);
-    globalFrame.translation(ppos);
-    const constraints::DifferentiableFunctionPtr_t& function =
-        constraints::Position::create(rootJointName, fullBody->device_, effectorJoint,
-                                      effectorFrame.pinocchio().placement * localFrame, globalFrame, mask);
-    constraints::ComparisonTypes_t comp (function->outputDerivativeSize(), constraints::EqualToZero);
-    proj->add(constraints::Implicit::create(function, comp));
-  }
-  pinocchio::Configuration_t configuration = currentState.configuration_;
+  std::vector<bool> mask;
+  mask.push_back(true);
+  mask.push_back(true);
+  mask.push_back(true);
+  pinocchio::Transform3f localFrame(1), globalFrame(1);
+  localFrame.translation(offset);
+  globalFrame.translation(ppos);
+  const constraints::DifferentiableFunctionPtr_t& function =
+      constraints::Position::create(rootJointName, fullBody->device_, effectorJoint,
+                                    effectorFrame.pinocchio().placement * localFrame, globalFrame, mask);
+  constraints::ComparisonTypes_t comp (function->outputDerivativeSize(), constraints::EqualToZero);
+  proj->add(constraints::Implicit::create(function, comp));
   res.success_ = proj->apply(configuration);
   res.result_ = currentState;
   res.result_.configuration_ = configuration;
   return res;
 }
 
+ProjectionReport projectToRootConfiguration(const KinematicContextPtr_t& context,
+                                            const pinocchio::ConfigurationIn_t conf,
+                                            const hpp::rbprm::State& currentState) {
+  ProjectionReport res;
+  pinocchio::Configuration_t configuration = currentState.configuration_;
+  ProjectorCache::Key key(ProjectorCache::ROOT_CONFIGURATION);
+  bool created;
+  ProjectorCache::Entry& entry = CachedContactProjector(context, currentState, key, 1e-4, 100, created);
+  if (created)
+    LockFromRoot(context->device(), context->fullBody()->GetLimbs(), conf, entry.projector_, entry.lockedJoints_);
+  for (std::size_t i = 0; i < entry.lockedJoints_.size(); ++i)
+    entry.projector_->rightHandSideFromConfig(entry.lockedJoints_[i], conf);
+  res.success_ = entry.projector_->apply(configuration);
+  res.result_ = currentState;
+  res.result_.configuration_ = configuration;
+  return res;
+}
+
 ProjectionReport setCollisionFree(hpp::rbprm::RbPrmFullBodyPtr_t fullBody,
                                   const core::CollisionValidationPtr_t& validation, const std::string& limbName,
                                   const hpp::rbprm::State& currentState) {
@@ -299,46 +393,16 @@ std::vector<bool> setTranslationConstraints() {
   }
   return res;
 }
-ProjectionReport projectEffector(hpp::core::ConfigProjectorPtr_t proj, const hpp::rbprm::RbPrmFullBodyPtr_t& body,
-                                 const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
-                                 core::CollisionValidationPtr_t validation,
-                                 pinocchio::ConfigurationOut_t configuration, const fcl::Matrix3f& rotationTarget,
-                                 std::vector<bool> rotationFilter, const fcl::Vec3f& positionTarget,
-                                 const fcl::Vec3f& normal, const hpp::rbprm::State& current) {
-  // hppDout(notice,"Project effector : ");
+// applies proj to configuration, in which the effector of limb is constrained, and adds the contact of limb
+// to current if the configuration found is collision free
+ProjectionReport ApplyEffectorProjection(hpp::core::ConfigProjectorPtr_t proj, const KinematicContextPtr_t& context,
+                                         const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                         core::CollisionValidationPtr_t validation,
+                                         pinocchio::ConfigurationOut_t configuration, const fcl::Vec3f& normal,
+                                         const hpp::rbprm::State& current) {
   ProjectionReport rep;
-  // Add constraints to resolve Ik
   rep.success_ = false;
   rep.result_ = current;
-  // Add constraints to resolve Ik
-  hppDout(notice, "Project effector to position : " << positionTarget);
-  if (body->usePosturalTaskContactCreation()) rotationFilter[2] = false;
-
-  const pinocchio::Frame effectorFrame = body->device_->getFrameByName(limb->effector_.name());
-  pinocchio::JointPtr_t effectorJoint = effectorFrame.joint();
-  Transform3f localFrame(1), globalFrame(1);
-  localFrame = effectorFrame.pinocchio().placement * localFrame;
-  globalFrame.translation(positionTarget);
-  const constraints::DifferentiableFunctionPtr_t& function = constraints::Position::create("", body->device_, effectorJoint, localFrame,
-                                                                        globalFrame, setTranslationConstraints());
-  constraints::ComparisonTypes_t comp (function->outputDerivativeSize(), constraints::EqualToZero);
-  proj->add(constraints::Implicit::create(function, comp));
-  if (limb->contactType_ == hpp::rbprm::_6_DOF) {
-    // localFrame.rotation(effectorFrame.pinocchio().placement.rotation() * rotationTarget.transpose());
-    globalFrame.rotation(rotationTarget);
-    const constraints::DifferentiableFunctionPtr_t& function_ = constraints::Orientation::create(
-            "", body->device_, effectorJoint, localFrame, globalFrame, rotationFilter);
-    constraints::ComparisonTypes_t comp_ (function_->outputDerivativeSize(), constraints::EqualToZero);
-    proj->add(constraints::Implicit::create( function_, comp_));
-  }
-
-  if (body->usePosturalTaskContactCreation()) {
-    CreatePosturalTaskConstraint(body, proj);
-    proj->errorThreshold(1e-3);
-    proj->maxIterations(1000);
-    proj->lastIsOptional(true);
-  }
-
 #ifdef PROFILE
   RbPrmProfiler& watch = getRbPrmProfiler();
   watch.start("ik");
@@ -359,12 +423,12 @@ ProjectionReport projectEffector(hpp::core::ConfigProjectorPtr_t proj, const hpp
       watch.stop("collision");
 #endif
       hppDout(notice, "Projection successfull, add new contact info :");
-      body->device_->currentConfiguration(configuration);
-      body->device_->computeForwardKinematics();
+      context->setConfiguration(configuration);
+      const pinocchio::Transform3f effectorTransform = context->effectorTransformation(limb);
       State tmp(current);
       tmp.contacts_[limbId] = true;
-      tmp.contactPositions_[limbId] = limb->effector_.currentTransformation().translation();
-      tmp.contactRotation_[limbId] = limb->effector_.currentTransformation().rotation();
+      tmp.contactPositions_[limbId] = effectorTransform.translation();
+      tmp.contactRotation_[limbId] = effectorTransform.rotation();
       tmp.contactNormals_[limbId] = normal;
       tmp.contactOrder_.push(limbId);
       tmp.configuration_ = configuration;
@@ -387,24 +451,74 @@ ProjectionReport projectEffector(hpp::core::ConfigProjectorPtr_t proj, const hpp
   return rep;
 }
 
-fcl::Transform3f computeProjectionMatrix(const hpp::rbprm::RbPrmFullBodyPtr_t& body,
-                                         const hpp::rbprm::RbPrmLimbPtr_t& limb,
+ProjectionReport projectEffector(hpp::core::ConfigProjectorPtr_t proj, const KinematicContextPtr_t& context,
+                                 const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                 core::CollisionValidationPtr_t validation,
+                                 pinocchio::ConfigurationOut_t configuration, const fcl::Matrix3f& rotationTarget,
+                                 std::vector<bool> rotationFilter, const fcl::Vec3f& positionTarget,
+                                 const fcl::Vec3f& normal, const hpp::rbprm::State& current) {
+  const hpp::rbprm::RbPrmFullBodyPtr_t& body = context->fullBody();
+  const pinocchio::DevicePtr_t& device = context->device();
+  // hppDout(notice,"Project effector : ");
+  // Add constraints to resolve Ik
+  hppDout(notice, "Project effector to position : " << positionTarget);
+  if (body->usePosturalTaskContactCreation()) rotationFilter[2] = false;
+
+  const pinocchio::Frame effectorFrame = context->effector(limb);
+  pinocchio::JointPtr_t effectorJoint = effectorFrame.joint();
+  Transform3f localFrame(1), globalFrame(1);
+  localFrame = effectorFrame.pinocchio().placement * localFrame;
+  globalFrame.translation(positionTarget);
+  const constraints::DifferentiableFunctionPtr_t& function = constraints::Position::create("", device, effectorJoint, localFrame,
+                                                                        globalFrame, setTranslationConstraints());
+  constraints::ComparisonTypes_t comp (function->outputDerivativeSize(), constraints::EqualToZero);
+  proj->add(constraints::Implicit::create(function, comp));
+  if (limb->contactType_ == hpp::rbprm::_6_DOF) {
+    // localFrame.rotation(effectorFrame.pinocchio().placement.rotation() * rotationTarget.transpose());
+    globalFrame.rotation(rotationTarget);
+    const constraints::DifferentiableFunctionPtr_t& function_ = constraints::Orientation::create(
+            "", device, effectorJoint, localFrame, globalFrame, rotationFilter);
+    constraints::ComparisonTypes_t comp_ (function_->outputDerivativeSize(), constraints::EqualToZero);
+    proj->add(constraints::Implicit::create( function_, comp_));
+  }
+
+  if (body->usePosturalTaskContactCreation()) {
+    CreatePosturalTaskConstraint(body, device, proj);
+    proj->errorThreshold(1e-3);
+    proj->maxIterations(1000);
+    proj->lastIsOptional(true);
+  }
+
+  return ApplyEffectorProjection(proj, context, limbId, limb, validation, configuration, normal, current);
+}
+
+ProjectionReport projectEffector(hpp::core::ConfigProjectorPtr_t proj, const hpp::rbprm::RbPrmFullBodyPtr_t& body,
+                                 const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                 core::CollisionValidationPtr_t validation,
+                                 pinocchio::ConfigurationOut_t configuration, const fcl::Matrix3f& rotationTarget,
+                                 std::vector<bool> rotationFilter, const fcl::Vec3f& positionTarget,
+                                 const fcl::Vec3f& normal, const hpp::rbprm::State& current) {
+  return projectEffector(proj, KinematicContext::shared(body), limbId, limb, validation, configuration,
+                         rotationTarget, rotationFilter, positionTarget, normal, current);
+}
+
+fcl::Transform3f computeProjectionMatrix(const KinematicContextPtr_t& context, const hpp::rbprm::RbPrmLimbPtr_t& limb,
                                          const pinocchio::ConfigurationIn_t configuration, const fcl::Vec3f& normal,
                                          const fcl::Vec3f& position, const fcl::Matrix3f& rotation) {
   // hppDout(notice,"computeProjection matrice : normal = "<<normal.transpose());
-  body->device_->currentConfiguration(configuration);
-  body->device_->computeForwardKinematics();
+  context->setConfiguration(configuration);
+  const fcl::Matrix3f effectorRotation = context->effectorTransformation(limb).rotation();
   // the normal is given by the normal of the contacted object
   // hppDout(notice,"effector rot : \n"<<limb->effector_.currentTransformation().rotation());
   // hppDout(notice,"limb normal : "<<limb->normal_.transpose());
-  const fcl::Vec3f z = limb->effector_.currentTransformation().rotation() * limb->normal_;
+  const fcl::Vec3f z = effectorRotation * limb->normal_;
   fcl::Matrix3f rot;
   hppDout(notice, "in computeProjectionMatrix, desired rotation = \n" << rotation);
   if (rotation.isZero(0)) {
     // hppDout(notice,"z = "<<z.transpose());
     const fcl::Matrix3f alignRotation = tools::GetRotationMatrix(z, normal);
     // hppDout(notice,"alignRotation : \n"<<alignRotation);
-    rot = alignRotation * limb->effector_.currentTransformation().rotation();
+    rot = alignRotation * effectorRotation;
   } else {
     rot = rotation;
   }
@@ -415,17 +529,57 @@ fcl::Transform3f computeProjectionMatrix(const hpp::rbprm::RbPrmFullBodyPtr_t& b
   return fcl::Transform3f(rot, posOffset);
 }
 
-ProjectionReport projectToObstacle(core::ConfigProjectorPtr_t proj, const hpp::rbprm::RbPrmFullBodyPtr_t& body,
+fcl::Transform3f computeProjectionMatrix(const hpp::rbprm::RbPrmFullBodyPtr_t& body,
+                                         const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                         const pinocchio::ConfigurationIn_t configuration, const fcl::Vec3f& normal,
+                                         const fcl::Vec3f& position, const fcl::Matrix3f& rotation) {
+  return computeProjectionMatrix(KinematicContext::shared(body), limb, configuration, normal, position, rotation);
+}
+
+ProjectionReport projectToObstacle(core::ConfigProjectorPtr_t proj, const KinematicContextPtr_t& context,
                                    const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
                                    core::CollisionValidationPtr_t validation,
                                    pinocchio::ConfigurationOut_t configuration, const hpp::rbprm::State& current,
                                    const fcl::Vec3f& normal, const fcl::Vec3f& position,
                                    const fcl::Matrix3f& rotation = fcl::Matrix3f::Zero()) {
-  fcl::Transform3f pM = computeProjectionMatrix(body, limb, configuration, normal, position, rotation);
-  return projectEffector(proj, body, limbId, limb, validation, configuration, pM.getRotation(),
+  fcl::Transform3f pM = computeProjectionMatrix(context, limb, configuration, normal, position, rotation);
+  return projectEffector(proj, context, limbId, limb, validation, configuration, pM.getRotation(),
                          setRotationConstraints(), pM.getTranslation(), normal, current);
 }
 
+// adds to the projector of entry the constraints on the position and, for a 6D contact, on the orientation
+// of the effector of limb, their targets being set by projectToCachedTarget
+void AddEffectorTarget(const KinematicContextPtr_t& context, const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                       ProjectorCache::Entry& entry) {
+  const pinocchio::Frame effectorFrame = context->effector(limb);
+  entry.target_ =
+      CreatePositionTarget(context->device(), effectorFrame.joint(), effectorFrame.pinocchio().placement);
+  entry.projector_->add(entry.target_);
+  if (limb->contactType_ == hpp::rbprm::_6_DOF) {
+    entry.targetOrientation_ =
+        CreateOrientationTarget(context->device(), effectorFrame.joint(), effectorFrame.pinocchio().placement);
+    entry.projector_->add(entry.targetOrientation_);
+  }
+}
+
+// same as projectToObstacle with the projector of entry, built with AddEffectorTarget.
+// The locked joints of entry are locked to the current configuration of the device of context.
+ProjectionReport projectToCachedTarget(ProjectorCache::Entry& entry, const KinematicContextPtr_t& context,
+                                       const std::string& limbId, const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                       core::CollisionValidationPtr_t validation,
+                                       pinocchio::ConfigurationOut_t configuration, const hpp::rbprm::State& current,
+                                       const fcl::Vec3f& normal, const fcl::Vec3f& position,
+                                       const fcl::Matrix3f& rotation) {
+  // read before the configuration of the device is modified by computeProjectionMatrix
+  const core::Configuration_t lockedConfiguration = context->device()->currentConfiguration();
+  for (std::size_t i = 0; i < entry.lockedJoints_.size(); ++i)
+    entry.projector_->rightHandSideFromConfig(entry.lockedJoints_[i], lockedConfiguration);
+  fcl::Transform3f pM = computeProjectionMatrix(context, limb, configuration, normal, position, rotation);
+  entry.projector_->rightHandSide(entry.target_, pM.getTranslation());
+  if (entry.targetOrientation_) SetOrientationTarget(entry.projector_, entry.targetOrientation_, pM.getRotation());
+  return ApplyEffectorProjection(entry.projector_, context, limbId, limb, validation, configuration, normal, current);
+}
+
 // are p1 and p2 on the same side of the line AB ?
 bool SameSide(const fcl::Vec3f& p1, const fcl::Vec3f& p2, const fcl::Vec3f& a, const fcl::Vec3f& b) {
   fcl::Vec3f cp1 = (b - a).cross(p1 - a);
@@ -515,21 +669,17 @@ fcl::Vec3f closestPointInTriangle(const fcl::Vec3f& sourcePosition, const fcl::V
   return res + (res - sourcePosition).normalized() * epsilon;
 }
 
-ProjectionReport projectSampleToObstacle(const hpp::rbprm::RbPrmFullBodyPtr_t& body, const std::string& limbId,
-                                         const hpp::rbprm::RbPrmLimbPtr_t& limb, const sampling::OctreeReport& report,
-                                         core::CollisionValidationPtr_t validation,
-                                         pinocchio::ConfigurationOut_t configuration,
-                                         const hpp::rbprm::State& current) {
-  sampling::Load(*report.sample_, configuration);
+// projects a sample loaded in configuration, rootT being the transformation of the parent joint of the limb
+ProjectionReport projectLoadedSampleToObstacle(const KinematicContextPtr_t& context, const std::string& limbId,
+                                               const hpp::rbprm::RbPrmLimbPtr_t& limb,
+                                               const sampling::OctreeReport& report,
+                                               core::CollisionValidationPtr_t validation,
+                                               pinocchio::ConfigurationOut_t configuration,
+                                               const hpp::rbprm::State& current, const Transform3f& rootT) {
   fcl::Vec3f normal = report.normal_;
   normal.normalize();
   // value_type epsilon = 0.01;
   // hppDout(notice,"contact normal = "<<normal);
-  Transform3f rootT;
-  if (body->GetLimb(limbId)->limb_->parentJoint())
-    rootT = body->GetLimb(limbId)->limb_->parentJoint()->currentTransformation();
-  else
-    rootT = body->GetLimb(limbId)->limb_->currentTransformation();
   // compute the orthogonal projection of the end effector on the plan :
   const fcl::Vec3f pEndEff =
       (rootT.act(report.sample_->effectorPosition_));  // compute absolute position (in world frame)
@@ -546,9 +696,56 @@ ProjectionReport projectSampleToObstacle(const hpp::rbprm::RbPrmFullBodyPtr_t& b
   // hppDout(notice,"Effector position : "<<report.sample_->effectorPosition_);
   // hppDout(notice,"pEndEff = ["<<pEndEff[0]<<","<<pEndEff[1]<<","<<pEndEff[2]<<"]");
   // hppDout(notice,"pos = ["<<pos[0]<<","<<pos[1]<<","<<pos[2]<<"]");
-  core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(body->device_, "proj", 1e-4, 100);
-  hpp::tools::LockJointRec(limb->limb_->name(), body->device_->rootJoint(), proj);
-  return projectToObstacle(proj, body, limbId, limb, validation, configuration, current, normal, pos);
+  if (context->fullBody()->usePosturalTaskContactCreation()) {
+    core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(context->device(), "proj", 1e-4, 100);
+    hpp::tools::LockJointRec(limb->limb_->name(), context->device()->rootJoint(), proj);
+    return projectToObstacle(proj, context, limbId, limb, validation, configuration, current, normal, pos);
+  }
+  ProjectorCache::Key key(ProjectorCache::SAMPLE_TO_OBSTACLE);
+  key.limb_ = limbId;
+  key.lockOtherJoints_ = true;
+  ProjectorCache::Entry* entry = context->projectorCache()->find(key);
+  if (!entry) {
+    entry = &context->projectorCache()->add(key);
+    entry->projector_ = core::ConfigProjector::create(context->device(), "proj", 1e-4, 100);
+    hpp::tools::LockJointRec(limb->limb_->name(), context->device()->rootJoint(), entry->projector_,
+                             &entry->lockedJoints_, constraints::Equality);
+    AddEffectorTarget(context, limb, *entry);
+  }
+  return projectToCachedTarget(*entry, context, limbId, limb, validation, configuration, current, normal, pos,
+                               fcl::Matrix3f::Zero());
+}
+
+ProjectionReport projectSampleToObstacle(const hpp::rbprm::RbPrmFullBodyPtr_t& body, const std::string& limbId,
+                                         const hpp::rbprm::RbPrmLimbPtr_t& limb, const sampling::OctreeReport& report,
+                                         core::CollisionValidationPtr_t validation,
+                                         pinocchio::ConfigurationOut_t configuration,
+                                         const hpp::rbprm::State& current) {
+  sampling::Load(*report.sample_, configuration);
+  Transform3f rootT;
+  if (body->GetLimb(limbId)->limb_->parentJoint())
+    rootT = body->GetLimb(limbId)->limb_->parentJoint()->currentTransformation();
+  else
+    rootT = body->GetLimb(limbId)->limb_->currentTransformation();
+  return projectLoadedSampleToObstacle(KinematicContext::shared(body), limbId, limb, report, validation,
+                                       configuration, current, rootT);
+}
+
+ProjectionReport projectSampleToObstacle(const KinematicContextPtr_t& context, const std::string& limbId,
+                                         const hpp::rbprm::RbPrmLimbPtr_t& limb, const sampling::OctreeReport& report,
+                                         core::CollisionValidationPtr_t validation,
+                                         pinocchio::ConfigurationOut_t configuration,
+                                         const hpp::rbprm::State& current) {
+  sampling::Load(*report.sample_, configuration);
+  // the joints out of the limb are locked to their value in configuration
+  context->setConfiguration(configuration);
+  const pinocchio::JointPtr_t limbJoint = context->joint(limb->limb_);
+  Transform3f rootT;
+  if (limbJoint->parentJoint())
+    rootT = limbJoint->parentJoint()->currentTransformation();
+  else
+    rootT = limbJoint->currentTransformation();
+  return projectLoadedSampleToObstacle(context, limbId, limb, report, validation, configuration, current, rootT);
 }
 
 ProjectionReport projectStateToObstacle(const hpp::rbprm::RbPrmFullBodyPtr_t& body, const std::string& limbId,
@@ -568,29 +765,49 @@ ProjectionReport projectStateToObstacle(const hpp::rbprm::RbPrmFullBodyPtr_t& bo
   hpp::rbprm::State state = current;
   state.RemoveContact(limbId);
   pinocchio::Configuration_t configuration = current.configuration_;
+  if (!body->usePosturalTaskContactCreation()) {
+    const KinematicContextPtr_t context = KinematicContext::shared(body);
+    ProjectorCache::Key key(ProjectorCache::STATE_TO_OBSTACLE);
+    key.limb_ = limbId;
+    key.lockOtherJoints_ = lockOtherJoints;
+    bool created;
+    ProjectorCache::Entry& entry = CachedContactProjector(context, state, key, 1e-4, 1000, created);
+    if (created) {
+      if (lockOtherJoints)
+        hpp::tools::LockJointRec(limb->limb_->name(), body->device_->rootJoint(), entry.projector_,
+                                 &entry.lockedJoints_, constraints::Equality);
+      AddEffectorTarget(context, limb, entry);
+    }
+    return projectToCachedTarget(entry, context, limbId, limb, validation, configuration, state, normal, position,
+                                 rotation);
+  }
   core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(body->device_, "proj", 1e-4, 1000);
   interpolation::addContactConstraints(body, body->device_, proj, state, state.fixedContacts(state));
   if (lockOtherJoints) {  // lock all joints expect the ones of the moving limb
     hpp::tools::LockJointRec(limb->limb_->name(), body->device_->rootJoint(), proj);
   }
   // get current normal orientation
-  return projectToObstacle(proj, body, limbId, limb, validation, configuration, state, normal, position, rotation);
+  return projectToObstacle(proj, KinematicContext::shared(body), limbId, limb, validation, configuration, state,
+                           normal, position, rotation);
 }
 
 ProjectionReport projectToComPosition(hpp::rbprm::RbPrmFullBodyPtr_t fullBody, const fcl::Vec3f& target,
                                       const hpp::rbprm::State& currentState) {
   ProjectionReport res;
-  core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(fullBody->device_, "proj", 1e-4, 1000);
-  CreateContactConstraints(fullBody, currentState, proj);
-  CreateComPosConstraint(fullBody, target, proj);
+  ProjectorCache::Key key(ProjectorCache::COM_POSITION);
+  bool created;
+  ProjectorCache::Entry& entry =
+      CachedContactProjector(KinematicContext::shared(fullBody), currentState, key, 1e-4, 1000, created);
+  if (created) entry.target_ = CreateComPosConstraint(fullBody, target, entry.projector_);
   /* CreatePosturalTaskConstraint(fullBody,proj);
    proj->lastIsOptional(true);
    proj->numOptimize(500);
    proj->lastAsCost(false);
    proj->errorThreshold(1e-3);*/
+  entry.projector_->rightHandSide(entry.target_, target);
 
   pinocchio::Configuration_t configuration = currentState.configuration_;
-  res.success_ = proj->apply(configuration);
+  res.success_ = entry.projector_->apply(configuration);
   res.result_ = currentState;
   res.result_.configuration_ = configuration;
   return res;
@@ -608,7 +825,7 @@ ProjectionReport projectToColFreeComPosition(hpp::rbprm::RbPrmFullBodyPtr_t full
   core::ConfigProjectorPtr_t proj = core::ConfigProjector::create(fullBody->device_, "proj", 1e-3, 1000);
   CreateContactConstraints(fullBody, currentState, proj);
   CreateComPosConstraint(fullBody, target, proj);
-  CreatePosturalTaskConstraint(fullBody, proj);
+  CreatePosturalTaskConstraint(fullBody, fullBody->device_, proj);
   proj->lastIsOptional(true);
   // proj->numOptimize(500);
   proj->maxIterations(500);
@@ -0,0 +1,47 @@
+// Copyright (c) 2026, LAAS-CNRS
+// Authors: Steve Tonneau, Pierre Fernbach
+//
+// This file is part of hpp-rbprm.
+// hpp-rbprm is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-rbprm is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-rbprm. If not, see <http://www.gnu.org/licenses/>.
+
+#include <hpp/rbprm/projection/projector-cache.hh>
+
+namespace hpp {
+namespace rbprm {
+namespace projection {
+
+bool ProjectorCache::Key::operator<(const Key& other) const {
+  if (type_ != other.type_) return type_ < other.type_;
+  if (lockOtherJoints_ != other.lockOtherJoints_) return lockOtherJoints_ < other.lockOtherJoints_;
+  if (limb_ != other.limb_) return limb_ < other.limb_;
+  return contacts_ < other.contacts_;
+}
+
+ProjectorCachePtr_t ProjectorCache::create(const std::size_t maxSize) {
+  return ProjectorCachePtr_t(new ProjectorCache(maxSize));
+}
+
+ProjectorCache::Entry* ProjectorCache::find(const Key& key) {
+  std::map<Key, Entry>::iterator it = entries_.find(key);
+  if (it == entries_.end()) return 0;
+  return &(it->second);
+}
+
+ProjectorCache::Entry& ProjectorCache::add(const Key& key) {
+  if (entries_.size() >= maxSize_) entries_.clear();
+  return entries_[key];
+}
+
+}  // namespace projection
+}  // namespace rbprm
+}  // namespace hpp
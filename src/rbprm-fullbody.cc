@@ -99,6 +99,8 @@ void RbPrmFullBody::AddLimbPrivate(rbprm::RbPrmLimbPtr_t limb, const std::string
     nonContactingLimbs_.insert(std::make_pair(id, limb));
   else
     limbs_.insert(std::make_pair(id, limb));
+  // the cached projectors were built for the previous set of limbs
+  projectorCache_->clear();
   // tools::RemoveNonLimbCollisionRec<core::CollisionValidation>(device_->rootJoint(),name,collisionObjects,*limbcollisionValidation_.get());
   hpp::core::RelativeMotion::matrix_type m = hpp::core::RelativeMotion::matrix(device_);
   limbcollisionValidation_->filterCollisionPairs(m);
@@ -134,13 +136,14 @@ void RbPrmFullBody::AddLimb(const std::string& id, const std::string& name, cons
                             const double x, const double y, const hpp::core::ObjectStdVector_t& collisionObjects,
                             const std::size_t nbSamples, const std::string& heuristicName, const double resolution,
                             ContactType contactType, const bool disableEffectorCollision, const bool grasp,
-                            const std::string& kinematicConstraintsPath, const double kinematicConstraintsMin) {
+                            const std::string& kinematicConstraintsPath, const double kinematicConstraintsMin,
+                            const std::size_t nbThreads, const unsigned int seed) {
   std::map<std::string, const sampling::heuristic>::const_iterator hit =
       checkLimbData(id, limbs_, factory_, heuristicName);
   pinocchio::JointPtr_t joint = device_->getJointByName(name);
   rbprm::RbPrmLimbPtr_t limb = rbprm::RbPrmLimb::create(
       joint, effectorName, offset, limbOffset, normal, x, y, nbSamples, hit->second, resolution, contactType,
-      disableEffectorCollision, grasp, kinematicConstraintsPath, kinematicConstraintsMin);
+      disableEffectorCollision, grasp, kinematicConstraintsPath, kinematicConstraintsMin, nbThreads, seed);
   AddLimbPrivate(limb, id, name, collisionObjects, disableEffectorCollision);
 }
 
@@ -161,12 +164,17 @@ void RbPrmFullBody::AddLimb(const std::string& database, const std::string& id,
                             const bool loadValues, const bool disableEffectorCollision, const bool grasp) {
   std::map<std::string, const sampling::heuristic>::const_iterator hit =
       checkLimbData(id, limbs_, factory_, heuristicName);
-  ;
-  std::ifstream myfile(database.c_str());
-  if (!myfile.good()) throw std::runtime_error("Impossible to open database");
-  rbprm::RbPrmLimbPtr_t limb =
-      rbprm::RbPrmLimb::create(device_, myfile, loadValues, hit->second, disableEffectorCollision, grasp);
-  myfile.close();
+  rbprm::RbPrmLimbPtr_t limb;
+  if (tools::io::isBinaryDatabase(database)) {
+    tools::io::MappedFile mappedFile(database);
+    tools::io::BinaryReader reader(mappedFile.data(), mappedFile.size());
+    limb = rbprm::RbPrmLimb::create(device_, reader, loadValues, hit->second, disableEffectorCollision, grasp);
+  } else {
+    std::ifstream myfile(database.c_str());
+    if (!myfile.good()) throw std::runtime_error("Impossible to open database");
+    limb = rbprm::RbPrmLimb::create(device_, myfile, loadValues, hit->second, disableEffectorCollision, grasp);
+    myfile.close();
+  }
   AddLimbPrivate(limb, id, limb->limb_->name(), collisionObjects, disableEffectorCollision);
 }
 
@@ -300,7 +308,9 @@ RbPrmFullBody::RbPrmFullBody(const pinocchio::DevicePtr_t& device)
       reference_(device_->neutralConfiguration()),
       postureWeights_(),
       usePosturalTaskContactCreation_(false),
+      maxContactCandidates_(0),
       effectorsTrajectoriesMaps_(),
+      projectorCache_(projection::ProjectorCache::create()),
       weakPtr_() {
   hppDout(notice, "Neutralconfig when creating fullBody : " << pinocchio::displayConfig(reference_));
 }
@@ -29,10 +29,12 @@ RbPrmLimbPtr_t RbPrmLimb::create(const pinocchio::JointPtr_t limb, const std::st
                                  const hpp::rbprm::sampling::heuristic evaluate, const double resolution,
                                  hpp::rbprm::ContactType contactType, const bool disableEffectorCollision,
                                  const bool grasp, const std::string& kinematicsConstraintsPath,
-                                 const double kinematicConstraintsMinDistance) {
+                                 const double kinematicConstraintsMinDistance, const std::size_t nbThreads,
+                                 const unsigned int seed) {
   RbPrmLimb* rbprmDevice =
       new RbPrmLimb(limb, effectorName, offset, limbOffset, normal, x, y, nbSamples, evaluate, resolution, contactType,
-                    disableEffectorCollision, grasp, kinematicsConstraintsPath, kinematicConstraintsMinDistance);
+                    disableEffectorCollision, grasp, kinematicsConstraintsPath, kinematicConstraintsMinDistance,
+                    nbThreads, seed);
   RbPrmLimbPtr_t res(rbprmDevice);
   res->init(res);
   return res;
@@ -47,6 +49,17 @@ RbPrmLimbPtr_t RbPrmLimb::create(const pinocchio::DevicePtr_t device, std::ifstr
   return res;
 }
 
+RbPrmLimbPtr_t RbPrmLimb::create(const pinocchio::DevicePtr_t device, tools::io::BinaryReader& reader,
+                                 const bool loadValues, const hpp::rbprm::sampling::heuristic evaluate,
+                                 const bool disableEffectorCollision, const bool grasp) {
+  const uint64_t version = tools::io::readBinaryHeader(reader);
+  RbPrmLimb* rbprmDevice =
+      new RbPrmLimb(device, reader, version, loadValues, evaluate, disableEffectorCollision, grasp);
+  RbPrmLimbPtr_t res(rbprmDevice);
+  res->init(res);
+  return res;
+}
+
 RbPrmLimb::~RbPrmLimb() {
   // NOTHING
 }
@@ -98,7 +111,8 @@ RbPrmLimb::RbPrmLimb(const pinocchio::JointPtr_t& limb, const std::string& effec
                      const fcl::Vec3f& limbOffset, const fcl::Vec3f& normal, const double x, const double y,
                      const std::size_t nbSamples, const hpp::rbprm::sampling::heuristic evaluate,
                      const double resolution, ContactType contactType, bool disableEndEffectorCollision, bool grasps,
-                     const std::string& kinematicsConstraintsPath, const double kinematicConstraintsMinDistance)
+                     const std::string& kinematicsConstraintsPath, const double kinematicConstraintsMinDistance,
+                     const std::size_t nbThreads, const unsigned int seed)
     : limb_(limb),
       effector_(GetEffector(limb, effectorName)),
       effectorDefaultRotation_(GetEffectorTransform(effector_)),
@@ -111,7 +125,8 @@ RbPrmLimb::RbPrmLimb(const pinocchio::JointPtr_t& limb, const std::string& effec
       y_(y),
       contactType_(contactType),
       evaluate_(evaluate),
-      sampleContainer_(limb, effector_.name(), nbSamples, offset, limbOffset, resolution),
+      sampleContainer_(limb, effector_.name(), nbSamples, offset, limbOffset, resolution, sampling::T_evaluate(), "",
+                       nbThreads, seed),
       disableEndEffectorCollision_(disableEndEffectorCollision),
       grasps_(grasps),
       effectorReferencePosition_(computeEffectorReferencePosition(limb, effectorName)),
@@ -145,6 +160,20 @@ bool saveLimbInfoAndDatabase(const hpp::rbprm::RbPrmLimbPtr_t limb, std::ofstrea
   fp << (int)limb->contactType_ << std::endl;
   return sampling::saveLimbDatabase(limb->sampleContainer_, fp);
 }
+
+bool saveLimbInfoAndDatabaseBinary(const hpp::rbprm::RbPrmLimbPtr_t limb, std::ofstream& fp) {
+  tools::io::BinaryWriter writer(fp);
+  tools::io::writeBinaryHeader(writer);
+  writer.writeString(limb->limb_->name());
+  writer.writeString(limb->effector_.name());
+  writer.writeRotMatrixFCL(limb->effectorDefaultRotation_);
+  writer.writeVecFCL(limb->offset_);
+  writer.writeVecFCL(limb->normal_);
+  writer.writeDouble(limb->x_);
+  writer.writeDouble(limb->y_);
+  writer.writeU64((uint64_t)limb->contactType_);
+  return sampling::saveLimbDatabaseBinary(limb->sampleContainer_, writer);
+}
 }  // namespace rbprm
 
 namespace tools {
@@ -191,4 +220,26 @@ hpp::rbprm::RbPrmLimb::RbPrmLimb(const pinocchio::DevicePtr_t device, std::ifstr
           0.3)) {
   // NOTHING
 }
+
+hpp::rbprm::RbPrmLimb::RbPrmLimb(const pinocchio::DevicePtr_t device, BinaryReader& reader, const uint64_t version,
+                                 const bool loadValues, const hpp::rbprm::sampling::heuristic evaluate,
+                                 bool disableEndEffectorCollision, bool grasps)
+    : limb_(device->getJointByName(reader.readString())),
+      effector_(device->getFrameByName(reader.readString())),
+      effectorDefaultRotation_(reader.readRotMatrixFCL()),
+      offset_(reader.readVecFCL()),
+      normal_(reader.readVecFCL()),
+      x_(reader.readDouble()),
+      y_(reader.readDouble()),
+      contactType_(static_cast<hpp::rbprm::ContactType>(reader.readU64())),
+      evaluate_(evaluate),
+      sampleContainer_(reader, version, loadValues),
+      disableEndEffectorCollision_(disableEndEffectorCollision),
+      grasps_(grasps),
+      effectorReferencePosition_(computeEffectorReferencePosition(limb_, effector_.name())),
+      kinematicConstraints_(reachability::loadConstraintsFromObj(
+          "package://" + limb_->robot()->name() + "-rbprm/com_inequalities/" + limb_->name() + "_com_constraints.obj",
+          0.3)) {
+  // NOTHING
+}
 }  // namespace hpp
@@ -22,6 +22,10 @@
 #include <hpp/core/path-validation-report.hh>
 #include <hpp/core/validation-report.hh>
 #include <hpp/core/collision-path-validation-report.hh>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
 
 namespace hpp {
 namespace rbprm {
@@ -37,16 +41,155 @@ RbPrmPathValidationPtr_t RbPrmPathValidation::create(const core::DevicePtr_t& ro
 }
 
 RbPrmPathValidation::RbPrmPathValidation(const core::DevicePtr_t& /*robot*/, const core::value_type& stepSize)
-    : core::pathValidation::Discretized(stepSize) {}
+    : core::pathValidation::Discretized(stepSize),
+      adaptiveStep_(false),
+      bisectionOrder_(false),
+      velocityBound_(0.),
+      angularVelocityBound_(0.),
+      maxStepSize_(stepSize),
+      tolerance_(0.) {}
 
 void RbPrmPathValidation::add(const core::ConfigValidationPtr_t& configValidation) {
   core::pathValidation::Discretized::add(configValidation);
   rbprmValidation_ = std::dynamic_pointer_cast<RbPrmValidation>(configValidation);
 }
 
+void RbPrmPathValidation::setAdaptiveStep(const value_type velocityBound, const value_type angularVelocityBound,
+                                          const value_type maxStepSize, const value_type tolerance) {
+  if (velocityBound < 0. || angularVelocityBound < 0. || maxStepSize <= 0. || tolerance <= 0.)
+    throw std::runtime_error("RbPrmPathValidation::setAdaptiveStep: negative bound, step or tolerance");
+  adaptiveStep_ = true;
+  velocityBound_ = velocityBound;
+  angularVelocityBound_ = angularVelocityBound;
+  maxStepSize_ = maxStepSize;
+  tolerance_ = tolerance;
+}
+
+bool RbPrmPathValidation::validateConfiguration(const Configuration_t& q, core::ValidationReportPtr_t& report,
+                                                const std::vector<std::string>& filter) {
+  return rbprmValidation_->validate(q, report, filter);
+}
+
+bool RbPrmPathValidation::validateBisection(const core::PathPtr_t& path, bool reverse, core::PathPtr_t* validPart,
+                                            core::PathValidationReportPtr_t& validationReport,
+                                            const std::vector<std::string>& filter) {
+  assert(path);
+  const value_type tmin = path->timeRange().first;
+  const value_type tmax = path->timeRange().second;
+  // sample i is at i * stepSize_ from the start (the end if reverse), the last one at the other end of the path
+  const std::size_t nbSteps = (std::size_t)std::floor((tmax - tmin) / stepSize_);
+  const std::size_t last = (tmin + (value_type)nbSteps * stepSize_ < tmax) ? nbSteps + 1 : nbSteps;
+  std::vector<value_type> times(last + 1);
+  for (std::size_t i = 0; i < last; ++i)
+    times[i] = reverse ? tmax - (value_type)i * stepSize_ : tmin + (value_type)i * stepSize_;
+  times[last] = reverse ? tmin : tmax;
+
+  Configuration_t q(path->outputSize());
+  core::ValidationReportPtr_t configReport, invalidReport;
+  // index of the first invalid sample found so far
+  std::size_t firstInvalid = last + 1;
+  // intervals of samples whose interior is not validated yet
+  std::deque<std::pair<std::size_t, std::size_t> > intervals;
+  intervals.push_back(std::make_pair(0, last));
+  // both ends first
+  const std::size_t ends[2] = {0, last};
+  for (std::size_t i = 0; i < (last > 0 ? 2 : 1) && firstInvalid > last; ++i) {
+    if (!(*path)(q, times[ends[i]]) || !validateConfiguration(q, configReport, filter)) {
+      firstInvalid = ends[i];
+      invalidReport = configReport;
+    }
+  }
+  while (!intervals.empty() && (validPart || firstInvalid > last)) {
+    const std::size_t lower = intervals.front().first;
+    const std::size_t upper = std::min(intervals.front().second, firstInvalid);
+    intervals.pop_front();
+    // the samples after the first invalid one are not needed
+    if (lower + 1 >= upper) continue;
+    const std::size_t mid = (lower + upper) / 2;
+    if (!(*path)(q, times[mid]) || !validateConfiguration(q, configReport, filter)) {
+      firstInvalid = mid;
+      invalidReport = configReport;
+    }
+    intervals.push_back(std::make_pair(lower, mid));
+    intervals.push_back(std::make_pair(mid, upper));
+  }
+  if (firstInvalid > last) {
+    if (validPart) *validPart = path;
+    return true;
+  }
+  validationReport = core::CollisionPathValidationReportPtr_t(
+      new core::CollisionPathValidationReport(times[firstInvalid], invalidReport));
+  if (validPart) {
+    const value_type lastValidTime = times[firstInvalid > 0 ? firstInvalid - 1 : 0];
+    if (reverse)
+      *validPart = path->extract(std::make_pair(lastValidTime, tmax));
+    else
+      *validPart = path->extract(std::make_pair(tmin, lastValidTime));
+  }
+  return false;
+}
+
+bool RbPrmPathValidation::validateConfiguration(const Configuration_t& q, core::ValidationReportPtr_t& report,
+                                                const std::vector<std::string>& filter, value_type& step) {
+  value_type distance, radius;
+  const bool valid = rbprmValidation_->validate(q, report, filter, tolerance_, distance, radius);
+  const value_type velocity = velocityBound_ + angularVelocityBound_ * radius;
+  step = velocity > 0. ? std::min(maxStepSize_, distance / velocity) : maxStepSize_;
+  return valid;
+}
+
+bool RbPrmPathValidation::validateAdaptive(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
+                                           core::PathValidationReportPtr_t& validationReport,
+                                           const std::vector<std::string>& filter) {
+  assert(path);
+  core::ValidationReportPtr_t configReport;
+  const value_type tmin = path->timeRange().first;
+  const value_type tmax = path->timeRange().second;
+  value_type t = reverse ? tmax : tmin;
+  value_type lastValidTime = t;
+  value_type step;
+  Configuration_t q(path->outputSize());
+  while (true) {
+    bool success = (*path)(q, t);
+    if (!success || !validateConfiguration(q, configReport, filter, step)) {
+      validationReport =
+          core::CollisionPathValidationReportPtr_t(new core::CollisionPathValidationReport(t, configReport));
+      if (reverse)
+        validPart = path->extract(std::make_pair(lastValidTime, tmax));
+      else
+        validPart = path->extract(std::make_pair(tmin, lastValidTime));
+      return false;
+    }
+    lastValidTime = t;
+    if (t == (reverse ? tmin : tmax)) break;
+    // the trunk is farther than tolerance from the obstacles, step is strictly positive
+    t = reverse ? std::max(tmin, t - step) : std::min(tmax, t + step);
+  }
+  validPart = path;
+  return true;
+}
+
+bool RbPrmPathValidation::validate(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
+                                   core::PathValidationReportPtr_t& report) {
+  if (adaptiveStep_) return validateAdaptive(path, reverse, validPart, report, rbprmValidation_->defaultFilter_);
+  if (bisectionOrder_) return validateBisection(path, reverse, &validPart, report, rbprmValidation_->defaultFilter_);
+  return core::pathValidation::Discretized::validate(path, reverse, validPart, report);
+}
+
+bool RbPrmPathValidation::isValid(const core::PathPtr_t& path, core::PathValidationReportPtr_t& report) {
+  if (!bisectionOrder_ || adaptiveStep_) {
+    core::PathPtr_t unusedValidPart;
+    return validate(path, false, unusedValidPart, report);
+  }
+  startValidation(path, false);
+  return validateBisection(path, false, NULL, report, rbprmValidation_->defaultFilter_);
+}
+
 bool RbPrmPathValidation::validate(const core::PathPtr_t& path, bool reverse, core::PathPtr_t& validPart,
                                    core::PathValidationReportPtr_t& validationReport,
                                    const std::vector<std::string>& filter) {
+  if (adaptiveStep_) return validateAdaptive(path, reverse, validPart, validationReport, filter);
+  if (bisectionOrder_) return validateBisection(path, reverse, &validPart, validationReport, filter);
   core::ValidationReportPtr_t configReport;
   assert(path);
   bool valid = true;
@@ -41,7 +41,8 @@ bool RbPrmRomValidation::validate(const Configuration_t& config) { return valida
 bool RbPrmRomValidation::validate(const Configuration_t& config, ValidationReportPtr_t& validationReport) {
   ValidationReportPtr_t romReport;
 
-  bool collision = !hpp::core::CollisionValidation::validate(config, romReport);
+  bool collision = broadPhase_ ? !broadPhase_->validate(robot_, *this, config, computeAllContacts_, romReport)
+                               : !hpp::core::CollisionValidation::validate(config, romReport);
   // CollisionValidationReportPtr_t reportCast = boost::dynamic_pointer_cast<CollisionValidationReport>(romReport);
   // hppDout(notice,"number of contacts  : "<<reportCast->result.numContacts());
   // hppDout(notice,"contact 1 "<<reportCast->result.getContact(0).pos);
@@ -18,6 +18,9 @@
 #include <hpp/core/collision-validation.hh>
 #include <hpp/core/joint-bound-validation.hh>
 #include <hpp/rbprm/rbprm-validation-report.hh>
+#include <hpp/pinocchio/device-sync.hh>
+#include <hpp/fcl/distance.h>
+#include <limits>
 
 namespace {
 hpp::core::CollisionValidationPtr_t tuneFclValidation(const hpp::pinocchio::RbPrmDevicePtr_t& robot) {
@@ -166,7 +169,8 @@ bool RbPrmValidation::validate(const Configuration_t& config, hpp::core::Validat
 
   RbprmValidationReportPtr_t rbprmReport(new RbprmValidationReport);
 
-  bool success = trunkValidation_->validate(config, validationReport);
+  bool success = broadPhase_ ? broadPhase_->validate(robot_, *trunkValidation_, config, false, validationReport)
+                             : trunkValidation_->validate(config, validationReport);
   if (success) {
     rbprmReport->trunkInCollision = false;
   } else {
@@ -183,13 +187,61 @@ bool RbPrmValidation::validate(const Configuration_t& config, hpp::core::Validat
   return success;
 }
 
+bool RbPrmValidation::validate(const Configuration_t& config, hpp::core::ValidationReportPtr_t& validationReport,
+                               const std::vector<std::string>& filter, const value_type tolerance,
+                               value_type& trunkDistance, value_type& trunkRadius) {
+  RbprmValidationReportPtr_t rbprmReport(new RbprmValidationReport);
+  trunkDistance = this->trunkDistance(config, trunkRadius, rbprmReport);
+  rbprmReport->trunkInCollision = trunkDistance <= tolerance;
+  bool success = validateRoms(config, filter, rbprmReport) && !rbprmReport->trunkInCollision &&
+                 boundValidation_->validate(config, validationReport);
+  validationReport = rbprmReport;
+  return success;
+}
+
+value_type RbPrmValidation::trunkDistance(const Configuration_t& config, value_type& trunkRadius,
+                                          const CollisionValidationReportPtr_t& closestPair) {
+  value_type trunkDistance = std::numeric_limits<value_type>::infinity();
+  trunkRadius = 0.;
+  pinocchio::DeviceSync device(robot_);
+  device.currentConfiguration(config);
+  device.computeForwardKinematics(pinocchio::JOINT_POSITION);
+  device.updateGeometryPlacements();
+  const fcl::Vec3f root(config.head<3>());
+  const hpp::fcl::DistanceRequest request(false);
+  const CollisionPairs_t& pairs = trunkValidation_->pairs();
+  for (CollisionPairs_t::const_iterator cit = pairs.begin(); cit != pairs.end(); ++cit) {
+    pinocchio::FclConstCollisionObjectPtr_t body = cit->first->fcl(device.d());
+    const hpp::fcl::CollisionGeometry& geometry = *body->collisionGeometry();
+    trunkRadius = std::max(trunkRadius, (body->getTransform().transform(geometry.aabb_center) - root).norm() +
+                                            geometry.aabb_radius);
+    hpp::fcl::DistanceResult result;
+    const value_type distance = hpp::fcl::distance(body, cit->second->fcl(device.d()), request, result);
+    if (distance < trunkDistance) {
+      trunkDistance = distance;
+      if (closestPair) {
+        closestPair->object1 = cit->first;
+        closestPair->object2 = cit->second;
+      }
+    }
+  }
+  return trunkDistance;
+}
+
 bool RbPrmValidation::validateTrunk(const Configuration_t& config,
                                     hpp::core::ValidationReportPtr_t& validationReport) {
+  if (broadPhase_) return broadPhase_->validate(robot_, *trunkValidation_, config, false, validationReport);
   return trunkValidation_->validate(config,
                                     validationReport);  // && boundValidation_->validate(config,validationReport);
 }
 
-void RbPrmValidation::addObstacle(const CollisionObjectConstPtr_t& object) { trunkValidation_->addObstacle(object); }
+void RbPrmValidation::addObstacle(const CollisionObjectConstPtr_t& object) {
+  trunkValidation_->addObstacle(object);
+  if (broadPhase_) {
+    broadPhase_->addObstacle(object);
+    broadPhase_->build();
+  }
+}
 
 void RbPrmValidation::removeObstacleFromJoint(const JointPtr_t& joint, const CollisionObjectPtr_t& obstacle) {
   trunkValidation_->removeObstacleFromJoint(joint, obstacle);
@@ -210,5 +262,20 @@ void RbPrmValidation::computeAllContacts(bool computeAllContacts) {
   }
 }
 
+void RbPrmValidation::useBroadPhase(bool useBroadPhase) {
+  if (useBroadPhase) {
+    broadPhase_ = ObstacleBroadPhase::create();
+    broadPhase_->addObstacles(*trunkValidation_);
+    for (T_RomValidation::const_iterator cit = romValidations_.begin(); cit != romValidations_.end(); ++cit)
+      broadPhase_->addObstacles(*cit->second);
+    // built once here, so that the validations can then run concurrently
+    broadPhase_->build();
+  } else {
+    broadPhase_.reset();
+  }
+  for (T_RomValidation::const_iterator cit = romValidations_.begin(); cit != romValidations_.end(); ++cit)
+    cit->second->broadPhase(broadPhase_);
+}
+
 }  // namespace rbprm
 }  // namespace hpp
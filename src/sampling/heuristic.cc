@@ -16,6 +16,7 @@
 
 #include <hpp/rbprm/sampling/heuristic.hh>
 #include <hpp/rbprm/sampling/heuristic-tools.hh>
+#include <hpp/rbprm/sampling/sample-db.hh>
 #include <hpp/pinocchio/configuration.hh>
 #include <time.h>
 
@@ -244,6 +245,100 @@ double BackwardHeuristic(const sampling::Sample& sample, const Eigen::Vector3d&
          ((double)rand()) / ((double)(RAND_MAX));
 }
 
+// Batch versions of the heuristics above. They work on the columns of the SampleDB,
+// so that Eigen can vectorize the computations over the range of samples.
+// rand () is called in sample order, as when the scalar heuristics are called sample after sample.
+typedef Eigen::Map<Eigen::VectorXd> ValuesView_t;
+
+Eigen::VectorXd randomValues(const std::size_t nbSamples) {
+  Eigen::VectorXd noise(nbSamples);
+  for (std::size_t i = 0; i < nbSamples; ++i) noise[i] = ((double)rand()) / ((double)(RAND_MAX));
+  return noise;
+}
+
+void StaticBatchHeuristic(const SampleDB& database, const std::size_t first, const std::size_t nbSamples,
+                          const Eigen::Vector3d& /*direction*/, const Eigen::Vector3d& /*normal*/,
+                          const HeuristicParam& /*params*/, double* values) {
+  ValuesView_t(values, nbSamples) = database.staticValues_.segment(first, nbSamples);
+}
+
+void EFORTBatchHeuristic(const SampleDB& database, const std::size_t first, const std::size_t nbSamples,
+                         const Eigen::Vector3d& direction, const Eigen::Vector3d& normal,
+                         const HeuristicParam& /*params*/, double* values) {
+  // direction^T * P * direction, with the 3x3 block of P stored in rows 0-2, 6-8 and 12-14 of the column
+  const Eigen::Matrix<double, 36, Eigen::Dynamic>& products = database.jacobianProducts_;
+  ValuesView_t(values, nbSamples) =
+      (Eigen::Vector3d::UnitZ().dot(normal) *
+       (direction[0] * direction.transpose() * products.block(0, first, 3, nbSamples) +
+        direction[1] * direction.transpose() * products.block(6, first, 3, nbSamples) +
+        direction[2] * direction.transpose() * products.block(12, first, 3, nbSamples)))
+          .transpose();
+}
+
+void ManipulabilityBatchHeuristic(const SampleDB& database, const std::size_t first, const std::size_t nbSamples,
+                                  const Eigen::Vector3d& /*direction*/, const Eigen::Vector3d& normal,
+                                  const HeuristicParam& /*params*/, double* values) {
+  ValuesView_t result(values, nbSamples);
+  const double normalZ = Eigen::Vector3d::UnitZ().dot(normal);
+  if (normalZ < 0.7)
+    result.setConstant(-1);
+  else
+    result = database.staticValues_.segment(first, nbSamples) * 10000 * normalZ * 100000 + randomValues(nbSamples);
+}
+
+void ForwardBatchHeuristic(const SampleDB& database, const std::size_t first, const std::size_t nbSamples,
+                           const Eigen::Vector3d& direction, const Eigen::Vector3d& normal,
+                           const HeuristicParam& /*params*/, double* values) {
+  const Eigen::Matrix<double, 3, Eigen::Dynamic>& positions = database.effectorPositionsInLimbFrame_;
+  ValuesView_t(values, nbSamples) =
+      database.staticValues_.segment(first, nbSamples) * 1000. * Eigen::Vector3d::UnitZ().dot(normal) +
+      100. * (direction(0) * positions.row(0).segment(first, nbSamples) +
+              direction(1) * positions.row(1).segment(first, nbSamples) +
+              positions.row(2).segment(first, nbSamples).array().square().matrix())
+                 .transpose() +
+      randomValues(nbSamples);
+}
+
+void DynamicWalkBatchHeuristic(const SampleDB& database, const std::size_t first, const std::size_t nbSamples,
+                               const Eigen::Vector3d& direction, const Eigen::Vector3d& normal,
+                               const HeuristicParam& params, double* values) {
+  ValuesView_t result(values, nbSamples);
+  const Eigen::Matrix<double, 3, Eigen::Dynamic>& positions = database.effectorPositionsInLimbFrame_;
+  const Eigen::VectorXd staticValues = database.staticValues_.segment(first, nbSamples);
+  if (direction.norm() == 0 || std::isnan(direction.norm())) {
+    // see DynamicWalkHeuristic, dir = (0, 0, 1) and pos is the position in limb frame
+    result = 100. * staticValues +
+             (params.comAcceleration_[0] * positions.row(0).segment(first, nbSamples) +
+              params.comAcceleration_[1] * positions.row(1).segment(first, nbSamples) +
+              positions.row(2).segment(first, nbSamples))
+                 .transpose() +
+             randomValues(nbSamples);
+    return;
+  }
+  fcl::Vec3f n(normal);
+  n.normalize();
+  fcl::Vec3f dir(direction);
+  dir[2] = 0;
+  dir.normalize();
+  const double weightStatic = 100. * Eigen::Vector3d::UnitZ().dot(normal);
+  const double weightDir = 100.;
+  // horizontal position of the effector in the world frame (pos[2] = 0)
+  const Eigen::Matrix<double, 2, Eigen::Dynamic> pos =
+      params.tfWorldRoot_.getRotation().topRows<2>() * positions.middleCols(first, nbSamples);
+  const Eigen::VectorXd posDotDir = (dir[0] * pos.row(0) + dir[1] * pos.row(1)).transpose();
+  // z component of dir x pos, the other ones are 0
+  const Eigen::VectorXd sinAngle = ((dir[0] * pos.row(1) - dir[1] * pos.row(0)) * n[2]).transpose();
+  const Eigen::VectorXd noise = randomValues(nbSamples);
+  for (std::size_t i = 0; i < nbSamples; ++i) {
+    const double angle = atan2(sinAngle[i], posDotDir[i]);
+    const double limbRootY = database.effectorPositions_(1, first + i) - positions(1, first + i);
+    // the direction is flipped when the effector is on the wrong side of the direction of motion
+    const bool flip = limbRootY > 0. ? angle < 0 : angle > 0;
+    result[i] = weightStatic * staticValues[i] + (flip ? -weightDir / 10. : weightDir) * posDotDir[i] +
+                params.comAcceleration_[0] * pos(0, i) + params.comAcceleration_[1] * pos(1, i) + noise[i];
+  }
+}
+
 double DistanceToLimitHeuristic(const sampling::Sample& sample, const Eigen::Vector3d& /*direction*/,
                                 const Eigen::Vector3d& /*normal*/, const HeuristicParam& /*params*/) {
   return sample.configuration_.norm();
@@ -272,6 +367,11 @@ HeuristicFactory::HeuristicFactory() {
   heuristics_.insert(std::make_pair("fixedStep08", &fixedStep08Heuristic));
   heuristics_.insert(std::make_pair("fixedStep06", &fixedStep06Heuristic));
   heuristics_.insert(std::make_pair("fixedStep04", &fixedStep04Heuristic));
+  batchHeuristics_.insert(std::make_pair("static", &StaticBatchHeuristic));
+  batchHeuristics_.insert(std::make_pair("EFORT", &EFORTBatchHeuristic));
+  batchHeuristics_.insert(std::make_pair("manipulability", &ManipulabilityBatchHeuristic));
+  batchHeuristics_.insert(std::make_pair("forward", &ForwardBatchHeuristic));
+  batchHeuristics_.insert(std::make_pair("dynamicWalk", &DynamicWalkBatchHeuristic));
 }
 
 HeuristicFactory::~HeuristicFactory() {}
@@ -281,3 +381,21 @@ bool HeuristicFactory::AddHeuristic(const std::string& name, const heuristic fun
   heuristics_.insert(std::make_pair(name, func));
   return true;
 }
+
+bool HeuristicFactory::AddBatchHeuristic(const std::string& name, const batchHeuristic func) {
+  if (heuristics_.find(name) == heuristics_.end() || batchHeuristics_.find(name) != batchHeuristics_.end())
+    return false;
+  batchHeuristics_.insert(std::make_pair(name, func));
+  return true;
+}
+
+batchHeuristic HeuristicFactory::GetBatchHeuristic(const heuristic func) const {
+  for (std::map<std::string, const heuristic>::const_iterator cit = heuristics_.begin(); cit != heuristics_.end();
+       ++cit) {
+    if (cit->second == func) {
+      std::map<std::string, const batchHeuristic>::const_iterator bit = batchHeuristics_.find(cit->first);
+      return bit != batchHeuristics_.end() ? bit->second : 0;
+    }
+  }
+  return 0;
+}
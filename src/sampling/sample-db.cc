@@ -10,7 +10,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <algorithm>
 
 using namespace hpp;
 using namespace hpp::pinocchio;
@@ -50,6 +52,49 @@ T_VoxelSample getSamplesPerVoxel(const boost::shared_ptr<const octomap::OcTree>&
   return res;
 }
 
+/// Replaces the samples of the database by views on its columns
+void bindSamples(SampleDB& db, const std::size_t length, const std::size_t startRank, const std::size_t jacobianCols) {
+  const std::size_t size = (std::size_t)db.staticValues_.size();
+  db.samples_.clear();
+  db.samples_.reserve(size);
+  for (std::size_t id = 0; id < size; ++id) {
+    db.samples_.push_back(Sample(id, length, startRank, db.staticValues_[id], db.effectorPositions_.col(id).data(),
+                                 db.effectorPositionsInLimbFrame_.col(id).data(), db.configurations_.col(id).data(),
+                                 db.jacobians_.col(id).data(), jacobianCols, db.jacobianProducts_.col(id).data()));
+  }
+}
+
+/// Copies the data of the samples into the columns of the database, in the order of samples_,
+/// then replaces the samples by views on these columns. The id of a sample is then its index.
+void packSamples(SampleDB& db) {
+  const std::size_t size = db.samples_.size();
+  const Sample* first = size > 0 ? &db.samples_.front() : 0;
+  const std::size_t length = first ? first->length_ : 0;
+  const std::size_t startRank = first ? first->startRank_ : 0;
+  const std::size_t jacobianCols = first ? first->jacobian_.cols() : 0;
+  // samples may be views on the current columns, so new columns are filled before being swapped
+  Eigen::Matrix<double, 3, Eigen::Dynamic> positions(3, size), positionsInLimbFrame(3, size);
+  Eigen::Matrix<double, 36, Eigen::Dynamic> jacobianProducts(36, size);
+  Eigen::VectorXd staticValues(size);
+  Eigen::MatrixXd configurations(length, size), jacobians(6 * jacobianCols, size);
+  for (std::size_t id = 0; id < size; ++id) {
+    const Sample& sample = db.samples_[id];
+    positions.col(id) = sample.effectorPosition_;
+    positionsInLimbFrame.col(id) = sample.effectorPositionInLimbFrame_;
+    jacobianProducts.col(id) = Eigen::Map<const Eigen::Matrix<double, 36, 1> >(sample.jacobianProduct_.data());
+    staticValues[id] = sample.staticValue_;
+    configurations.col(id) = sample.configuration_;
+    jacobians.col(id) = Eigen::Map<const Eigen::VectorXd>(sample.jacobian_.data(), 6 * jacobianCols);
+  }
+  db.effectorPositions_.swap(positions);
+  db.effectorPositionsInLimbFrame_.swap(positionsInLimbFrame);
+  db.jacobianProducts_.swap(jacobianProducts);
+  db.staticValues_.swap(staticValues);
+  db.configurations_.swap(configurations);
+  db.jacobians_.swap(jacobians);
+  bindSamples(db, length, startRank, jacobianCols);
+}
+
 void alignSampleOrderWithOctree(SampleDB& db) {
   std::vector<std::size_t> realignOrderIds;  // indicate how to realign each value in value vector
   // assumes samples are sorted, so they are already sorted by interest
@@ -93,15 +138,41 @@ void alignSampleOrderWithOctree(SampleDB& db) {
   }
   db.samplesInVoxels_ = reorderedSamplesPerVoxel;
   db.values_ = reorderedValues;
-  db.samples_ = reorderedSamples;
+  db.samples_.swap(reorderedSamples);
+  packSamples(db);
 }
 
+namespace {
+struct sample_index_greater {
+  sample_index_greater(const T_Sample& samples) : samples_(samples) {}
+  bool operator()(const std::size_t lhs, const std::size_t rhs) const {
+    return sample_greater()(samples_[lhs], samples_[rhs]);
+  }
+  const T_Sample& samples_;
+};
+}  // namespace
+
 void sortDB(SampleDB& database) {
-  sample_greater sort;
-  std::sort(database.samples_.begin(), database.samples_.end(), sort);
+  // samples can not be assigned, their indices are sorted and the sorted samples copied
+  std::vector<std::size_t> order(database.samples_.size());
+  for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(), order.end(), sample_index_greater(database.samples_));
+  T_Sample sortedSamples;
+  sortedSamples.reserve(order.size());
+  for (std::vector<std::size_t>::const_iterator cit = order.begin(); cit != order.end(); ++cit)
+    sortedSamples.push_back(database.samples_[*cit]);
+  database.samples_.swap(sortedSamples);
   alignSampleOrderWithOctree(database);
 }
 
+fcl::CollisionObject* createBox(const FCL_REAL x, const FCL_REAL y, const FCL_REAL z, const FCL_REAL size,
+                                const FCL_REAL cost, const FCL_REAL threshold) {
+  Box* box = new Box(size, size, size);
+  box->cost_density = cost;
+  box->threshold_occupied = threshold;
+  return new fcl::CollisionObject(boost::shared_ptr<fcl::CollisionGeometry>(box), fcl::Transform3f(Vec3f(x, y, z)));
+}
+
 std::map<std::size_t, fcl::CollisionObject*> generateBoxesFromOctomap(
     const boost::shared_ptr<const octomap::OcTree>& octTree, const fcl::OcTree* tree) {
   std::map<std::size_t, fcl::CollisionObject*> boxes;
@@ -111,17 +182,8 @@ std::map<std::size_t, fcl::CollisionObject*> generateBoxesFromOctomap(
     FCL_REAL x = boxes_[i][0];
     FCL_REAL y = boxes_[i][1];
     FCL_REAL z = boxes_[i][2];
-    FCL_REAL size = boxes_[i][3];
-    FCL_REAL cost = boxes_[i][4];
-    FCL_REAL threshold = boxes_[i][5];
     std::size_t id = octTree->search(x, y, z) - octTree->getRoot();
-
-    Box* box = new Box(size, size, size);
-    box->cost_density = cost;
-    box->threshold_occupied = threshold;
-    fcl::CollisionObject* obj =
-        new fcl::CollisionObject(boost::shared_ptr<fcl::CollisionGeometry>(box), fcl::Transform3f(Vec3f(x, y, z)));
-    boxes.insert(std::make_pair(id, obj));
+    boxes.insert(std::make_pair(id, createBox(x, y, z, boxes_[i][3], boxes_[i][4], boxes_[i][5])));
   }
   return boxes;
 }
@@ -129,17 +191,20 @@ std::map<std::size_t, fcl::CollisionObject*> generateBoxesFromOctomap(
 
 SampleDB::SampleDB(const pinocchio::JointPtr_t limb, const std::string& effector, const std::size_t nbSamples,
                    const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset, const double resolution,
-                   const T_evaluate& data, const std::string& staticValue)
+                   const T_evaluate& data, const std::string& staticValue, const std::size_t nbThreads,
+                   const unsigned int seed)
     : resolution_(resolution),
-      samples_(GenerateSamples(limb, effector, nbSamples, offset, limbOffset)),
+      samples_(nbThreads > 1 ? GenerateSamples(limb, effector, nbSamples, offset, limbOffset, nbThreads, seed)
+                             : GenerateSamples(limb, effector, nbSamples, offset, limbOffset)),
       octomapTree_(generateOctree(samples_, resolution)),
       octree_(new fcl::OcTree(octomapTree_)),
       geometry_(boost::shared_ptr<fcl::CollisionGeometry>(octree_)),
       treeObject_(geometry_),
       boxes_(generateBoxesFromOctomap(octomapTree_, octree_)) {
+  packSamples(*this);
   for (T_evaluate::const_iterator cit = data.begin(); cit != data.end(); ++cit) {
     bool sort = staticValue == cit->first;
-    addValue(*this, cit->first, cit->second, sort, false);
+    addValue(*this, cit->first, cit->second, sort, false, nbThreads);
   }
   sortDB(*this);
 }
@@ -157,7 +222,7 @@ OctreeReport::OctreeReport(const Sample* s, const fcl::Contact c, const double v
 }
 
 SampleDB& hpp::rbprm::sampling::addValue(SampleDB& database, const std::string& valueName, const evaluate eval,
-                                         bool isStaticValue, bool sortSamples) {
+                                         bool isStaticValue, bool sortSamples, const std::size_t nbThreads) {
   T_Values::const_iterator cit = database.values_.find(valueName);
   if (cit != database.values_.end()) {
     hppDout(warning, "value already existing for database " << valueName);
@@ -165,13 +230,15 @@ SampleDB& hpp::rbprm::sampling::addValue(SampleDB& database, const std::string&
   } else {
     double maxValue = -std::numeric_limits<double>::max();
     double minValue = std::numeric_limits<double>::max();
-    T_Double values;
-    values.reserve(database.samples_.size());
-    for (T_Sample::iterator it = database.samples_.begin(); it != database.samples_.end(); ++it) {
-      double val = eval(database, *it);
-      maxValue = std::max(maxValue, val);
-      minValue = std::min(minValue, val);
-      values.push_back(val);
+    const int nbSamples = (int)database.samples_.size();
+    T_Double values(nbSamples);
+#pragma omp parallel for num_threads((int)nbThreads) if (nbThreads > 1)
+    for (int id = 0; id < nbSamples; ++id) {
+      values[id] = eval(database, database.samples_[id]);
+    }
+    for (T_Double::const_iterator it = values.begin(); it != values.end(); ++it) {
+      maxValue = std::max(maxValue, *it);
+      minValue = std::min(minValue, *it);
     }
     database.valueBounds_.insert(std::make_pair(valueName, std::make_pair(minValue, maxValue)));
     // now normalize values
@@ -180,7 +247,10 @@ SampleDB& hpp::rbprm::sampling::addValue(SampleDB& database, const std::string&
       *it = (max_min != 0) ? (*it - minValue) / max_min : 0;
     }
     if (isStaticValue) {
-      for (size_t id = 0; id < database.samples_.size(); id++) database.samples_[id].staticValue_ = values[id];
+      for (size_t id = 0; id < database.samples_.size(); id++) {
+        database.samples_[id].staticValue_ = values[id];
+        database.staticValues_[id] = values[id];
+      }
     }
     database.values_.insert(std::make_pair(valueName, values));
     if (sortSamples) sortDB(database);
@@ -188,11 +258,67 @@ SampleDB& hpp::rbprm::sampling::addValue(SampleDB& database, const std::string&
   return database;
 }
 
-// TODO Samples should be Vec3f
-bool rbprm::sampling::GetCandidates(const SampleDB& sc, const fcl::Transform3f& treeTrf,
-                                    const hpp::pinocchio::CollisionObjectPtr_t& o2, const fcl::Vec3f& direction,
-                                    hpp::rbprm::sampling::T_OctreeReport& reports, const HeuristicParam& params,
-                                    const heuristic evaluate) {
+CandidateQueue::CandidateQueue(const std::size_t maxCandidates)
+    : maxCandidates_(maxCandidates), pushed_(0), extracting_(false) {
+  // NOTHING
+}
+
+bool CandidateQueue::better(const Entry& lhs, const Entry& rhs) {
+  return lhs.report_.value_ > rhs.report_.value_ ||
+         (lhs.report_.value_ == rhs.report_.value_ && lhs.order_ < rhs.order_);
+}
+
+bool CandidateQueue::worse(const Entry& lhs, const Entry& rhs) { return better(rhs, lhs); }
+
+void CandidateQueue::push(const OctreeReport& report) {
+  if (extracting_) {
+    // back to collection, the worst candidate must be on top if the queue is bounded
+    if (maxCandidates_ > 0) std::make_heap(entries_.begin(), entries_.end(), &CandidateQueue::better);
+    extracting_ = false;
+  }
+  Entry entry(report, pushed_++);
+  if (maxCandidates_ == 0)
+    entries_.push_back(entry);
+  else if (entries_.size() < maxCandidates_) {
+    entries_.push_back(entry);
+    std::push_heap(entries_.begin(), entries_.end(), &CandidateQueue::better);
+  } else if (better(entry, entries_.front())) {
+    std::pop_heap(entries_.begin(), entries_.end(), &CandidateQueue::better);
+    entries_.back() = entry;
+    std::push_heap(entries_.begin(), entries_.end(), &CandidateQueue::better);
+  }
+}
+
+void CandidateQueue::prepare() const {
+  if (!extracting_) {
+    std::make_heap(entries_.begin(), entries_.end(), &CandidateQueue::worse);
+    extracting_ = true;
+  }
+}
+
+const OctreeReport& CandidateQueue::top() const {
+  assert(!empty());
+  prepare();
+  return entries_.front().report_;
+}
+
+void CandidateQueue::pop() {
+  assert(!empty());
+  prepare();
+  std::pop_heap(entries_.begin(), entries_.end(), &CandidateQueue::worse);
+  entries_.pop_back();
+}
+
+namespace {
+void addCandidate(T_OctreeReport& reports, const OctreeReport& report) { reports.insert(report); }
+
+void addCandidate(CandidateQueue& candidates, const OctreeReport& report) { candidates.push(report); }
+
+template <typename Candidates>
+bool collectCandidates(const SampleDB& sc, const fcl::Transform3f& treeTrf,
+                       const hpp::pinocchio::CollisionObjectPtr_t& o2, const fcl::Vec3f& direction,
+                       Candidates& candidates, const HeuristicParam& params, const heuristic evaluate,
+                       const batchHeuristic evaluateBatch) {
   fcl::CollisionRequest req(fcl::CONTACT, 1000);
   fcl::CollisionResult cResult;
   fcl::CollisionObject* obj = o2->fcl();
@@ -200,43 +326,60 @@ bool rbprm::sampling::GetCandidates(const SampleDB& sc, const fcl::Transform3f&
   sampling::T_VoxelSampleId::const_iterator voxelIt;
   Eigen::Vector3d eDir(direction[0], direction[1], direction[2]);
   eDir.normalize();
-  std::vector<long int> visited;
-  int totalSamples = 0;
-  int okay = 0;
+  bool found = false;
+  std::vector<double> values;
   for (std::size_t index = 0; index < cResult.numContacts(); ++index) {
     const Contact& contact = cResult.getContact(index);
-    if (std::find(visited.begin(), visited.end(), contact.b1) == visited.end()) visited.push_back(contact.b1);
     // verifying that position is theoritically reachable from next position
-    {
-      voxelIt = sc.samplesInVoxels_.find(contact.b1);
-      if (voxelIt != sc.samplesInVoxels_.end()) {
-        const VoxelSampleId& voxelSampleIds = voxelIt->second;
-        totalSamples += (int)voxelSampleIds.second;
-        for (T_Sample::const_iterator sit = sc.samples_.begin() + voxelSampleIds.first;
-             sit != sc.samples_.begin() + voxelSampleIds.first + voxelSampleIds.second; ++sit) {
-          // find normal id
-          assert(contact.o2->getObjectType() == fcl::OT_BVH);  // only works with meshes
-          const fcl::BVHModel<fcl::OBBRSS>* surface = static_cast<const fcl::BVHModel<fcl::OBBRSS>*>(contact.o2);
-          fcl::Vec3f normal;
-          const fcl::Triangle& tr = surface->tri_indices[contact.b2];
-          const fcl::Vec3f& v1 = surface->vertices[tr[0]];
-          const fcl::Vec3f& v2 = surface->vertices[tr[1]];
-          const fcl::Vec3f& v3 = surface->vertices[tr[2]];
-          normal = (v2 - v1).cross(v3 - v1);
-          normal.normalize();
-          Eigen::Vector3d eNormal(normal[0], normal[1], normal[2]);
-          OctreeReport report(&(*sit), contact, evaluate ? ((*evaluate)(*sit, eDir, eNormal, params)) : 0, eNormal, v1,
-                              v2, v3);
-          ++okay;
-          reports.insert(report);
-        }
-      } else
-        hppDout(warning, "no voxels in specified triangle : " << contact.b1);
+    voxelIt = sc.samplesInVoxels_.find(contact.b1);
+    if (voxelIt == sc.samplesInVoxels_.end()) {
+      hppDout(warning, "no voxels in specified triangle : " << contact.b1);
+      continue;
+    }
+    // the normal only depends on the triangle in contact
+    assert(contact.o2->getObjectType() == fcl::OT_BVH);  // only works with meshes
+    const fcl::BVHModel<fcl::OBBRSS>* surface = static_cast<const fcl::BVHModel<fcl::OBBRSS>*>(contact.o2);
+    const fcl::Triangle& tr = surface->tri_indices[contact.b2];
+    const fcl::Vec3f& v1 = surface->vertices[tr[0]];
+    const fcl::Vec3f& v2 = surface->vertices[tr[1]];
+    const fcl::Vec3f& v3 = surface->vertices[tr[2]];
+    fcl::Vec3f normal = (v2 - v1).cross(v3 - v1);
+    normal.normalize();
+    const Eigen::Vector3d eNormal(normal[0], normal[1], normal[2]);
+    const VoxelSampleId& voxelSampleIds = voxelIt->second;
+    // samples of a voxel are contiguous, they can be scored at once
+    values.assign(voxelSampleIds.second, 0.);
+    if (evaluateBatch)
+      (*evaluateBatch)(sc, voxelSampleIds.first, voxelSampleIds.second, eDir, eNormal, params, values.data());
+    else if (evaluate) {
+      for (std::size_t i = 0; i < voxelSampleIds.second; ++i)
+        values[i] = (*evaluate)(sc.samples_[voxelSampleIds.first + i], eDir, eNormal, params);
+    }
+    for (std::size_t i = 0; i < voxelSampleIds.second; ++i) {
+      addCandidate(candidates,
+                   OctreeReport(&sc.samples_[voxelSampleIds.first + i], contact, values[i], eNormal, v1, v2, v3));
+      found = true;
     }
   }
+  return found;
+}
+}  // namespace
+
+bool rbprm::sampling::GetCandidates(const SampleDB& sc, const fcl::Transform3f& treeTrf,
+                                    const hpp::pinocchio::CollisionObjectPtr_t& o2, const fcl::Vec3f& direction,
+                                    hpp::rbprm::sampling::T_OctreeReport& reports, const HeuristicParam& params,
+                                    const heuristic evaluate) {
+  collectCandidates(sc, treeTrf, o2, direction, reports, params, evaluate, 0);
   return !reports.empty();
 }
 
+bool rbprm::sampling::GetCandidates(const SampleDB& sc, const fcl::Transform3f& treeTrf,
+                                    const hpp::pinocchio::CollisionObjectPtr_t& o2, const fcl::Vec3f& direction,
+                                    CandidateQueue& candidates, const HeuristicParam& params,
+                                    const heuristic evaluate, const batchHeuristic evaluateBatch) {
+  return collectCandidates(sc, treeTrf, o2, direction, candidates, params, evaluate, evaluateBatch);
+}
+
 rbprm::sampling::T_OctreeReport rbprm::sampling::GetCandidates(const SampleDB& sc, const fcl::Transform3f& treeTrf,
                                                                const hpp::pinocchio::CollisionObjectPtr_t& o2,
                                                                const fcl::Vec3f& direction,
@@ -347,3 +490,152 @@ SampleDB::SampleDB(std::ifstream& myfile, bool loadValues)
   boxes_ = generateBoxesFromOctomap(octomapTree_, octree_);
   alignSampleOrderWithOctree(*this);
 }
+
+namespace {
+/// Read only stream buffer over a memory area, used to load the octree
+/// directly from the mapped database
+struct MemoryBuffer : std::streambuf {
+  MemoryBuffer(const char* data, const std::size_t size) {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+// staticValue, effectorPosition, effectorPositionInLimbFrame, jacobianProduct, configuration, jacobian
+const std::size_t configurationOffset = 1 + 3 + 3 + 36;
+
+std::size_t sampleRecordSize(const std::size_t length, const std::size_t jacobianCols) {
+  return configurationOffset + length + 6 * jacobianCols;
+}
+
+void writeSampleRecord(const Sample& sample, BinaryWriter& writer) {
+  writer.writeDouble(sample.staticValue_);
+  writer.writeVecFCL(sample.effectorPosition_);
+  writer.writeVecFCL(sample.effectorPositionInLimbFrame_);
+  writer.writeDoubles(sample.jacobianProduct_.data(), 36);
+  writer.writeDoubles(sample.configuration_.data(), sample.configuration_.size());
+  writer.writeDoubles(sample.jacobian_.data(), sample.jacobian_.size());
+}
+
+// voxel ids are offsets between node addresses in the octree, which change
+// each time the octree is loaded. They are thus saved as octree keys, and
+// converted back to ids with a single search per voxel.
+uint64_t packKey(const octomap::OcTreeKey& key) {
+  return (uint64_t)key[0] | ((uint64_t)key[1] << 16) | ((uint64_t)key[2] << 32);
+}
+
+octomap::OcTreeKey unpackKey(const uint64_t packed) {
+  return octomap::OcTreeKey((octomap::key_type)(packed & 0xFFFF), (octomap::key_type)((packed >> 16) & 0xFFFF),
+                            (octomap::key_type)((packed >> 32) & 0xFFFF));
+}
+
+/// Saves the samples per voxel table, and the boxes of the occupied leaves,
+/// so that neither alignSampleOrderWithOctree nor generateBoxesFromOctomap
+/// have to be called when loading the database. Samples are already stored in aligned order.
+void writeVoxelIndex(const SampleDB& database, BinaryWriter& writer) {
+  const boost::shared_ptr<const octomap::OcTree>& octTree = database.octomapTree_;
+  writer.writeU64(database.samplesInVoxels_.size());
+  for (T_VoxelSampleId::const_iterator cit = database.samplesInVoxels_.begin();
+       cit != database.samplesInVoxels_.end(); ++cit) {
+    const fcl::Vec3f& position = database.samples_[cit->second.first].effectorPosition_;
+    writer.writeU64(packKey(octTree->coordToKey(position[0], position[1], position[2])));
+    writer.writeU64(cit->second.first);
+    writer.writeU64(cit->second.second);
+  }
+  std::vector<boost::array<FCL_REAL, 6> > boxes = database.octree_->toBoxes();
+  writer.writeU64(boxes.size());
+  for (std::size_t i = 0; i < boxes.size(); ++i) writer.writeDoubles(boxes[i].data(), 6);
+}
+
+void readVoxelIndex(SampleDB& database, BinaryReader& reader) {
+  const boost::shared_ptr<const octomap::OcTree>& octTree = database.octomapTree_;
+  const std::size_t nbVoxels = (std::size_t)reader.readU64();
+  for (std::size_t i = 0; i < nbVoxels; ++i) {
+    const octomap::OcTreeKey key = unpackKey(reader.readU64());
+    const std::size_t first = (std::size_t)reader.readU64();
+    const std::size_t nbSamples = (std::size_t)reader.readU64();
+    long int id = octTree->search(key) - octTree->getRoot();
+    database.samplesInVoxels_.insert(std::make_pair(id, std::make_pair(first, nbSamples)));
+  }
+  const std::size_t nbBoxes = (std::size_t)reader.readU64();
+  const double* boxes = reader.readDoubles(nbBoxes * 6);
+  for (std::size_t i = 0; i < nbBoxes; ++i) {
+    const double* box = boxes + 6 * i;
+    std::size_t id = octTree->search(box[0], box[1], box[2]) - octTree->getRoot();
+    database.boxes_.insert(std::make_pair(id, createBox(box[0], box[1], box[2], box[3], box[4], box[5])));
+  }
+}
+
+}  // namespace
+
+bool hpp::rbprm::sampling::saveLimbDatabaseBinary(const SampleDB& database, BinaryWriter& writer) {
+  const std::size_t size = database.samples_.size();
+  const Sample* first = size > 0 ? &database.samples_.front() : 0;
+  writer.writeU64(size);
+  writer.writeDouble(database.resolution_);
+  writer.writeU64(first ? first->startRank_ : 0);
+  writer.writeU64(first ? first->length_ : 0);
+  writer.writeU64(first ? first->jacobian_.cols() : 0);
+  for (T_Sample::const_iterator cit = database.samples_.begin(); cit != database.samples_.end(); ++cit) {
+    writeSampleRecord(*cit, writer);
+  }
+  writer.writeU64(database.values_.size());
+  for (T_Values::const_iterator cit = database.values_.begin(); cit != database.values_.end(); ++cit) {
+    writer.writeString(cit->first);
+    writer.writeDoubles(cit->second.data(), cit->second.size());
+  }
+  std::ostringstream octreeStream;
+  database.octomapTree_->writeData(octreeStream);
+  writer.writeBlob(octreeStream.str());
+  writeVoxelIndex(database, writer);
+  return writer.good();
+}
+
+SampleDB::SampleDB(BinaryReader& reader, const uint64_t version, bool loadValues)
+    : treeObject_(boost::shared_ptr<CollisionGeometry>(new fcl::Box(1, 1, 1))) {
+  const std::size_t size = (std::size_t)reader.readU64();
+  resolution_ = reader.readDouble();
+  const std::size_t startRank = (std::size_t)reader.readU64();
+  const std::size_t length = (std::size_t)reader.readU64();
+  const std::size_t jacobianCols = (std::size_t)reader.readU64();
+  const std::size_t stride = sampleRecordSize(length, jacobianCols);
+  const double* records = reader.readDoubles(size * stride);
+  effectorPositions_.resize(3, size);
+  effectorPositionsInLimbFrame_.resize(3, size);
+  jacobianProducts_.resize(36, size);
+  staticValues_.resize(size);
+  configurations_.resize(length, size);
+  jacobians_.resize(6 * jacobianCols, size);
+  for (std::size_t id = 0; id < size; ++id) {
+    const double* record = records + id * stride;
+    staticValues_[id] = record[0];
+    effectorPositions_.col(id) = Eigen::Map<const Eigen::Vector3d>(record + 1);
+    effectorPositionsInLimbFrame_.col(id) = Eigen::Map<const Eigen::Vector3d>(record + 4);
+    jacobianProducts_.col(id) = Eigen::Map<const Eigen::Matrix<double, 36, 1> >(record + 7);
+    configurations_.col(id) = Eigen::Map<const Eigen::VectorXd>(record + configurationOffset, length);
+    jacobians_.col(id) = Eigen::Map<const Eigen::VectorXd>(record + configurationOffset + length, 6 * jacobianCols);
+  }
+  bindSamples(*this, length, startRank, jacobianCols);
+  const std::size_t nbValues = (std::size_t)reader.readU64();
+  for (std::size_t i = 0; i < nbValues; ++i) {
+    const std::string valueName = reader.readString();
+    const double* vals = reader.readDoubles(size);
+    if (loadValues) values_.insert(std::make_pair(valueName, T_Double(vals, vals + size)));
+  }
+  std::size_t octreeSize;
+  const char* octreeData = reader.readBlob(octreeSize);
+  MemoryBuffer buffer(octreeData, octreeSize);
+  std::istream octreeStream(&buffer);
+  octomap::OcTree* octTree = new octomap::OcTree(resolution_);
+  octTree->readData(octreeStream);
+  octomapTree_ = boost::shared_ptr<const octomap::OcTree>(octTree);
+  octree_ = new fcl::OcTree(octomapTree_);
+  geometry_ = boost::shared_ptr<fcl::CollisionGeometry>(octree_);
+  treeObject_ = fcl::CollisionObject(geometry_);
+  if (version >= 2)
+    readVoxelIndex(*this, reader);
+  else {
+    boxes_ = generateBoxesFromOctomap(octomapTree_, octree_);
+    alignSampleOrderWithOctree(*this);
+  }
+}
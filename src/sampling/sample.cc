@@ -21,6 +21,11 @@
 #include <pinocchio/algorithm/joint-configuration.hpp>
 #include <hpp/core/configuration-shooter/uniform.hh>
 #include <Eigen/Eigen>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <algorithm>
 
 using namespace hpp;
 using namespace hpp::pinocchio;
@@ -74,28 +79,58 @@ fcl::Vec3f ComputeEffectorPositionInLimbFrame(const hpp::pinocchio::JointPtr_t l
   return (effTr - limbTr);
 }
 
+std::size_t JacobianCols(const hpp::pinocchio::JointPtr_t limb, const hpp::pinocchio::Frame effector) {
+  return effector.joint()->rankInVelocity() - limb->rankInVelocity() + effector.joint()->numberDof();
+}
+
 Eigen::MatrixXd Jacobian(const hpp::pinocchio::JointPtr_t limb, const hpp::pinocchio::Frame effector) {
-  return effector.jacobian().block(
-      0, limb->rankInVelocity(), 6,
-      effector.joint()->rankInVelocity() - limb->rankInVelocity() + effector.joint()->numberDof());
+  return effector.jacobian().block(0, limb->rankInVelocity(), 6, JacobianCols(limb, effector));
 }
 
-double Manipulability(const Eigen::MatrixXd& product) {
+double Manipulability(const Eigen::Matrix<hpp::pinocchio::value_type, 6, 6>& product) {
   double det = product.determinant();
   return det > 0 ? sqrt(det) : 0;
 }
 
+namespace {
+// layout of the data owned by a sample, see Sample::Sample(const double*, ...)
+const std::size_t positionInLimbFrameOffset = 3;
+const std::size_t jacobianProductOffset = 6;
+const std::size_t configurationOffset = jacobianProductOffset + 36;
+
+std::shared_ptr<const std::vector<double> > PackSample(const fcl::Vec3f& effectorPosition,
+                                                      const fcl::Vec3f& effectorPositionInLimbFrame,
+                                                      hpp::pinocchio::ConfigurationIn_t configuration,
+                                                      const Eigen::MatrixXd& jacobian,
+                                                      const Eigen::Matrix<value_type, 6, 6>& jacobianProduct) {
+  std::shared_ptr<std::vector<double> > storage(
+      new std::vector<double>(configurationOffset + configuration.size() + jacobian.size()));
+  std::vector<double>::iterator data = storage->begin();
+  std::copy(effectorPosition.data(), effectorPosition.data() + 3, data);
+  std::copy(effectorPositionInLimbFrame.data(), effectorPositionInLimbFrame.data() + 3,
+            data + positionInLimbFrameOffset);
+  std::copy(jacobianProduct.data(), jacobianProduct.data() + 36, data + jacobianProductOffset);
+  std::copy(configuration.data(), configuration.data() + configuration.size(), data + configurationOffset);
+  std::copy(jacobian.data(), jacobian.data() + jacobian.size(), data + configurationOffset + configuration.size());
+  return storage;
+}
+
+std::shared_ptr<const std::vector<double> > PackSample(const hpp::pinocchio::JointPtr_t limb,
+                                                      const hpp::pinocchio::Frame effector,
+                                                      hpp::pinocchio::ConfigurationIn_t configuration,
+                                                      const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset) {
+  const Eigen::MatrixXd jacobian(Jacobian(limb, effector));
+  return PackSample(ComputeEffectorPosition(limb, effector, offset),
+                    ComputeEffectorPositionInLimbFrame(limb, effector, offset, limbOffset), configuration, jacobian,
+                    jacobian * jacobian.transpose());
+}
+}  // namespace
+
 Sample::Sample(const hpp::pinocchio::JointPtr_t limb, const hpp::pinocchio::Frame effector, const fcl::Vec3f& offset,
                const fcl::Vec3f& limbOffset, std::size_t id)
-    : startRank_(limb->rankInConfiguration()),
-      length_(ComputeLength(limb, effector)),
-      configuration_(limb->robot()->currentConfiguration().segment(startRank_, length_)),
-      effectorPosition_(ComputeEffectorPosition(limb, effector, offset)),
-      effectorPositionInLimbFrame_(ComputeEffectorPositionInLimbFrame(limb, effector, offset, limbOffset)),
-      jacobian_(Jacobian(limb, effector)),
-      jacobianProduct_(jacobian_ * jacobian_.transpose()),
-      id_(id),
-      staticValue_(Manipulability(jacobianProduct_)) {
+    : Sample(limb, effector,
+             limb->robot()->currentConfiguration().segment(limb->rankInConfiguration(), ComputeLength(limb, effector)),
+             offset, limbOffset, id) {
   // NOTHING
 }
 
@@ -103,36 +138,45 @@ Sample::Sample(const std::size_t id, const std::size_t length, const std::size_t
                const fcl::Vec3f& effectorPosition, const fcl::Vec3f& effectorPositionInLimbFrame,
                const hpp::pinocchio::ConfigurationIn_t configuration, const Eigen::MatrixXd& jacobian,
                const Eigen::Matrix<hpp::pinocchio::value_type, 6, 6>& jacobianProduct)
+    : Sample(id, length, startRank, staticValue, jacobian.cols(),
+             PackSample(effectorPosition, effectorPositionInLimbFrame, configuration, jacobian, jacobianProduct)) {
+  // NOTHING
+}
+
+Sample::Sample(const std::size_t id, const std::size_t length, const std::size_t startRank, const double staticValue,
+               const double* effectorPosition, const double* effectorPositionInLimbFrame, const double* configuration,
+               const double* jacobian, const std::size_t jacobianCols, const double* jacobianProduct)
     : startRank_(startRank),
       length_(length),
-      configuration_(configuration),
+      configuration_(configuration, length),
       effectorPosition_(effectorPosition),
       effectorPositionInLimbFrame_(effectorPositionInLimbFrame),
-      jacobian_(jacobian),
+      jacobian_(jacobian, 6, jacobianCols),
       jacobianProduct_(jacobianProduct),
       id_(id),
       staticValue_(staticValue) {
   // NOTHING
 }
 
+Sample::Sample(const std::size_t id, const std::size_t length, const std::size_t startRank, const double staticValue,
+               const std::size_t jacobianCols, const std::shared_ptr<const std::vector<double> >& storage)
+    : Sample(id, length, startRank, staticValue, storage->data(), storage->data() + positionInLimbFrameOffset,
+             storage->data() + configurationOffset, storage->data() + configurationOffset + length, jacobianCols,
+             storage->data() + jacobianProductOffset) {
+  storage_ = storage;
+}
+
 Sample::Sample(const hpp::pinocchio::JointPtr_t limb, const hpp::pinocchio::Frame effector,
                hpp::pinocchio::ConfigurationIn_t configuration, const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset,
                std::size_t id)
-    : startRank_(limb->rankInConfiguration()),
-      length_(ComputeLength(limb, effector)),
-      configuration_(configuration),
-      effectorPosition_(ComputeEffectorPosition(limb, effector, offset)),
-      effectorPositionInLimbFrame_(ComputeEffectorPositionInLimbFrame(limb, effector, offset, limbOffset)),
-      jacobian_(Jacobian(limb, effector)),
-      jacobianProduct_(jacobian_ * jacobian_.transpose()),
-      id_(id),
-      staticValue_(Manipulability(jacobianProduct_)) {
-  // NOTHING
+    : Sample(id, ComputeLength(limb, effector), limb->rankInConfiguration(), 0., JacobianCols(limb, effector),
+             PackSample(limb, effector, configuration, offset, limbOffset)) {
+  staticValue_ = Manipulability(jacobianProduct_);
 }
 
 Sample::Sample(const Sample& clone)
-
-    : startRank_(clone.startRank_),
+    : storage_(clone.storage_),
+      startRank_(clone.startRank_),
       length_(clone.length_),
       configuration_(clone.configuration_),
       effectorPosition_(clone.effectorPosition_),
@@ -180,3 +224,105 @@ hpp::rbprm::sampling::SampleVector_t hpp::rbprm::sampling::GenerateSamples(const
   }
   return result;
 }
+
+namespace {
+typedef std::mt19937 Generator_t;
+
+double uniform(Generator_t& generator, const double lower, const double upper) {
+  return std::uniform_real_distribution<double>(lower, upper)(generator);
+}
+
+double uniformInBounds(Generator_t& generator, const double lower, const double upper, const std::string& name) {
+  if (!std::isfinite(lower) || !std::isfinite(upper) || upper < lower)
+    throw std::runtime_error("Cannot sample " + name + ", its bounds are not set");
+  return uniform(generator, lower, upper);
+}
+
+void ShootQuaternion(Generator_t& generator, const size_type rank, Configuration_t& config) {
+  // uniform sampling of a unit quaternion (x, y, z, w), see Shoemake, Graphics Gems III
+  const double u1 = uniform(generator, 0., 1.), u2 = uniform(generator, 0., 2 * M_PI),
+               u3 = uniform(generator, 0., 2 * M_PI);
+  config[rank] = sqrt(1 - u1) * sin(u2);
+  config[rank + 1] = sqrt(1 - u1) * cos(u2);
+  config[rank + 2] = sqrt(u1) * sin(u3);
+  config[rank + 3] = sqrt(u1) * cos(u3);
+}
+
+void ShootAngle(Generator_t& generator, const size_type rank, Configuration_t& config) {
+  const double theta = uniform(generator, -M_PI, M_PI);
+  config[rank] = cos(theta);
+  config[rank + 1] = sin(theta);
+}
+
+/// Samples a configuration of the whole device with the given random generator, with the same
+/// distribution as core::configurationShooter::Uniform: the vector parts of the joints and the extra
+/// configuration space are sampled uniformly within their bounds, the SO(2) and SO(3) parts uniformly
+/// on their manifold.
+void ShootConfiguration(const DevicePtr_t& device, Generator_t& generator, Configuration_t& config) {
+  const size_type extraDim = device->extraConfigSpace().dimension();
+  const size_type modelSize = device->configSize() - extraDim;
+  config.resize(device->configSize());
+  size_type rank = 0;
+  while (rank < modelSize) {
+    JointPtr_t joint = device->getJointAtConfigRank(rank);
+    const size_type configSize = joint->configSize();
+    // size of the vector part of the joint, followed by its rotation if any
+    size_type vectorSize = configSize;
+    if (configSize != joint->numberDof()) {
+      const std::string space = joint->configurationSpace()->name();
+      if (space.find("SO(3)") != std::string::npos) {
+        vectorSize = configSize - 4;
+        ShootQuaternion(generator, rank + vectorSize, config);
+      } else if (space.find("SO(2)") != std::string::npos) {
+        vectorSize = configSize - 2;
+        ShootAngle(generator, rank + vectorSize, config);
+      } else {
+        throw std::runtime_error("Cannot sample the configuration space " + space + " of joint " + joint->name());
+      }
+    }
+    for (size_type i = 0; i < vectorSize; ++i)
+      config[rank + i] = uniformInBounds(generator, joint->lowerBound(i), joint->upperBound(i), joint->name());
+    rank += configSize;
+  }
+  for (size_type i = 0; i < extraDim; ++i)
+    config[modelSize + i] = uniformInBounds(generator, device->extraConfigSpace().lower(i),
+                                            device->extraConfigSpace().upper(i), "the extra configuration space");
+}
+}  // namespace
+
+hpp::rbprm::sampling::SampleVector_t hpp::rbprm::sampling::GenerateSamples(
+    const pinocchio::JointPtr_t model, const std::string& effector, const std::size_t nbSamples,
+    const fcl::Vec3f& offset, const fcl::Vec3f& limbOffset, const std::size_t nbThreads, const unsigned int seed) {
+  const int threads = (int)std::max(nbThreads, std::size_t(1));
+  const size_type startRank(model->rankInConfiguration());
+  const size_type length(ComputeLength(model, model->robot()->getFrameByName(effector)));
+  const Configuration_t configRef(model->robot()->neutralConfiguration());
+  // clones are created sequentially, only the generation is parallel
+  std::vector<DevicePtr_t> devices;
+  for (int t = 0; t < threads; ++t) devices.push_back(model->robot()->clone());
+  std::vector<SampleVector_t> results(threads);
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+  for (int t = 0; t < threads; ++t) {
+    const DevicePtr_t& device = devices[t];
+    JointPtr_t clone = device->getJointByName(model->name());
+    Frame effectorClone = device->getFrameByName(effector);
+    Generator_t generator(seed + t);
+    Configuration_t config(configRef);
+    const std::size_t begin = nbSamples * t / threads, end = nbSamples * (t + 1) / threads;
+    SampleVector_t& result = results[t];
+    result.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      // the first sample is the reference configuration
+      if (i > 0) ShootConfiguration(device, generator, config);
+      device->currentConfiguration(config);
+      device->computeForwardKinematics();
+      result.push_back(Sample(clone, effectorClone, config.segment(startRank, length), offset, limbOffset, i));
+    }
+  }
+  SampleVector_t result;
+  result.reserve(nbSamples);
+  for (int t = 0; t < threads; ++t)
+    for (SampleVector_t::const_iterator cit = results[t].begin(); cit != results[t].end(); ++cit)
+      result.push_back(*cit);
+  return result;
+}
@@ -28,6 +28,7 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 
 #ifdef PROFILE
@@ -44,8 +45,8 @@ namespace hpp {
 namespace rbprm {
 namespace stability {
 
-void computeRectangleContact(const std::string& name, const RbPrmLimbPtr_t limb, const State& state, Ref_matrix43 p,
-                             double lx = 0, double ly = 0) {
+void computeRectangleContact(const std::string& name, const RbPrmLimbPtr_t limb, const State& state,
+                             const fcl::Matrix3f& effectorRotation, Ref_matrix43 p, double lx = 0, double ly = 0) {
   hppDout(notice, "Compute rectangular contact : ");
   if (lx == 0) lx = limb->x_;
   if (ly == 0) ly = limb->y_;
@@ -57,9 +58,9 @@ void computeRectangleContact(const std::string& name, const RbPrmLimbPtr_t limb,
   if (limb->contactType_ == _3_DOF) {
     // create rotation matrix from normal
     const fcl::Vec3f& normal = state.contactNormals_.at(name);
-    const fcl::Vec3f z_current = limb->effector_.currentTransformation().rotation() * limb->normal_;
+    const fcl::Vec3f z_current = effectorRotation * limb->normal_;
     const fcl::Matrix3f alignRotation = tools::GetRotationMatrix(z_current, normal);
-    const fcl::Matrix3f rotation = alignRotation * limb->effector_.currentTransformation().rotation();
+    const fcl::Matrix3f rotation = alignRotation * effectorRotation;
     const fcl::Vec3f offset = rotation * limb->offset_;
     Eigen::Vector3d z, x, y;
     for (int i = 0; i < 3; ++i) z[i] = normal[i];
@@ -93,19 +94,44 @@ void computeRectangleContact(const std::string& name, const RbPrmLimbPtr_t limb,
   }
 }
 
-Vector3 computePointContact(const std::string& name, const RbPrmLimbPtr_t limb, const State& state) {
+Vector3 computePointContact(const std::string& name, const RbPrmLimbPtr_t limb, const State& state,
+                            const fcl::Matrix3f& effectorRotation) {
   const fcl::Vec3f& position = state.contactPositions_.at(name);
   // create rotation matrix from normal
   const fcl::Vec3f& normal = state.contactNormals_.at(name);
-  const fcl::Vec3f z_current = limb->effector_.currentTransformation().rotation() * limb->normal_;
+  const fcl::Vec3f z_current = effectorRotation * limb->normal_;
   const fcl::Matrix3f alignRotation = tools::GetRotationMatrix(z_current, normal);
-  const fcl::Matrix3f rotation = alignRotation * limb->effector_.currentTransformation().rotation();
+  const fcl::Matrix3f rotation = alignRotation * effectorRotation;
   const fcl::Vec3f offset = rotation * limb->offset_;
   return position + offset;
 }
 
+namespace {
+const unsigned int generatorsPerContact = 4;
+const SolverLP solverType = SOLVER_LP_QPOASES;
+
+// the solvers only depend on the mass of the robot, the number of generators per contact and the LP solver,
+// the contacts being set by setNewContacts before each query
+typedef std::pair<std::pair<double, unsigned int>, SolverLP> EquilibriumKey;
+typedef std::map<EquilibriumKey, std::shared_ptr<Equilibrium> > T_EquilibriumCache;
+}  // namespace
+
 Equilibrium initLibrary(const RbPrmFullBodyPtr_t fullbody) {
-  return Equilibrium(fullbody->device_->name(), fullbody->device_->mass(), 4, SOLVER_LP_QPOASES, true, 10, false);
+  return Equilibrium(fullbody->device_->name(), fullbody->device_->mass(), generatorsPerContact, solverType, true, 10,
+                     false);
+}
+
+Equilibrium& cachedLibrary(const RbPrmFullBodyPtr_t fullbody) {
+  thread_local T_EquilibriumCache cache;
+  const EquilibriumKey key(std::make_pair(fullbody->device_->mass(), generatorsPerContact), solverType);
+  T_EquilibriumCache::iterator it = cache.find(key);
+  if (it == cache.end()) {
+    const pinocchio::DevicePtr_t& device = fullbody->device_;
+    std::shared_ptr<Equilibrium> equilibrium(
+        new Equilibrium(device->name(), device->mass(), generatorsPerContact, solverType, true, 10, false));
+    it = cache.insert(std::make_pair(key, equilibrium)).first;
+  }
+  return *(it->second);
 }
 
 std::size_t numContactPoints(const RbPrmLimbPtr_t& limb) {
@@ -127,13 +153,13 @@ const std::vector<std::size_t> numContactPoints(const T_Limb& limbs, const std::
   return res;
 }
 
-centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, State& state, Equilibrium& sEq,
+centroidal_dynamics::Vector3 setupLibrary(const KinematicContextPtr_t& context, State& state, Equilibrium& sEq,
                                           EquilibriumAlgorithm& alg, core::value_type friction, const double feetX,
                                           const double feetY) throw(std::runtime_error) {
+  const RbPrmFullBodyPtr_t& fullbody = context->fullBody();
   friction = fullbody->getFriction();
   hppDout(notice, "Setup centroidal dynamic lib, friction = " << friction);
   const rbprm::T_Limb& limbs = fullbody->GetLimbs();
-  hpp::pinocchio::ConfigurationIn_t save = fullbody->device_->currentConfiguration();
   std::vector<std::string> contacts;
   std::vector<std::string> graspscontacts;
   for (std::map<std::string, fcl::Vec3f>::const_iterator cit = state.contactPositions_.begin();
@@ -143,8 +169,7 @@ centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, Sta
     else
       contacts.push_back(cit->first);
   }
-  fullbody->device_->currentConfiguration(state.configuration_);
-  fullbody->device_->computeForwardKinematics();
+  context->setConfiguration(state.configuration_);
   std::size_t nbContactPoints(0);
   std::vector<std::size_t> contactPointsInc = numContactPoints(limbs, contacts, nbContactPoints);
   std::vector<std::size_t> contactGraspPointsInc = numContactPoints(limbs, graspscontacts, nbContactPoints);
@@ -158,10 +183,12 @@ centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, Sta
     Vector3 normal(n[0], n[1], n[2]);
     normal.normalize();
     const std::size_t& inc = *cit;
+    const fcl::Matrix3f effectorRotation = context->effectorTransformation(limb).rotation();
     if (inc > 1)
-      computeRectangleContact(contacts[c], limb, state, positions.middleRows<4>(currentIndex), feetX, feetY);
+      computeRectangleContact(contacts[c], limb, state, effectorRotation, positions.middleRows<4>(currentIndex), feetX,
+                              feetY);
     else
-      positions.middleRows<1>(currentIndex, inc) = computePointContact(contacts[c], limb, state);
+      positions.middleRows<1>(currentIndex, inc) = computePointContact(contacts[c], limb, state, effectorRotation);
     for (std::size_t i = 0; i < inc; ++i) {
       normals.middleRows<1>(currentIndex + i) = normal;
     }
@@ -177,10 +204,13 @@ centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, Sta
       const fcl::Vec3f& n = state.contactNormals_.at(graspscontacts[c]);
       Vector3 normal(n[0], n[1], n[2]);
       const std::size_t& inc = *cit;
+      const fcl::Matrix3f effectorRotation = context->effectorTransformation(limb).rotation();
       if (inc > 1)
-        computeRectangleContact(graspscontacts[c], limb, state, positions.middleRows<4>(currentIndex));
+        computeRectangleContact(graspscontacts[c], limb, state, effectorRotation,
+                                positions.middleRows<4>(currentIndex));
       else
-        positions.middleRows<1>(currentIndex, inc) = computePointContact(graspscontacts[c], limb, state);
+        positions.middleRows<1>(currentIndex, inc) =
+            computePointContact(graspscontacts[c], limb, state, effectorRotation);
       for (std::size_t i = 0; i < inc; ++i) {
         normals.middleRows<1>(currentIndex + i) = normal;
       }
@@ -193,9 +223,8 @@ centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, Sta
   comcptr->computeMass();
   comcptr->compute();
   const fcl::Vec3f comfcl = comcptr->com();*/
-  const fcl::Vec3f comfcl = fullbody->device_->positionCenterOfMass();
+  const fcl::Vec3f comfcl = context->positionCenterOfMass();
   for (int i = 0; i < 3; ++i) com(i) = comfcl[i];
-  fullbody->device_->currentConfiguration(save);
   if (graspIndex > -1 && alg != EQUILIBRIUM_ALGORITHM_PP) {
     alg = EQUILIBRIUM_ALGORITHM_PP;
   }
@@ -207,8 +236,15 @@ centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, Sta
   return com;
 }
 
-std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const RbPrmFullBodyPtr_t fullbody, State& state,
+centroidal_dynamics::Vector3 setupLibrary(const RbPrmFullBodyPtr_t fullbody, State& state, Equilibrium& sEq,
+                                          EquilibriumAlgorithm& alg, core::value_type friction, const double feetX,
+                                          const double feetY) throw(std::runtime_error) {
+  return setupLibrary(KinematicContext::shared(fullbody), state, sEq, alg, friction, feetX, feetY);
+}
+
+std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const KinematicContextPtr_t& context, State& state,
                                                    const hpp::core::value_type friction) {
+  const RbPrmFullBodyPtr_t& fullbody = context->fullBody();
   std::pair<MatrixXX, VectorX> res;
   MatrixXX& H = res.first;
   VectorX& h = res.second;
@@ -216,9 +252,9 @@ std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const RbPrmFullBodyPtr_t full
   RbPrmProfiler& watch = getRbPrmProfiler();
   watch.start("test balance");
 #endif
-  Equilibrium staticEquilibrium(initLibrary(fullbody));
+  Equilibrium& staticEquilibrium = cachedLibrary(fullbody);
   centroidal_dynamics::EquilibriumAlgorithm alg = EQUILIBRIUM_ALGORITHM_PP;
-  setupLibrary(fullbody, state, staticEquilibrium, alg, friction);
+  setupLibrary(context, state, staticEquilibrium, alg, friction);
 #ifdef PROFILE
   watch.stop("test balance");
 #endif
@@ -236,8 +272,14 @@ std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const RbPrmFullBodyPtr_t full
   return res;
 }
 
-double IsStable(const RbPrmFullBodyPtr_t fullbody, State& state, fcl::Vec3f acc, fcl::Vec3f com,
+std::pair<MatrixXX, VectorX> ComputeCentroidalCone(const RbPrmFullBodyPtr_t fullbody, State& state,
+                                                   const hpp::core::value_type friction) {
+  return ComputeCentroidalCone(KinematicContext::shared(fullbody), state, friction);
+}
+
+double IsStable(const KinematicContextPtr_t& context, State& state, fcl::Vec3f acc, fcl::Vec3f com,
                 const centroidal_dynamics::EquilibriumAlgorithm algorithm) {
+  const RbPrmFullBodyPtr_t& fullbody = context->fullBody();
 #ifdef PROFILE
   RbPrmProfiler& watch = getRbPrmProfiler();
   watch.start("test balance");
@@ -253,8 +295,8 @@ double IsStable(const RbPrmFullBodyPtr_t fullbody, State& state, fcl::Vec3f acc,
       hppDout(notice, "new acceleration = " << acc);
     }
   }
-  Equilibrium staticEquilibrium(initLibrary(fullbody));
-  centroidal_dynamics::Vector3 comComputed = setupLibrary(fullbody, state, staticEquilibrium, alg);
+  Equilibrium& staticEquilibrium = cachedLibrary(fullbody);
+  centroidal_dynamics::Vector3 comComputed = setupLibrary(context, state, staticEquilibrium, alg);
   if (!com.isZero()) {
     hppDout(notice, "isStable : a CoM was given as parameter, use this one. : " << com);
     comComputed = centroidal_dynamics::Vector3(com);
@@ -307,6 +349,11 @@ double IsStable(const RbPrmFullBodyPtr_t fullbody, State& state, fcl::Vec3f acc,
       hppDout(notice,"h = "<<h);*/
   return res;
 }
+
+double IsStable(const RbPrmFullBodyPtr_t fullbody, State& state, fcl::Vec3f acc, fcl::Vec3f com,
+                const centroidal_dynamics::EquilibriumAlgorithm algorithm) {
+  return IsStable(KinematicContext::shared(fullbody), state, acc, com, algorithm);
+}
 }  // namespace stability
 }  // namespace rbprm
 }  // namespace hpp
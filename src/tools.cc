@@ -18,6 +18,12 @@
 #include <Eigen/Geometry>
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <hpp/pinocchio/joint.hh>
 #include <hpp/pinocchio/device.hh>
 #include <hpp/pinocchio/liegroup.hh>
@@ -118,15 +124,19 @@ void LockJoint(const pinocchio::JointPtr_t joint, hpp::core::ConfigProjectorPtr_
 }
 
 void LockJointRec(const std::string& spared, const pinocchio::JointPtr_t joint,
-                  hpp::core::ConfigProjectorPtr_t projector) {
+                  hpp::core::ConfigProjectorPtr_t projector, std::vector<constraints::ImplicitPtr_t>* lockedJoints,
+                  const constraints::ComparisonType comparison) {
   if (joint->name() == spared) return;
   const core::Configuration_t& c = joint->robot()->currentConfiguration();
   core::size_type rankInConfiguration(joint->rankInConfiguration());
-  projector->add(core::LockedJoint::create(
+  core::LockedJointPtr_t lockedJoint = core::LockedJoint::create(
       joint,
-      hpp::core::LiegroupElement(c.segment(rankInConfiguration, joint->configSize()), joint->configurationSpace())));
+      hpp::core::LiegroupElement(c.segment(rankInConfiguration, joint->configSize()), joint->configurationSpace()));
+  lockedJoint->comparisonType(constraints::ComparisonTypes_t(joint->numberDof(), comparison));
+  projector->add(lockedJoint);
+  if (lockedJoints) lockedJoints->push_back(lockedJoint);
   for (std::size_t i = 0; i < joint->numberChildJoints(); ++i) {
-    LockJointRec(spared, joint->childJoint(i), projector);
+    LockJointRec(spared, joint->childJoint(i), projector, lockedJoints, comparison);
   }
 }
 
@@ -263,6 +273,149 @@ fcl::Matrix3f readRotMatrixFCL(std::ifstream& myfile, std::string& line) {
   return res;
 }
 
+const char BinaryMagic[8] = {'R', 'B', 'P', 'R', 'M', 'D', 'B', '\0'};
+
+bool isBinaryDatabase(const std::string& path) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  char magic[sizeof(BinaryMagic)];
+  if (!file.read(magic, sizeof(BinaryMagic))) return false;
+  return std::memcmp(magic, BinaryMagic, sizeof(BinaryMagic)) == 0;
+}
+
+MappedFile::MappedFile(const std::string& path) : data_(0), size_(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Impossible to open database " + path);
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("Impossible to read size of database " + path);
+  }
+  size_ = (std::size_t)st.st_size;
+  if (size_ > 0) {
+    void* mapped = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Impossible to map database " + path);
+    }
+    data_ = static_cast<const char*>(mapped);
+  }
+  // the mapping remains valid once the descriptor is closed
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_) munmap(const_cast<char*>(data_), size_);
+}
+
+void BinaryWriter::pad(const std::size_t size) {
+  static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  const std::size_t remainder = size % 8;
+  if (remainder != 0) output_.write(zeros, 8 - remainder);
+}
+
+void BinaryWriter::writeU64(const uint64_t value) {
+  output_.write(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+}
+
+void BinaryWriter::writeDouble(const double value) {
+  output_.write(reinterpret_cast<const char*>(&value), sizeof(double));
+}
+
+void BinaryWriter::writeDoubles(const double* values, const std::size_t size) {
+  output_.write(reinterpret_cast<const char*>(values), size * sizeof(double));
+}
+
+void BinaryWriter::writeString(const std::string& value) { writeBlob(value); }
+
+void BinaryWriter::writeBlob(const std::string& blob) {
+  writeU64(blob.size());
+  output_.write(blob.data(), blob.size());
+  pad(blob.size());
+}
+
+void BinaryWriter::writeVecFCL(const fcl::Vec3f& vec) {
+  for (int i = 0; i < 3; ++i) writeDouble(vec[i]);
+}
+
+void BinaryWriter::writeRotMatrixFCL(const fcl::Matrix3f& mat) {
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) writeDouble(mat(i, j));
+}
+
+const char* BinaryReader::advance(const std::size_t size) {
+  if ((std::size_t)(end_ - current_) < size) throw std::runtime_error("Binary database is truncated");
+  const char* res = current_;
+  current_ += size;
+  return res;
+}
+
+uint64_t BinaryReader::readU64() {
+  uint64_t res;
+  std::memcpy(&res, advance(sizeof(uint64_t)), sizeof(uint64_t));
+  return res;
+}
+
+double BinaryReader::readDouble() {
+  double res;
+  std::memcpy(&res, advance(sizeof(double)), sizeof(double));
+  return res;
+}
+
+const double* BinaryReader::readDoubles(const std::size_t size) {
+  return reinterpret_cast<const double*>(advance(size * sizeof(double)));
+}
+
+std::string BinaryReader::readString() {
+  std::size_t size;
+  const char* data = readBlob(size);
+  return std::string(data, size);
+}
+
+const char* BinaryReader::readBlob(std::size_t& blobSize) {
+  blobSize = (std::size_t)readU64();
+  const char* res = advance(blobSize);
+  if (blobSize % 8 != 0) advance(8 - blobSize % 8);
+  return res;
+}
+
+fcl::Vec3f BinaryReader::readVecFCL() {
+  fcl::Vec3f res;
+  for (int i = 0; i < 3; ++i) res[i] = readDouble();
+  return res;
+}
+
+fcl::Matrix3f BinaryReader::readRotMatrixFCL() {
+  fcl::Matrix3f res;
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) res(i, j) = readDouble();
+  return res;
+}
+
+namespace {
+uint64_t magicNumber() {
+  uint64_t res;
+  std::memcpy(&res, BinaryMagic, sizeof(uint64_t));
+  return res;
+}
+}  // namespace
+
+void writeBinaryHeader(BinaryWriter& writer) {
+  writer.writeU64(magicNumber());
+  writer.writeU64(BinaryByteOrder);
+  writer.writeU64(BinaryVersion);
+}
+
+uint64_t readBinaryHeader(BinaryReader& reader) {
+  if (reader.readU64() != magicNumber())
+    throw std::runtime_error("Not a binary limb database");
+  if (reader.readU64() != BinaryByteOrder)
+    throw std::runtime_error("Binary limb database was written with a different byte order");
+  uint64_t version = reader.readU64();
+  if (version == 0 || version > BinaryVersion)
+    throw std::runtime_error("Unsupported binary limb database version");
+  return version;
+}
+
 }  // namespace io
 }  // namespace tools
 }  // namespace hpp
@@ -19,10 +19,7 @@ Point TriangleNormal(TrianglePoints& tri) {
 }
 BVHModelOBConst_Ptr_t GetModel(const hpp::pinocchio::CollisionObjectConstPtr_t object,
                                hpp::pinocchio::DeviceData& deviceData) {
-  assert(object->fcl()->collisionGeometry()->getNodeType() == fcl::BV_OBBRSS);
-  const BVHModelOBConst_Ptr_t model =
-      boost::static_pointer_cast<const hpp::fcl::BVHModel<hpp::fcl::OBBRSS> >(object->fcl()->collisionGeometry());
-  assert(model->getModelType() == hpp::fcl::BVH_MODEL_TRIANGLES);
+  const BVHModelOBConst_Ptr_t model = GetLocalModel(object);
   // todo avoid recopy, but if we keep the same ptr the geometry is changed
   const BVHModelOBConst_Ptr_t modelTransform(new BVHModelOB(*model));
   for (int i = 0; i < model->num_vertices; i++) {
@@ -31,6 +28,14 @@ BVHModelOBConst_Ptr_t GetModel(const hpp::pinocchio::CollisionObjectConstPtr_t o
   return modelTransform;
 }
 
+BVHModelOBConst_Ptr_t GetLocalModel(const hpp::pinocchio::CollisionObjectConstPtr_t object) {
+  assert(object->fcl()->collisionGeometry()->getNodeType() == fcl::BV_OBBRSS);
+  const BVHModelOBConst_Ptr_t model =
+      boost::static_pointer_cast<const hpp::fcl::BVHModel<hpp::fcl::OBBRSS> >(object->fcl()->collisionGeometry());
+  assert(model->getModelType() == hpp::fcl::BVH_MODEL_TRIANGLES);
+  return model;
+}
+
 double dot(CPointRef a, CPointRef b) { return a[0] * b[0] + a[1] * b[1]; }
 
 double isLeft(CPointRef lA, CPointRef lB, CPointRef p2) {
@@ -577,19 +582,26 @@ T_Point intersectSegmentPlane(Point s0, Point s1, Eigen::Vector3d pn, Point p0)
 }
 
 T_Point intersectPolygonePlane(BVHModelOBConst_Ptr_t polygone, BVHModelOBConst_Ptr_t plane, Eigen::Ref<Point> Pn) {
-  T_Point res, sortedRes;
-  T_Point intersection;
   // compute plane equation (normal, point inside the plan)
   Point P0;
   computePlanEquation(plane, Pn, P0);
+  return intersectPolygonePlane(polygone, hpp::fcl::Transform3f(), Pn, P0);
+}
+
+T_Point intersectPolygonePlane(BVHModelOBConst_Ptr_t polygone, const hpp::fcl::Transform3f& transform, CPointRef Pn,
+                               CPointRef P0) {
+  T_Point res, sortedRes;
+  T_Point intersection;
+  // place the vertices once, instead of copying the whole model
+  T_Point vertices(polygone->num_vertices);
+  for (int i = 0; i < polygone->num_vertices; ++i) vertices[i] = transform.transform(polygone->vertices[i]);
   for (int i = 0; i < polygone->num_tris;
        i++) {  // FIXME : can test 2 times the same line (in both triangles), avoid this ?
     // hppDout(info,"triangle : "<<i);
     for (int j = 0; j < 3; j++) {
       // hppDout(info,"couple : "<<j);
-      intersection =
-          intersectSegmentPlane(polygone->vertices[polygone->tri_indices[i][j]],
-                                polygone->vertices[polygone->tri_indices[i][((j == 2) ? 0 : (j + 1))]], Pn, P0);
+      intersection = intersectSegmentPlane(vertices[polygone->tri_indices[i][j]],
+                                           vertices[polygone->tri_indices[i][((j == 2) ? 0 : (j + 1))]], Pn, P0);
       if (intersection.size() > 0) res.insert(res.end(), intersection.begin(), intersection.end());
     }
   }
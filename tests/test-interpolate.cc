@@ -16,20 +16,25 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
 
-#include "test-tools.hh"
+#define BOOST_TEST_MODULE test - interpolate
+#include <pinocchio/fwd.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/core/problem-solver.hh>
+#include <hpp/core/path-vector.hh>
+#include <hpp/core/collision-validation-report.hh>
+#include "hpp/rbprm/contact_generation/reachability.hh"
 #include "hpp/rbprm/interpolation/rbprm-path-interpolation.hh"
+#include "hpp/rbprm/kinematic-context.hh"
 #include "hpp/rbprm/rbprm-fullbody.hh"
 #include "hpp/rbprm/rbprm-state.hh"
-#include "hpp/core/straight-path.hh"
 #include "hpp/rbprm/tools.hh"
-
-#define BOOST_TEST_MODULE test - fullbody
-#include <boost/test/included/unit_test.hpp>
+#include "tools-fullbody.hh"
+#include "tools-obstacle.hh"
 
 BOOST_AUTO_TEST_SUITE(test_rbprm)
 
 using namespace hpp;
-using namespace hpp::model;
 using namespace hpp::rbprm;
 using namespace hpp::rbprm::interpolation;
 
@@ -62,9 +67,18 @@ void AddToState(const std::string& name, const fcl::Transform3f& transform, cons
   state.contactRotation_[name] = transform.getRotation();
 }
 
-void addState(const State& s1, T_StateFrame& states) { states.push_back(std::make_pair(states.size(), s1)); }
+// the states added have different configurations, the filters removing the states that do not move the robot
+void addState(const State& s1, T_StateFrame& states) {
+  State state(s1);
+  state.configuration_ = core::Configuration_t::Constant(1, (core::value_type)states.size());
+  states.push_back(std::make_pair(states.size(), state));
+}
 
 BOOST_AUTO_TEST_CASE(FilteringStates) {
+  // the substitutions of the deep filter, which use the robot, are not tried on these sequences
+  State empty;
+  RbPrmInterpolationPtr_t interpolation = RbPrmInterpolation::create(RbPrmFullBodyPtr_t(), empty, empty,
+                                                                     core::PathVectorConstPtr_t(), false);
   fcl::Vec3f nz(0, 0, 1);
   fcl::Vec3f ny(0, 1, 0);
   fcl::Transform3f id, x, y, z, rx;
@@ -105,8 +119,8 @@ BOOST_AUTO_TEST_CASE(FilteringStates) {
   addState(s0, states);
   addState(s3, states);
   addState(s4, states);
-  BOOST_CHECK_MESSAGE(FilterStates(states, true).size() == 2, "State list not filtered");
-  BOOST_CHECK_MESSAGE((FilterStates(states, true).back().first == 2),
+  BOOST_CHECK_MESSAGE(interpolation->FilterStates(states, true).size() == 2, "State list not filtered");
+  BOOST_CHECK_MESSAGE((interpolation->FilterStates(states, true).back().first == 2),
                       "middle state not filtered");  // middle state is removed
 
   // add x two times, then reposition x (transform)
@@ -115,8 +129,8 @@ BOOST_AUTO_TEST_CASE(FilteringStates) {
   AddToState("2", y, nz, s4a);
 
   addState(s4a, states);
-  BOOST_CHECK(FilterStates(states, true).size() == 2);
-  BOOST_CHECK(FilterStates(states, true).back().first == 3);  // middle state is removed
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == 2);
+  BOOST_CHECK(interpolation->FilterStates(states, true).back().first == 3);  // middle state is removed
 
   // x then y => no shortcut
   State s5;
@@ -130,7 +144,7 @@ BOOST_AUTO_TEST_CASE(FilteringStates) {
   addState(s0, states);
   addState(s5, states);
   addState(s6, states);
-  BOOST_CHECK(FilterStates(states, true).size() == 3);
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == 3);
 
   // break, then recreate
   State s7, s8;
@@ -139,8 +153,8 @@ BOOST_AUTO_TEST_CASE(FilteringStates) {
   addState(s0, states);
   addState(s7, states);
   addState(s8, states);
-  BOOST_CHECK(FilterStates(states, true).size() == 2);
-  BOOST_CHECK(FilterStates(states, true).back().first == 2);  // middle state is removed
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == 2);
+  BOOST_CHECK(interpolation->FilterStates(states, true).back().first == 2);  // middle state is removed
 
   // break, then recreate with other
   State s9, s10;
@@ -149,7 +163,7 @@ BOOST_AUTO_TEST_CASE(FilteringStates) {
   addState(s0, states);
   addState(s9, states);
   addState(s10, states);
-  BOOST_CHECK(FilterStates(states, true).size() == 3);
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == 3);
 
   // No contact variation
   states.clear();
@@ -158,6 +172,157 @@ BOOST_AUTO_TEST_CASE(FilteringStates) {
   addState(s0, states);
   addState(s0, states);
   addState(s0, states);
-  BOOST_CHECK(FilterStates(states, true).size() == 2);
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == 2);
+}
+
+// break the contact of the right foot of talos in q0, then recreate it in q
+void addStep(const RbPrmFullBodyPtr_t& fullBody, const Configuration_t& q0, const Configuration_t& q,
+             T_StateFrame& states) {
+  const State s0 = createState(fullBody, q0);
+  const State s1 = createState(fullBody, q);
+  State flying(s1);
+  flying.RemoveContact("talos_rleg_rom");
+  states.push_back(std::make_pair(0., s0));
+  states.push_back(std::make_pair(1., flying));
+  states.push_back(std::make_pair(2., s1));
+}
+
+// the break-create filter removes the flying state if the step is reachable, with the memoized reachability
+// tests giving the same results as the ones of the reachability test
+BOOST_AUTO_TEST_CASE(FilteringStatesReachability) {
+  RbPrmFullBodyPtr_t fullBody = loadTalos();
+  Configuration_t q0(fullBody->device_->configSize()), q02(fullBody->device_->configSize()),
+      q09(fullBody->device_->configSize());
+  // configurations of reachable_quasiStatic_rightFoot_front
+  q0 << 0.0, 0.0, 1.02127, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, -0.411354, 0.859395, -0.448041, -0.001708, 0.0, 0.0,
+      -0.411354, 0.859395, -0.448041, -0.001708, 0.0, 0.006761, 0.25847, 0.173046, -0.0002, -0.525366, 0.0, -0.0, 0.1,
+      -0.005, -0.25847, -0.173046, 0.0002, -0.525366, 0.0, 0.0, 0.1, -0.005, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  q02 << 0.0862078969760845, -0.008573254826838248, 1.012966620241554, 0.00824138443696191, -0.011008100927513427,
+      0.014396883219563509, 0.999801795882611, -0.028773943202354116, -0.009480497694556939, -0.256695879641705,
+      0.876446746404094, -0.5979736009941322, -0.009026468249301131, -0.028771659024478216, -0.009585374914341768,
+      -0.5646859416963076, 0.8507868052041541, -0.26432357597021416, -0.007213760150053602, 0.0, 0.006761, 0.25847,
+      0.173046, -0.0002, -0.525366, 0.0, 0.0, 0.1, -0.005, -0.25847, -0.173046, 0.0002, -0.525366, 0.0, 0.0, 0.1,
+      -0.005, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  q09 << 0.4441791069457251, -0.027671061547016696, 0.8586668752399875, 0.032435659988807417, -0.013291512485512254,
+      0.0730592572981457, 0.9967113968346009, -0.14622490504118635, -0.03856085996297086, 0.36293907011755616,
+      0.8312357164664202, -1.1724006678502423, -0.02980328498379143, -0.1461398509807246, -0.0424627165490291,
+      -1.087380902472244, 0.7408550080133347, 0.36830345789686386, -0.024192532270797932, 0.0, 0.006761, 0.25847,
+      0.173046, -0.0002, -0.525366, 0.0, 0.0, 0.1, -0.005, -0.25847, -0.173046, 0.0002, -0.525366, 0.0, 0.0, 0.1,
+      -0.005, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  const State s0 = createState(fullBody, q0);
+  RbPrmInterpolationPtr_t interpolation =
+      RbPrmInterpolation::create(fullBody, s0, s0, core::PathVectorConstPtr_t(), true, true);
+
+  T_StateFrame states;
+  addStep(fullBody, q0, q02, states);
+  BOOST_CHECK(reachability::isReachable(fullBody, states[0].second, states[2].second).success());
+  T_StateFrame filtered = interpolation->FilterStates(states, true);
+  BOOST_CHECK(filtered.size() == 2);
+  BOOST_CHECK(filtered.back().first == 2.);
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == filtered.size());
+
+  states.clear();
+  addStep(fullBody, q0, q09, states);
+  BOOST_CHECK(!reachability::isReachable(fullBody, states[0].second, states[2].second).success());
+  filtered = interpolation->FilterStates(states, true);
+  BOOST_CHECK(filtered.size() == 3);
+  BOOST_CHECK(interpolation->FilterStates(states, true).size() == filtered.size());
+}
+
+// interpolation of path with HyQ, from a state to another with all the legs in contact
+RbPrmInterpolationPtr_t createInterpolation(const RbPrmFullBodyPtr_t& fullBody, const core::PathVectorPtr_t& path) {
+  Configuration_t q = fullBody->device_->currentConfiguration();
+  q[2] += 0.02;
+  bool success;
+  q.head<3>() = path->operator()(0., success).head<3>();
+  State startState = createState(fullBody, q);
+  q.head<3>() = path->operator()(path->length(), success).head<3>();
+  State endState = createState(fullBody, q);
+  return RbPrmInterpolation::create(fullBody, startState, endState, path, false, true);
+}
+
+// the effectors in contact must be at their contact positions, and the states created collision free
+void checkContactSequence(const RbPrmFullBodyPtr_t& fullBody, const T_StateFrame& states) {
+  BOOST_REQUIRE(states.size() > 2);
+  for (CIT_StateFrame cit = states.begin(); cit != states.end(); ++cit) {
+    const State& state = cit->second;
+    fullBody->device_->currentConfiguration(state.configuration_);
+    fullBody->device_->computeForwardKinematics();
+    for (std::map<std::string, bool>::const_iterator lit = state.contacts_.begin(); lit != state.contacts_.end();
+         ++lit) {
+      if (!lit->second) continue;
+      const fcl::Vec3f position = fullBody->GetLimb(lit->first)->effector_.currentTransformation().translation();
+      BOOST_CHECK_SMALL((position - state.contactPositions_.at(lit->first)).norm(), 1e-3);
+    }
+    if (cit == states.begin() || cit + 1 == states.end()) continue;
+    core::ValidationReportPtr_t report(new core::CollisionValidationReport);
+    BOOST_CHECK(fullBody->GetCollisionValidation()->validate(state.configuration_, report));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(interpolate_path_parallel) {
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = planDarpa(bShooter);
+  PathVectorPtr_t resPath = ps->paths().back();
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  RbPrmInterpolationPtr_t interpolator = createInterpolation(fullBody, resPath);
+  // the contacts are maintained ahead on several configurations
+  interpolator->workers_ = createKinematicContexts(fullBody, 4);
+  BOOST_REQUIRE(interpolator->workers_.size() > 1);
+
+  T_StateFrame states = interpolator->Interpolate(ps->affordanceObjects, bShooter.affFilter_, 0.01, 8, false);
+  checkContactSequence(fullBody, states);
+  bool success;
+  const core::value_type xEnd = resPath->operator()(resPath->length(), success)[0];
+  BOOST_CHECK(states.back().second.configuration_[0] > (xEnd - 0.1));
+}
+// the two sequences have the same states, at the same times
+void checkSameStates(const T_StateFrame& states, const T_StateFrame& others) {
+  BOOST_REQUIRE_EQUAL(states.size(), others.size());
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    BOOST_CHECK_SMALL(states[i].first - others[i].first, 1e-9);
+    const State& state = states[i].second;
+    const State& other = others[i].second;
+    BOOST_CHECK(state.contactBreaks(other).empty());
+    BOOST_CHECK(state.contactCreations(other).empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(interpolate_adaptive_step) {
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = planDarpa(bShooter);
+  PathVectorPtr_t resPath = ps->paths().back();
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  RbPrmInterpolationPtr_t fixed = createInterpolation(fullBody, resPath);
+  RbPrmInterpolationPtr_t adaptive = createInterpolation(fullBody, resPath);
+  adaptive->adaptiveStep_ = true;
+  bool success;
+  const core::value_type xEnd = resPath->operator()(resPath->length(), success)[0];
+
+  const T_StateFrame fixedStates = fixed->Interpolate(ps->affordanceObjects, bShooter.affFilter_, 0.01, 8, false);
+  const T_StateFrame adaptiveStates =
+      adaptive->Interpolate(ps->affordanceObjects, bShooter.affFilter_, 0.01, 8, false);
+  checkContactSequence(fullBody, fixedStates);
+  checkContactSequence(fullBody, adaptiveStates);
+  BOOST_CHECK(fixedStates.back().second.configuration_[0] > (xEnd - 0.1));
+  BOOST_CHECK(adaptiveStates.back().second.configuration_[0] > (xEnd - 0.1));
+
+  // a short motion of the root along which all the contacts are kept: the configurations skipped by the
+  // adaptive step are the ones where the fixed step keeps the last state
+  Configuration_t q = fullBody->device_->currentConfiguration();
+  q[2] += 0.02;
+  q.head<3>() = resPath->operator()(0., success).head<3>();
+  T_Configuration configs;
+  for (std::size_t i = 0; i <= 20; ++i) {
+    configs.push_back(q);
+    configs.back()[0] += 0.005 * (core::value_type)i;
+  }
+  const State start = createState(fullBody, configs.front());
+  const State end = createState(fullBody, configs.back());
+  fixed = RbPrmInterpolation::create(fullBody, start, end, core::PathVectorConstPtr_t(), false, true);
+  adaptive = RbPrmInterpolation::create(fullBody, start, end, core::PathVectorConstPtr_t(), false, true);
+  adaptive->adaptiveStep_ = true;
+  checkSameStates(fixed->Interpolate(ps->affordanceObjects, bShooter.affFilter_, configs, 0., 0.01),
+                  adaptive->Interpolate(ps->affordanceObjects, bShooter.affFilter_, configs, 0., 0.01));
 }
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,11 +22,21 @@
 
 #include <hpp/core/problem-solver.hh>
 #include <hpp/core/path-vector.hh>
+#include <hpp/core/kinodynamic-distance.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/connected-component.hh>
+#include <hpp/core/node.hh>
+#include <hpp/rbprm/planner/rbprm-roadmap.hh>
 #include <hpp/rbprm/rbprm-device.hh>
 #include "tools-fullbody.hh"
 #include "tools-obstacle.hh"
 #include <hpp/pinocchio/configuration.hh>
 
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <set>
+
 using namespace hpp;
 using namespace rbprm;
 
@@ -209,6 +219,385 @@ BOOST_AUTO_TEST_CASE(straight_line) {
   BOOST_CHECK_EQUAL(pv->numberPaths(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(straight_line_adaptive_step_validation) {
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadSimpleHumanoidAbsract();
+  rbprmDevice->setDimensionExtraConfigSpace(6);
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
+  hpp::core::ProblemSolver& pSolver = *ps;
+  loadObstacleWithAffordance(pSolver, std::string("hpp_environments"), std::string("multicontact/ground"),
+                             std::string("planning"));
+  pSolver.configurationShooterType(std::string("RbprmShooter"));
+  pSolver.pathValidationType(std::string("RbprmPathValidation"), 0.05);
+  pSolver.distanceType(std::string("Kinodynamic"));
+  pSolver.steeringMethodType(std::string("RBPRMKinodynamic"));
+  pSolver.pathPlannerType(std::string("DynamicPlanner"));
+  double aMax = 0.1;
+  double vMax = 0.3;
+  pSolver.problem()->setParameter(std::string("Kinodynamic/velocityBound"), core::Parameter(vMax));
+  pSolver.problem()->setParameter(std::string("Kinodynamic/accelerationBound"), core::Parameter(aMax));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/sizeFootX"), core::Parameter(0.2));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/sizeFootY"), core::Parameter(0.12));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/friction"), core::Parameter(0.5));
+  pSolver.problem()->setParameter(std::string("ConfigurationShooter/sampleExtraDOF"), core::Parameter(false));
+
+  core::Configuration_t q_init(rbprmDevice->configSize());
+  q_init << 0, 0, 1.0, 0, 0, 0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  core::Configuration_t q_goal = q_init;
+  q_goal(0) = 1.5;
+  pSolver.initConfig(ConfigurationPtr_t(new core::Configuration_t(q_init)));
+  pSolver.addGoalConfig(ConfigurationPtr_t(new core::Configuration_t(q_goal)));
+  pSolver.solve();
+  core::PathPtr_t path = pSolver.paths().back();
+
+  RbPrmPathValidationPtr_t pathValidation =
+      std::dynamic_pointer_cast<RbPrmPathValidation>(pSolver.problem()->pathValidation());
+  BOOST_REQUIRE(pathValidation);
+  BOOST_CHECK(!pathValidation->adaptiveStep());
+  core::PathPtr_t validPart;
+  core::PathValidationReportPtr_t report;
+  BOOST_CHECK(pathValidation->validate(path, false, validPart, report));
+  // the root moves slower than sqrt(2) * vMax, and does not rotate
+  pathValidation->setAdaptiveStep(1., 1., 0.5, 1e-3);
+  BOOST_CHECK(pathValidation->adaptiveStep());
+  BOOST_CHECK(pathValidation->validate(path, false, validPart, report));
+  BOOST_CHECK_CLOSE(validPart->length(), path->length(), 1e-6);
+  BOOST_CHECK(pathValidation->validate(path, true, validPart, report));
+  BOOST_CHECK_CLOSE(validPart->length(), path->length(), 1e-6);
+
+  // the trunk of the robot goes through the ground
+  core::Configuration_t q_below = q_goal;
+  q_below(2) = -1.;
+  core::PathPtr_t invalidPath = (*pSolver.problem()->steeringMethod())(q_init, q_below);
+  BOOST_REQUIRE(invalidPath);
+  BOOST_CHECK(!pathValidation->validate(invalidPath, false, validPart, report));
+  BOOST_CHECK(validPart->length() < invalidPath->length());
+  pathValidation->setConstantStep();
+  BOOST_CHECK(!pathValidation->adaptiveStep());
+  BOOST_CHECK(!pathValidation->validate(invalidPath, false, validPart, report));
+
+  // in bisection order, the valid parts are the same as in time order
+  core::PathPtr_t reverseValidPart;
+  BOOST_CHECK(!pathValidation->validate(invalidPath, true, reverseValidPart, report));
+  pathValidation->setBisectionOrder(true);
+  core::PathPtr_t bisectionValidPart;
+  BOOST_CHECK(!pathValidation->validate(invalidPath, false, bisectionValidPart, report));
+  BOOST_CHECK_CLOSE(bisectionValidPart->length(), validPart->length(), 1e-6);
+  BOOST_CHECK(!pathValidation->validate(invalidPath, true, bisectionValidPart, report));
+  BOOST_CHECK_CLOSE(bisectionValidPart->length(), reverseValidPart->length(), 1e-6);
+  BOOST_CHECK(!pathValidation->isValid(invalidPath, report));
+  BOOST_CHECK(pathValidation->validate(path, false, bisectionValidPart, report));
+  BOOST_CHECK(pathValidation->isValid(path, report));
+
+  // the broadphase does not change the result of the validations
+  pathValidation->setBisectionOrder(false);
+  RbPrmValidationPtr_t validator = pathValidation->getValidator();
+  validator->useBroadPhase(true);
+  BOOST_REQUIRE(validator->broadPhase());
+  BOOST_CHECK(validator->broadPhase()->size() > 0);
+  BOOST_CHECK(validator->validate(q_init));
+  core::Configuration_t q_ground = q_init;
+  q_ground(2) = 0.;
+  BOOST_CHECK(!validator->validate(q_ground));
+  core::PathPtr_t broadPhaseValidPart;
+  BOOST_CHECK(!pathValidation->validate(invalidPath, false, broadPhaseValidPart, report));
+  BOOST_CHECK_CLOSE(broadPhaseValidPart->length(), validPart->length(), 1e-6);
+  BOOST_CHECK(pathValidation->validate(path, false, broadPhaseValidPart, report));
+  validator->useBroadPhase(false);
+  BOOST_CHECK(!validator->broadPhase());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_planner) {
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadSimpleHumanoidAbsract();
+  rbprmDevice->setDimensionExtraConfigSpace(6);
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
+  hpp::core::ProblemSolver& pSolver = *ps;
+  loadObstacleWithAffordance(pSolver, std::string("hpp_environments"), std::string("multicontact/ground"),
+                             std::string("planning"));
+  pSolver.configurationShooterType(std::string("RbprmShooter"));
+  pSolver.pathValidationType(std::string("RbprmPathValidation"), 0.05);
+  pSolver.distanceType(std::string("Kinodynamic"));
+  pSolver.steeringMethodType(std::string("RBPRMKinodynamic"));
+  pSolver.pathPlannerType(std::string("DynamicPlanner"));
+  double aMax = 0.5;
+  double vMax = 1.;
+  pSolver.problem()->setParameter(std::string("Kinodynamic/velocityBound"), core::Parameter(vMax));
+  pSolver.problem()->setParameter(std::string("Kinodynamic/accelerationBound"), core::Parameter(aMax));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/sizeFootX"), core::Parameter(0.2));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/sizeFootY"), core::Parameter(0.12));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/friction"), core::Parameter(0.5));
+  pSolver.problem()->setParameter(std::string("ConfigurationShooter/sampleExtraDOF"), core::Parameter(false));
+
+  core::Configuration_t q_init(rbprmDevice->configSize());
+  q_init << 0, 0, 1.0, 0, 0, 0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  core::Configuration_t q_goal = q_init;
+  q_goal(0) = 1.;
+  q_goal(1) = 1.;
+  pSolver.initConfig(ConfigurationPtr_t(new core::Configuration_t(q_init)));
+  pSolver.addGoalConfig(ConfigurationPtr_t(new core::Configuration_t(q_goal)));
+  // initializes the problem (path validation, shooter, ...)
+  BOOST_CHECK(pSolver.prepareSolveStepByStep());
+
+  // the roadmap is only extended by random steps, without trying the direct connection
+  DynamicPlannerPtr_t planner = DynamicPlanner::create(pSolver.problem());
+  for (std::size_t i = 0; i < 2; ++i)
+    planner->addWorker(bShooter.createPathValidation(rbprmDevice, 0.05, ps));
+  BOOST_CHECK_EQUAL(planner->numberOfWorkers(), 2);
+  BOOST_CHECK(rbprmDevice->numberDeviceData() >= 2);
+  planner->startSolve();
+  for (std::size_t i = 0; i < 1000 && !planner->roadmap()->pathExists(); ++i) planner->oneStep();
+  BOOST_REQUIRE(planner->roadmap()->pathExists());
+  BOOST_CHECK(planner->roadmap()->nodes().size() > 2);
+
+  core::PathVectorPtr_t path = planner->computePath();
+  BOOST_REQUIRE(path);
+  BOOST_CHECK(path->initial() == q_init);
+  BOOST_CHECK(path->end() == q_goal);
+  BOOST_CHECK(checkPathVector(path));
+  core::PathPtr_t validPart;
+  core::PathValidationReportPtr_t report;
+  for (std::size_t i = 0; i < path->numberPaths(); ++i)
+    BOOST_CHECK(pSolver.problem()->pathValidation()->validate(path->pathAtRank(i), false, validPart, report));
+}
+
+// random configuration of the root of the simple humanoid, velocities and accelerations
+// being up to twice their bounds
+core::Configuration_t randomKinodynamicConfiguration(const DevicePtr_t& robot, const double vMax, const double aMax) {
+  core::Configuration_t q(robot->configSize());
+  q.head<3>() = 2. * Eigen::Vector3d::Random();
+  q.segment<4>(3) << 0., 0., 0., 1.;
+  const size_type extraIndex = robot->configSize() - robot->extraConfigSpace().dimension();
+  q.segment<3>(extraIndex) = 2. * vMax * Eigen::Vector3d::Random();
+  q.segment<3>(extraIndex + 3) = 2. * aMax * Eigen::Vector3d::Random();
+  return q;
+}
+
+std::set<std::size_t> nodeIndexes(const core::NodeVector_t& nodes, const std::map<core::NodePtr_t, std::size_t>& ids) {
+  std::set<std::size_t> res;
+  for (core::NodeVector_t::const_iterator cit = nodes.begin(); cit != nodes.end(); ++cit) res.insert(ids.at(*cit));
+  return res;
+}
+
+BOOST_AUTO_TEST_CASE(kinodynamic_nearest_neighbor) {
+  std::srand(0);
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadSimpleHumanoidAbsract();
+  rbprmDevice->setDimensionExtraConfigSpace(6);
+  const double vMax = 1.;
+  const double aMax = 0.5;
+  core::ProblemPtr_t problem = core::Problem::create(rbprmDevice);
+  problem->setParameter(std::string("Kinodynamic/velocityBound"), core::Parameter(vMax));
+  problem->setParameter(std::string("Kinodynamic/accelerationBound"), core::Parameter(aMax));
+  core::DistancePtr_t distance = core::KinodynamicDistance::createFromProblem(problem);
+  // the same nodes and edges are added to a roadmap with the default nearest neighbor of hpp-core
+  core::RoadmapPtr_t basic = core::Roadmap::create(distance, rbprmDevice);
+  core::RoadmapPtr_t indexed = core::RbprmRoadmap::create(distance, rbprmDevice, vMax, aMax);
+  BOOST_REQUIRE(std::dynamic_pointer_cast<KinodynamicNearestNeighbor>(indexed->nearestNeighbor()));
+
+  const std::size_t nbNodes = 300;
+  core::NodeVector_t basicNodes, indexedNodes;
+  std::map<core::NodePtr_t, std::size_t> basicIds, indexedIds;
+  for (std::size_t i = 0; i < nbNodes; ++i) {
+    core::ConfigurationPtr_t q(new core::Configuration_t(randomKinodynamicConfiguration(rbprmDevice, vMax, aMax)));
+    basicNodes.push_back(basic->addNode(q));
+    indexedNodes.push_back(indexed->addNode(q));
+    basicIds[basicNodes.back()] = i;
+    indexedIds[indexedNodes.back()] = i;
+  }
+  BOOST_CHECK_EQUAL(std::static_pointer_cast<KinodynamicNearestNeighbor>(indexed->nearestNeighbor())->size(), nbNodes);
+
+  const std::size_t K = 5;
+  for (std::size_t step = 0; step < 3; ++step) {
+    if (step > 0) {
+      // merges connected components, with edges in both directions
+      for (std::size_t i = 0; i < nbNodes / 2; ++i) {
+        const std::size_t from = std::rand() % nbNodes, to = std::rand() % nbNodes;
+        if (from == to) continue;
+        core::PathPtr_t path = core::PathVector::create(rbprmDevice->configSize(), rbprmDevice->numberDof());
+        basic->addEdge(basicNodes[from], basicNodes[to], path);
+        basic->addEdge(basicNodes[to], basicNodes[from], path);
+        indexed->addEdge(indexedNodes[from], indexedNodes[to], path);
+        indexed->addEdge(indexedNodes[to], indexedNodes[from], path);
+      }
+    }
+    BOOST_CHECK_EQUAL(basic->connectedComponents().size(), indexed->connectedComponents().size());
+    for (std::size_t i = 0; i < 20; ++i) {
+      const core::Configuration_t q = randomKinodynamicConfiguration(rbprmDevice, vMax, aMax);
+      // queries on the whole roadmap, and on the component of a random node
+      const std::size_t id = std::rand() % nbNodes;
+      const core::ConnectedComponentPtr_t basicComponents[2] = {core::ConnectedComponentPtr_t(),
+                                                                basicNodes[id]->connectedComponent()};
+      const core::ConnectedComponentPtr_t indexedComponents[2] = {core::ConnectedComponentPtr_t(),
+                                                                  indexedNodes[id]->connectedComponent()};
+      for (std::size_t c = 0; c < 2; ++c) {
+        core::value_type basicDistance, indexedDistance;
+        if (c > 0) {
+          for (std::size_t reverse = 0; reverse < 2; ++reverse) {
+            core::NodePtr_t basicNode =
+                basic->nearestNeighbor()->search(q, basicComponents[c], basicDistance, reverse > 0);
+            core::NodePtr_t indexedNode =
+                indexed->nearestNeighbor()->search(q, indexedComponents[c], indexedDistance, reverse > 0);
+            BOOST_REQUIRE(basicNode && indexedNode);
+            BOOST_CHECK_EQUAL(basicIds.at(basicNode), indexedIds.at(indexedNode));
+            BOOST_CHECK_CLOSE(basicDistance, indexedDistance, 1e-10);
+          }
+          const core::value_type radius = 2. * basicDistance;
+          BOOST_CHECK(nodeIndexes(basic->nearestNeighbor()->withinBall(q, basicComponents[c], radius), basicIds) ==
+                      nodeIndexes(indexed->nearestNeighbor()->withinBall(q, indexedComponents[c], radius), indexedIds));
+        }
+        core::Nodes_t basicNearest, indexedNearest;
+        if (c > 0) {
+          basicNearest = basic->nearestNeighbor()->KnearestSearch(q, basicComponents[c], K, basicDistance);
+          indexedNearest = indexed->nearestNeighbor()->KnearestSearch(q, indexedComponents[c], K, indexedDistance);
+        } else {
+          basicNearest = basic->nearestNeighbor()->KnearestSearch(q, basic, K, basicDistance);
+          indexedNearest = indexed->nearestNeighbor()->KnearestSearch(q, indexed, K, indexedDistance);
+        }
+        BOOST_REQUIRE_EQUAL(basicNearest.size(), indexedNearest.size());
+        BOOST_CHECK_CLOSE(basicDistance, indexedDistance, 1e-10);
+        // the nodes found by the basic search are not sorted by distance
+        std::set<std::size_t> basicSet, indexedSet;
+        for (core::Nodes_t::const_iterator cit = basicNearest.begin(); cit != basicNearest.end(); ++cit)
+          basicSet.insert(basicIds.at(*cit));
+        for (core::Nodes_t::const_iterator cit = indexedNearest.begin(); cit != indexedNearest.end(); ++cit)
+          indexedSet.insert(indexedIds.at(*cit));
+        BOOST_CHECK(basicSet == indexedSet);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_random_shortcut) {
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadSimpleHumanoidAbsract();
+  rbprmDevice->setDimensionExtraConfigSpace(6);
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
+  hpp::core::ProblemSolver& pSolver = *ps;
+  loadObstacleWithAffordance(pSolver, std::string("hpp_environments"), std::string("multicontact/ground"),
+                             std::string("planning"));
+  pSolver.configurationShooterType(std::string("RbprmShooter"));
+  pSolver.pathValidationType(std::string("RbprmPathValidation"), 0.05);
+  pSolver.distanceType(std::string("Kinodynamic"));
+  pSolver.steeringMethodType(std::string("RBPRMKinodynamic"));
+  pSolver.pathPlannerType(std::string("DynamicPlanner"));
+  double aMax = 0.5;
+  double vMax = 1.;
+  pSolver.problem()->setParameter(std::string("Kinodynamic/velocityBound"), core::Parameter(vMax));
+  pSolver.problem()->setParameter(std::string("Kinodynamic/accelerationBound"), core::Parameter(aMax));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/sizeFootX"), core::Parameter(0.2));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/sizeFootY"), core::Parameter(0.12));
+  pSolver.problem()->setParameter(std::string("DynamicPlanner/friction"), core::Parameter(0.5));
+  pSolver.problem()->setParameter(std::string("ConfigurationShooter/sampleExtraDOF"), core::Parameter(false));
+
+  core::Configuration_t q_init(rbprmDevice->configSize());
+  q_init << 0, 0, 1.0, 0, 0, 0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  core::Configuration_t q_goal = q_init;
+  q_goal(0) = 2.;
+  pSolver.initConfig(ConfigurationPtr_t(new core::Configuration_t(q_init)));
+  pSolver.addGoalConfig(ConfigurationPtr_t(new core::Configuration_t(q_goal)));
+  // initializes the problem (path validation, steering method, ...)
+  BOOST_CHECK(pSolver.prepareSolveStepByStep());
+
+  // detour through two waypoints, that the shortcuts can remove
+  core::Configuration_t q_1 = q_init, q_2 = q_init;
+  q_1(0) = 0.5;
+  q_1(1) = 1.;
+  q_2(0) = 1.5;
+  q_2(1) = -1.;
+  core::SteeringMethodPtr_t sm = pSolver.problem()->steeringMethod();
+  core::PathVectorPtr_t path = core::PathVector::create(rbprmDevice->configSize(), rbprmDevice->numberDof());
+  path->appendPath((*sm)(q_init, q_1));
+  path->appendPath((*sm)(q_1, q_2));
+  path->appendPath((*sm)(q_2, q_goal));
+  BOOST_REQUIRE(checkPathVector(path));
+
+  RandomShortcutDynamicPtr_t optimizer = RandomShortcutDynamic::create(pSolver.problem());
+  for (std::size_t i = 0; i < 2; ++i)
+    optimizer->addWorker(std::dynamic_pointer_cast<RbPrmPathValidation>(
+        bShooter.createPathValidation(rbprmDevice, 0.05, ps)));
+  BOOST_CHECK_EQUAL(optimizer->numberOfWorkers(), 2);
+  core::PathVectorPtr_t optimized = optimizer->optimize(path);
+  BOOST_REQUIRE(optimized);
+  BOOST_CHECK(optimized->initial() == q_init);
+  BOOST_CHECK(optimized->end() == q_goal);
+  BOOST_CHECK(optimized->length() <= path->length() + 1e-6);
+  BOOST_CHECK(checkPathVector(optimized));
+  core::PathPtr_t validPart;
+  core::PathValidationReportPtr_t report;
+  for (std::size_t i = 0; i < optimized->numberPaths(); ++i)
+    BOOST_CHECK(pSolver.problem()->pathValidation()->validate(optimized->pathAtRank(i), false, validPart, report));
+}
+
+BOOST_AUTO_TEST_CASE(acceleration_polytope) {
+  std::srand(0);
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadSimpleHumanoidAbsract();
+  rbprmDevice->setDimensionExtraConfigSpace(6);
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
+  loadObstacleWithAffordance(*ps, std::string("hpp_environments"), std::string("multicontact/ground"),
+                             std::string("planning"));
+  RbPrmPathValidationPtr_t pathValidation =
+      std::dynamic_pointer_cast<RbPrmPathValidation>(bShooter.createPathValidation(rbprmDevice, 0.05, ps));
+  BOOST_REQUIRE(pathValidation);
+  RbPrmValidationPtr_t validation = pathValidation->getValidator();
+  const core::ObjectStdVector_t& obstacles = ps->problem()->collisionObstacles();
+  for (core::ObjectStdVector_t::const_iterator cit = obstacles.begin(); cit != obstacles.end(); ++cit)
+    validation->addObstacle(*cit);
+  validation->computeAllContacts(true);
+
+  const double mass = rbprmDevice->mass();
+  const double mu = 0.5;
+  centroidal_dynamics::Equilibrium sEq(rbprmDevice->name(), mass, 4, centroidal_dynamics::SOLVER_LP_QPOASES, true, 10,
+                                       false);
+  for (std::size_t i = 0; i < 5; ++i) {
+    core::ConfigurationPtr_t q(new core::Configuration_t(rbprmDevice->configSize()));
+    *q << 0.2 * (double)i, -0.1 * (double)i, 0.9 + 0.02 * (double)i, 0, 0, 0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+    core::ValidationReportPtr_t report;
+    validation->validate(*q, report);
+    core::RbprmNode node(q);
+    node.fillNodeMatrices(report, i % 2 == 0, 0.1, 0.06, mass, mu, rbprmDevice);
+    BOOST_REQUIRE(node.getNumberOfContacts() > 0);
+    BOOST_REQUIRE(node.computeAccelerationPolytope());
+    sEq.setG(node.getG());
+    for (std::size_t j = 0; j < 20; ++j) {
+      centroidal_dynamics::Vector3 direction = centroidal_dynamics::Vector3::Random();
+      if (j % 4 == 0) direction[2] = 0.;
+      direction.normalize();
+      // maximal acceleration found by the LP of centroidal_dynamics
+      double alphaLP;
+      centroidal_dynamics::LP_status status = sEq.findMaximumAcceleration(node.getH(), node.geth(), direction, alphaLP);
+      const double alpha = node.maximumAcceleration(direction);
+      if (status == centroidal_dynamics::LP_STATUS_UNBOUNDED) {
+        BOOST_CHECK(alpha == std::numeric_limits<double>::infinity());
+        continue;
+      }
+      BOOST_REQUIRE(status == centroidal_dynamics::LP_STATUS_OPTIMAL ||
+                    status == centroidal_dynamics::LP_STATUS_INFEASIBLE);
+      if (status == centroidal_dynamics::LP_STATUS_INFEASIBLE) alphaLP = 0.;
+      BOOST_CHECK_SMALL(alpha - alphaLP, 1e-4 * std::max(1., alphaLP));
+      // accelerations away from the boundary of the polytope
+      const centroidal_dynamics::Vector3 inside = 0.5 * alpha * direction;
+      BOOST_CHECK(node.isAccelerationAdmissible(inside));
+      BOOST_CHECK_EQUAL(node.isAccelerationAdmissible(inside),
+                        sEq.checkAdmissibleAcceleration(node.getH(), node.geth(), inside));
+      if (alpha > 1e-3) {
+        const centroidal_dynamics::Vector3 outside = 1.5 * alpha * direction;
+        BOOST_CHECK(!node.isAccelerationAdmissible(outside));
+        BOOST_CHECK_EQUAL(node.isAccelerationAdmissible(outside),
+                          sEq.checkAdmissibleAcceleration(node.getH(), node.geth(), outside));
+        // the batch test gives the same results
+        core::Matrix3X accelerations(3, 2);
+        accelerations.col(0) = inside;
+        accelerations.col(1) = outside;
+        std::vector<bool> admissible;
+        node.isAccelerationAdmissible(accelerations, admissible);
+        BOOST_REQUIRE_EQUAL(admissible.size(), 2);
+        BOOST_CHECK(admissible[0] && !admissible[1]);
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(square_v0) {
   hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadSimpleHumanoidAbsract();
   rbprmDevice->setDimensionExtraConfigSpace(6);
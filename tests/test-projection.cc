@@ -5,6 +5,8 @@
 #include "tools-fullbody.hh"
 #include <hpp/pinocchio/configuration.hh>
 #include <hpp/rbprm/projection/projection.hh>
+#include <hpp/rbprm/projection/projector-cache.hh>
+#include <hpp/rbprm/kinematic-context.hh>
 #include <hpp/core/fwd.hh>
 using namespace hpp;
 using namespace rbprm;
@@ -122,6 +124,112 @@ BOOST_AUTO_TEST_CASE(projectToComPositionHyQ) {
   }
 }
 
+// projects the state to the root configurations of targets with the cached projectors of fullBody, with the ones of
+// a context owning its device and with a projector built for each call, the results must be the same
+void checkCachedProjections(const RbPrmFullBodyPtr_t& fullBody, const State& state,
+                            const std::vector<core::Configuration_t>& targets) {
+  KinematicContextPtr_t context = KinematicContext::create(fullBody);
+  for (std::size_t i = 0; i < targets.size(); ++i) {
+    projection::ProjectionReport cached = projection::projectToRootConfiguration(fullBody, targets[i], state);
+    projection::ProjectionReport cachedContext = projection::projectToRootConfiguration(context, targets[i], state);
+    // a new context has an empty cache
+    projection::ProjectionReport uncached =
+        projection::projectToRootConfiguration(KinematicContext::create(fullBody), targets[i], state);
+    BOOST_CHECK_EQUAL(cached.success_, uncached.success_);
+    BOOST_CHECK_EQUAL(cachedContext.success_, uncached.success_);
+    if (!cached.success_ || !cachedContext.success_ || !uncached.success_) continue;
+    BOOST_CHECK_SMALL((cached.result_.configuration_ - uncached.result_.configuration_).norm(), 1e-3);
+    BOOST_CHECK_SMALL((cachedContext.result_.configuration_ - uncached.result_.configuration_).norm(), 1e-3);
+    // the contacts of state are maintained by the cached projector
+    fullBody->device_->currentConfiguration(cached.result_.configuration_);
+    fullBody->device_->computeForwardKinematics();
+    for (std::map<std::string, fcl::Vec3f>::const_iterator cit = state.contactPositions_.begin();
+         cit != state.contactPositions_.end(); ++cit) {
+      rbprm::RbPrmLimbPtr_t limb = fullBody->GetLimbs().at(cit->first);
+      BOOST_CHECK_SMALL((limb->effector_.currentTransformation().translation() - cit->second).norm(), 1e-3);
+      if (limb->contactType_ == hpp::rbprm::_6_DOF)
+        BOOST_CHECK_SMALL(
+            (limb->effector_.currentTransformation().rotation() - state.contactRotation_.at(cit->first)).norm(),
+            1e-3);
+    }
+  }
+  // the projectors of a context owning its device are not shared with the full body
+  BOOST_CHECK_EQUAL(context->projectorCache()->size(), 1);
+  BOOST_CHECK(context->projectorCache() != fullBody->projectorCache());
+}
+
+BOOST_AUTO_TEST_CASE(cachedProjectorsHyQ) {
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  BOOST_CHECK_EQUAL(fullBody->projectorCache()->size(), 0);
+  core::Configuration_t q_ref(fullBody->device_->configSize());
+  q_ref << 0.0, 0.0, 0.6838277139631803, 0.0, 0.0, 0.0, 1.0, 0.14279812395541294, 0.934392553166556,
+      -0.9968239786882757, -0.06521258938340457, -0.8831796268418511, 1.150049183494211, -0.06927610020154493,
+      0.9507443168724581, -0.8739975339028809, 0.03995660287873871, -0.9577096766517215, 0.93846028213260710;
+  State state = createState(fullBody, q_ref);
+
+  // the same targets are projected twice, the second time with the projector built by the first projection
+  std::vector<core::Configuration_t> targets;
+  for (std::size_t k = 0; k < 2; ++k) {
+    for (std::size_t i = 0; i < 5; ++i) {
+      core::Configuration_t target(q_ref);
+      target[0] = 0.02 * value_type(i);
+      target[1] = -0.02 * value_type(i);
+      target[2] = q_ref[2] - 0.01 * value_type(i);
+      targets.push_back(target);
+    }
+  }
+  checkCachedProjections(fullBody, state, targets);
+  BOOST_CHECK_EQUAL(fullBody->projectorCache()->size(), 1);
+
+  // same contacts at other positions: the projector is reused with new right hand sides
+  core::Configuration_t q_moved(q_ref);
+  q_moved[0] = 0.1;
+  q_moved[1] = 0.05;
+  checkCachedProjections(fullBody, createState(fullBody, q_moved), targets);
+  BOOST_CHECK_EQUAL(fullBody->projectorCache()->size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cachedProjectorsSimpleHumanoid) {
+  RbPrmFullBodyPtr_t fullBody = loadSimpleHumanoid();
+  core::Configuration_t q_ref(fullBody->device_->neutralConfiguration());
+  q_ref[2] = 0.8;
+  std::vector<core::Configuration_t> targets;
+  for (std::size_t i = 0; i < 4; ++i) {
+    core::Configuration_t target(q_ref);
+    target[0] = 0.01 * value_type(i);
+    target[2] = q_ref[2] - 0.01 * value_type(i);
+    targets.push_back(target);
+  }
+  checkCachedProjections(fullBody, createState(fullBody, q_ref), targets);
+
+  // the rotations of the 6D contacts are right hand sides of the cached projector as well:
+  // a state with rotated feet reuses the projector but must keep its own rotations
+  core::Configuration_t q_rotated(q_ref);
+  const hpp::pinocchio::JointPtr_t rAnkle = fullBody->device_->getJointByName("rleg5_joint");
+  const hpp::pinocchio::JointPtr_t lAnkle = fullBody->device_->getJointByName("lleg5_joint");
+  q_rotated[rAnkle->rankInConfiguration()] += 0.1;
+  q_rotated[lAnkle->rankInConfiguration()] -= 0.1;
+  checkCachedProjections(fullBody, createState(fullBody, q_rotated), targets);
+  BOOST_CHECK_EQUAL(fullBody->projectorCache()->size(), 1);
+
+  // robot facing -x: the feet are yawed by about pi, where the logarithm of their rotations is discontinuous
+  core::Configuration_t q_yawed(q_rotated);
+  q_yawed[5] = 1.;
+  q_yawed[6] = 0.;
+  const State yawedState = createState(fullBody, q_yawed);
+  std::vector<core::Configuration_t> yawedTargets;
+  for (std::size_t i = 0; i < targets.size(); ++i) {
+    core::Configuration_t target(targets[i]);
+    target[0] = -targets[i][0];
+    target[5] = 1.;
+    target[6] = 0.;
+    yawedTargets.push_back(target);
+    BOOST_CHECK(projection::projectToRootConfiguration(fullBody, target, yawedState).success_);
+  }
+  checkCachedProjections(fullBody, yawedState, yawedTargets);
+  BOOST_CHECK_EQUAL(fullBody->projectorCache()->size(), 1);
+}
+
 /*
 BOOST_AUTO_TEST_CASE (projectToComPositionSimpleHumanoid) {
 
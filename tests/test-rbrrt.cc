@@ -24,6 +24,8 @@
 #include <hpp/core/path-vector.hh>
 #include <hpp/rbprm/rbprm-device.hh>
 #include <hpp/rbprm/interpolation/rbprm-path-interpolation.hh>
+#include <hpp/rbprm/planner/steering-method-parabola.hh>
+#include <hpp/rbprm/planner/parabola-path.hh>
 #include "tools-fullbody.hh"
 #include "tools-obstacle.hh"
 
@@ -34,34 +36,6 @@ BOOST_AUTO_TEST_SUITE(rbrrt_quasiStatic)
 
 BOOST_AUTO_TEST_CASE(load_abstract_model) { hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadHyQAbsract(); }
 
-hpp::core::ProblemSolverPtr_t planDarpa(BindShooter& bShooter) {
-  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadHyQAbsract();
-  bShooter.so3Bounds_ = addSo3LimitsHyQ();
-  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
-  hpp::core::ProblemSolver& pSolver = *ps;
-  loadDarpa(pSolver);
-
-  // configure planner
-  pSolver.addPathOptimizer(std::string("RandomShortcut"));
-  pSolver.configurationShooterType(std::string("RbprmShooter"));
-  pSolver.pathValidationType(std::string("RbprmPathValidation"), 0.05);
-
-  core::Configuration_t q_init(rbprmDevice->configSize());
-  q_init << -2, 0, 0.63, 0.0, 0.0, 0.0, 1.0;
-
-  core::Configuration_t q_goal = q_init;
-  q_goal(0) = 3;
-
-  pSolver.initConfig(ConfigurationPtr_t(new core::Configuration_t(q_init)));
-  pSolver.addGoalConfig(ConfigurationPtr_t(new core::Configuration_t(q_goal)));
-  pSolver.solve();
-  for (int i = 0; i < 10; ++i) {
-    pSolver.optimizePath(pSolver.paths().back());
-  }
-  pSolver.optimizePath(pSolver.paths().back());
-  return ps;
-}
-
 BOOST_AUTO_TEST_CASE(plan_path) {
   BindShooter bShooter;
   PathVectorPtr_t resPath = planDarpa(bShooter)->paths().back();
@@ -103,4 +77,53 @@ BOOST_AUTO_TEST_CASE(interpolate_path) {
   BOOST_CHECK(frams.back().second.configuration_[0] > (root_end[0] - 0.1));
 }
 
+BOOST_AUTO_TEST_CASE(discard_colliding_parabolas) {
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadHyQAbsract();
+  BindShooter bShooter;
+  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
+  loadDarpa(*ps);
+  RbPrmPathValidationPtr_t pathValidation =
+      std::dynamic_pointer_cast<RbPrmPathValidation>(bShooter.createPathValidation(rbprmDevice, 0.05, ps));
+  BOOST_REQUIRE(pathValidation);
+  RbPrmValidationPtr_t validation = pathValidation->getValidator();
+  const core::ObjectStdVector_t& obstacles = ps->problem()->collisionObstacles();
+  for (core::ObjectStdVector_t::const_iterator cit = obstacles.begin(); cit != obstacles.end(); ++cit)
+    validation->addObstacle(*cit);
+
+  // paths of the same length linking configurations that only differ by the height of the root,
+  // some of them going through the ground
+  const core::value_type length = 1.;
+  const core::value_type step = 0.05;
+  std::vector<ParabolaPathPtr_t> parabolas;
+  for (std::size_t i = 0; i < 16; ++i) {
+    core::Configuration_t q1(rbprmDevice->configSize()), q2(rbprmDevice->configSize());
+    q1 << -2, 0, 0.1 * (core::value_type)i, 0.0, 0.0, 0.0, 1.0;
+    q2 = q1;
+    q2(0) += length;
+    core::vector_t coefs(core::vector_t::Zero(7));
+    coefs(2) = q1(2);
+    parabolas.push_back(ParabolaPath::create(rbprmDevice, q1, q2, length, coefs));
+  }
+  parabolas.push_back(ParabolaPathPtr_t());
+  std::vector<ParabolaPathPtr_t> discarded(parabolas);
+  SteeringMethodParabola::discardCollidingParabolas(validation, step, discarded);
+
+  // same as testing the trunk of each path at each sampled parameter
+  BOOST_REQUIRE_EQUAL(discarded.size(), parabolas.size());
+  BOOST_CHECK(!discarded.back());
+  bool success;
+  core::value_type trunkRadius;
+  std::size_t nbDiscarded = 0;
+  for (std::size_t i = 0; i + 1 < parabolas.size(); ++i) {
+    bool collision = false;
+    for (core::value_type t = step; t < length && !collision; t += step)
+      collision = validation->trunkDistance((*parabolas[i])(t, success), trunkRadius) <= 0.;
+    BOOST_CHECK_EQUAL(!discarded[i], collision);
+    if (!collision) BOOST_CHECK(discarded[i] == parabolas[i]);
+    if (collision) ++nbDiscarded;
+  }
+  BOOST_CHECK(nbDiscarded > 0);
+  BOOST_CHECK(nbDiscarded < parabolas.size() - 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -19,6 +19,7 @@
 #define BOOST_TEST_MODULE test - reachability
 
 #include <hpp/rbprm/contact_generation/reachability.hh>
+#include <hpp/rbprm/stability/stability.hh>
 #include "tools-fullbody.hh"
 #include <boost/test/included/unit_test.hpp>
 
@@ -38,6 +39,29 @@ BOOST_AUTO_TEST_CASE(kin_constraints_loaded) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(kin_constraints_at_transform) {
+  RbPrmFullBodyPtr_t fullBody = loadTalos();
+  const RbPrmLimbPtr_t limb = fullBody->GetLimbs().begin()->second;
+  const std::pair<MatrixX3, MatrixX3>& NV = limb->kinematicConstraints_;
+  pinocchio::Transform3f transform(Eigen::AngleAxisd(0.3, Eigen::Vector3d(0.2, -0.5, 1).normalized()).matrix(),
+                                   Eigen::Vector3d(0.1, -0.4, 0.8));
+  for (int k = 0; k < 2; ++k) {
+    const std::pair<MatrixX3, VectorX> Ab = reachability::getInequalitiesAtTransform(NV, transform);
+    const std::pair<MatrixX3, VectorX>& cached = reachability::getInequalitiesAtTransform(limb, transform);
+    BOOST_CHECK_EQUAL(Ab.first.rows(), NV.first.rows());
+    for (size_type i = 0; i < NV.first.rows(); ++i) {
+      const Eigen::Vector3d n = transform.rotation() * NV.first.row(i).transpose();
+      const Eigen::Vector3d v = transform.act(Eigen::Vector3d(NV.second.row(i).transpose()));
+      BOOST_CHECK(Ab.first.row(i).transpose().isApprox(n));
+      BOOST_CHECK_SMALL(Ab.second[i] - v.dot(n), 1e-9);
+    }
+    BOOST_CHECK(cached.first == Ab.first);
+    BOOST_CHECK(cached.second == Ab.second);
+    // the cached inequalities must follow the contact
+    transform.translation()[0] += 0.2;
+  }
+}
+
 BOOST_AUTO_TEST_CASE(reachable_quasiStatic_rightFoot_front) {
   RbPrmFullBodyPtr_t fullBody = loadTalos();
 
@@ -224,4 +248,44 @@ BOOST_AUTO_TEST_CASE(reachable_quasiStatic_leftFoot_left) {
   BOOST_CHECK(!reachability::isReachable(fullBody, s0, s07).success());
 }
 
+BOOST_AUTO_TEST_CASE(kinematic_context_matches_fullbody_device) {
+  RbPrmFullBodyPtr_t fullBody = loadTalos();
+  core::Configuration_t q0(fullBody->device_->configSize());
+  q0 << 0.0, 0.0, 1.02127, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, -0.411354, 0.859395, -0.448041, -0.001708, 0.0, 0.0,
+      -0.411354, 0.859395, -0.448041, -0.001708, 0.0, 0.006761, 0.25847, 0.173046, -0.0002, -0.525366, 0.0, -0.0, 0.1,
+      -0.005, -0.25847, -0.173046, 0.0002, -0.525366, 0.0, 0.0, 0.1, -0.005, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  State s0 = createState(fullBody, q0);
+  std::pair<MatrixX3, VectorX> expected = reachability::computeKinematicsConstraintsForState(fullBody, s0);
+  const double expectedRobustness = stability::IsStable(fullBody, s0);
+
+  // queries evaluated on a context must not modify the device of the full body
+  core::Configuration_t reference(fullBody->device_->neutralConfiguration());
+  fullBody->device_->currentConfiguration(reference);
+  KinematicContextPtr_t context = KinematicContext::create(fullBody);
+  BOOST_CHECK(context->ownsDevice());
+  std::pair<MatrixX3, VectorX> Ab = reachability::computeKinematicsConstraintsForState(context, s0);
+  BOOST_CHECK(Ab.first.isApprox(expected.first));
+  BOOST_CHECK(Ab.second.isApprox(expected.second));
+  BOOST_CHECK_CLOSE(stability::IsStable(context, s0), expectedRobustness, 1e-6);
+  BOOST_CHECK(fullBody->device_->currentConfiguration() == reference);
+}
+
+BOOST_AUTO_TEST_CASE(cached_equilibrium_follows_contact_changes) {
+  RbPrmFullBodyPtr_t fullBody = loadTalos();
+  core::Configuration_t q0(fullBody->device_->configSize());
+  q0 << 0.0, 0.0, 1.02127, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, -0.411354, 0.859395, -0.448041, -0.001708, 0.0, 0.0,
+      -0.411354, 0.859395, -0.448041, -0.001708, 0.0, 0.006761, 0.25847, 0.173046, -0.0002, -0.525366, 0.0, -0.0, 0.1,
+      -0.005, -0.25847, -0.173046, 0.0002, -0.525366, 0.0, 0.0, 0.1, -0.005, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  State s0 = createState(fullBody, q0);
+  State s1(s0);
+  s1.RemoveContact(s1.contactOrder_.front());
+  BOOST_CHECK(&stability::cachedLibrary(fullBody) == &stability::cachedLibrary(fullBody));
+  // the contacts of the cached solver are reset between successive queries
+  const double robustness0 = stability::IsStable(fullBody, s0);
+  const double robustness1 = stability::IsStable(fullBody, s1);
+  BOOST_CHECK_CLOSE(stability::IsStable(fullBody, s0), robustness0, 1e-6);
+  BOOST_CHECK_CLOSE(stability::IsStable(fullBody, s1), robustness1, 1e-6);
+  BOOST_CHECK(robustness1 < robustness0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+// Copyright (C) 2020 LAAS-CNRS
+//
+// This file is part of the hpp-rbprm.
+//
+// hpp-rbprm is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// test-hpp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE test - sample - db
+#include <pinocchio/fwd.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include "tools-fullbody.hh"
+#include <hpp/rbprm/rbprm-limb.hh>
+#include <hpp/rbprm/sampling/sample-db.hh>
+#include <hpp/rbprm/sampling/heuristic-tools.hh>
+#include <hpp/rbprm/tools.hh>
+#include <fstream>
+#include <cstdio>
+
+using namespace hpp;
+using namespace rbprm;
+
+BOOST_AUTO_TEST_SUITE(test_sample_db)
+
+BOOST_AUTO_TEST_CASE(binary_database_round_trip) {
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  const RbPrmLimbPtr_t limb = fullBody->GetLimb("rfleg");
+  const std::string path("test-sample-db-rfleg.db");
+  std::ofstream dbFile(path.c_str(), std::ios::binary);
+  BOOST_CHECK(saveLimbInfoAndDatabaseBinary(limb, dbFile));
+  dbFile.close();
+  BOOST_CHECK(tools::io::isBinaryDatabase(path));
+
+  RbPrmFullBodyPtr_t loaded = RbPrmFullBody::create(fullBody->device_);
+  loaded->AddLimb(path, "rfleg", core::ObjectStdVector_t(), "random", true);
+  std::remove(path.c_str());
+  const RbPrmLimbPtr_t loadedLimb = loaded->GetLimb("rfleg");
+  BOOST_CHECK_EQUAL(loadedLimb->limb_->name(), limb->limb_->name());
+  BOOST_CHECK_EQUAL(loadedLimb->effector_.name(), limb->effector_.name());
+  BOOST_CHECK_EQUAL(loadedLimb->contactType_, limb->contactType_);
+
+  const sampling::SampleDB& original = limb->sampleContainer_;
+  const sampling::SampleDB& database = loadedLimb->sampleContainer_;
+  BOOST_CHECK_EQUAL(database.samples_.size(), original.samples_.size());
+  BOOST_CHECK_EQUAL(database.values_.size(), original.values_.size());
+  BOOST_CHECK_EQUAL(database.samplesInVoxels_.size(), original.samplesInVoxels_.size());
+  BOOST_CHECK_EQUAL(database.boxes_.size(), original.boxes_.size());
+  // samples are stored in the order aligned with the octree
+  for (std::size_t i = 0; i < database.samples_.size(); ++i) {
+    const sampling::Sample& sample = database.samples_[i];
+    BOOST_CHECK_EQUAL(sample.id_, i);
+    BOOST_CHECK(sample.effectorPosition_ == original.samples_[i].effectorPosition_);
+    BOOST_CHECK(sample.configuration_ == original.samples_[i].configuration_);
+    BOOST_CHECK(sample.jacobian_ == original.samples_[i].jacobian_);
+    BOOST_CHECK_EQUAL(sample.staticValue_, original.samples_[i].staticValue_);
+  }
+  // the voxel index must be consistent with the loaded octree
+  std::size_t nbSamples = 0;
+  for (sampling::T_VoxelSampleId::const_iterator cit = database.samplesInVoxels_.begin();
+       cit != database.samplesInVoxels_.end(); ++cit) {
+    for (std::size_t i = cit->second.first; i < cit->second.first + cit->second.second; ++i) {
+      const fcl::Vec3f& position = database.samples_[i].effectorPosition_;
+      long int id = database.octomapTree_->search(position[0], position[1], position[2]) -
+                    database.octomapTree_->getRoot();
+      BOOST_CHECK_EQUAL(id, cit->first);
+    }
+    nbSamples += cit->second.second;
+  }
+  BOOST_CHECK_EQUAL(nbSamples, database.samples_.size());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_generation_is_deterministic) {
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  pinocchio::JointPtr_t joint = fullBody->device_->getJointByName("rf_haa_joint");
+  const fcl::Vec3f offset(0, 0, -0.021);
+  sampling::SampleVector_t first = sampling::GenerateSamples(joint, "rf_foot_joint", 1000, offset, fcl::Vec3f(), 4, 42);
+  sampling::SampleVector_t second = sampling::GenerateSamples(joint, "rf_foot_joint", 1000, offset, fcl::Vec3f(), 4, 42);
+  BOOST_CHECK_EQUAL(first.size(), 1000);
+  BOOST_CHECK_EQUAL(second.size(), 1000);
+  for (std::size_t i = 0; i < first.size(); ++i) {
+    BOOST_CHECK_EQUAL(first[i].id_, i);
+    BOOST_CHECK(first[i].configuration_ == second[i].configuration_);
+    BOOST_CHECK(first[i].effectorPosition_ == second[i].effectorPosition_);
+    for (size_type j = 0; j < first[i].configuration_.size(); ++j) {
+      const double value = first[i].configuration_[j];
+      const pinocchio::JointPtr_t current =
+          fullBody->device_->getJointAtConfigRank(first[i].startRank_ + j);
+      const size_type rank = first[i].startRank_ + j - current->rankInConfiguration();
+      BOOST_CHECK(value >= current->lowerBound(rank) && value <= current->upperBound(rank));
+    }
+  }
+  sampling::SampleVector_t other = sampling::GenerateSamples(joint, "rf_foot_joint", 1000, offset, fcl::Vec3f(), 4, 43);
+  BOOST_CHECK(other.back().configuration_ != first.back().configuration_);
+}
+
+BOOST_AUTO_TEST_CASE(samples_are_views_on_database_columns) {
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  const sampling::SampleDB& database = fullBody->GetLimb("rfleg")->sampleContainer_;
+  BOOST_CHECK_EQUAL((std::size_t)database.configurations_.cols(), database.samples_.size());
+  for (std::size_t i = 0; i < database.samples_.size(); ++i) {
+    const sampling::Sample& sample = database.samples_[i];
+    BOOST_CHECK_EQUAL(sample.id_, i);
+    BOOST_CHECK(sample.configuration_.data() == database.configurations_.col(i).data());
+    BOOST_CHECK(sample.effectorPosition_.data() == database.effectorPositions_.col(i).data());
+    BOOST_CHECK(sample.jacobian_.data() == database.jacobians_.col(i).data());
+    BOOST_CHECK_EQUAL(sample.staticValue_, database.staticValues_[i]);
+    BOOST_CHECK((sample.jacobianProduct_ - sample.jacobian_ * sample.jacobian_.transpose()).norm() < 1e-6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(candidate_queue_matches_sorted_reports) {
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  const sampling::SampleDB& database = fullBody->GetLimb("rfleg")->sampleContainer_;
+  const fcl::Vec3f zero(0, 0, 0);
+  const double values[] = {0.5, 2., 1., 2., -1., 0.5, 3., 1.};
+  const std::size_t nbValues = sizeof(values) / sizeof(double);
+  BOOST_REQUIRE(database.samples_.size() >= nbValues);
+  sampling::T_OctreeReport reports;
+  sampling::CandidateQueue candidates, bestCandidates(3);
+  for (std::size_t i = 0; i < nbValues; ++i) {
+    const sampling::OctreeReport report(&database.samples_[i], fcl::Contact(), values[i], zero, zero, zero, zero);
+    reports.insert(report);
+    candidates.push(report);
+    bestCandidates.push(report);
+  }
+  BOOST_CHECK_EQUAL(candidates.size(), nbValues);
+  BOOST_CHECK_EQUAL(bestCandidates.size(), 3);
+  std::size_t extracted = 0;
+  for (sampling::T_OctreeReport::const_iterator cit = reports.begin(); cit != reports.end(); ++cit, ++extracted) {
+    BOOST_CHECK(candidates.top().sample_ == cit->sample_);
+    candidates.pop();
+    if (extracted < 3) {
+      BOOST_CHECK(bestCandidates.top().sample_ == cit->sample_);
+      bestCandidates.pop();
+    }
+  }
+  BOOST_CHECK(candidates.empty());
+  BOOST_CHECK(bestCandidates.empty());
+}
+
+BOOST_AUTO_TEST_CASE(batch_heuristics_match_scalar_heuristics) {
+  RbPrmFullBodyPtr_t fullBody = loadHyQ();
+  const sampling::SampleDB& database = fullBody->GetLimb("rfleg")->sampleContainer_;
+  const sampling::HeuristicFactory& factory = fullBody->GetHeuristicFactory();
+  sampling::HeuristicParam params;
+  params.comAcceleration_ = fcl::Vec3f(0.2, -0.1, 0.);
+  params.tfWorldRoot_.setQuatRotation(fcl::Quaternion3f(0.9238795, 0., 0., 0.3826834));
+  const Eigen::Vector3d directions[] = {Eigen::Vector3d(1, 0.2, 0).normalized(), Eigen::Vector3d::Zero()};
+  const Eigen::Vector3d normal = Eigen::Vector3d(0.1, 0, 1).normalized();
+  const std::size_t first = 10, nbSamples = std::min<std::size_t>(100, database.samples_.size() - first);
+  std::vector<double> values(nbSamples);
+  BOOST_CHECK_EQUAL(factory.batchHeuristics_.size(), 5);
+  for (std::map<std::string, const sampling::batchHeuristic>::const_iterator cit = factory.batchHeuristics_.begin();
+       cit != factory.batchHeuristics_.end(); ++cit) {
+    const sampling::heuristic scalar = factory.heuristics_.at(cit->first);
+    BOOST_CHECK(factory.GetBatchHeuristic(scalar) == cit->second);
+    for (std::size_t d = 0; d < 2; ++d) {
+      srand(42);
+      (*cit->second)(database, first, nbSamples, directions[d], normal, params, values.data());
+      srand(42);
+      for (std::size_t i = 0; i < nbSamples; ++i) {
+        const double expected = (*scalar)(database.samples_[first + i], directions[d], normal, params);
+        BOOST_CHECK_MESSAGE(std::abs(values[i] - expected) <= 1e-9 * std::max(1., std::abs(expected)),
+                            cit->first << " batch value " << values[i] << " differs from " << expected);
+      }
+    }
+  }
+  BOOST_CHECK(factory.GetBatchHeuristic(factory.heuristics_.at("random")) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -37,6 +37,7 @@
 #include <hpp/rbprm/planner/random-shortcut-dynamic.hh>
 #include <hpp/rbprm/planner/oriented-path-optimizer.hh>
 #include <hpp/rbprm/dynamic/dynamic-path-validation.hh>
+#include "tools-fullbody.hh"
 
 #if BOOST_VERSION / 100 % 1000 >= 60
 #include <boost/bind/bind.hpp>
@@ -263,4 +264,34 @@ hpp::core::ProblemSolverPtr_t configureRbprmProblemSolverForSupportLimbs(const D
   ps->pathOptimizers.add("OrientedPathOptimizer", OrientedPathOptimizer::create);
   return ps;
 }
+
+// plans a path of the abstract HyQ across the darpa environment, optimized with RandomShortcut
+hpp::core::ProblemSolverPtr_t planDarpa(BindShooter& bShooter) {
+  hpp::pinocchio::RbPrmDevicePtr_t rbprmDevice = loadHyQAbsract();
+  bShooter.so3Bounds_ = addSo3LimitsHyQ();
+  hpp::core::ProblemSolverPtr_t ps = configureRbprmProblemSolverForSupportLimbs(rbprmDevice, bShooter);
+  hpp::core::ProblemSolver& pSolver = *ps;
+  loadDarpa(pSolver);
+
+  // configure planner
+  pSolver.addPathOptimizer(std::string("RandomShortcut"));
+  pSolver.configurationShooterType(std::string("RbprmShooter"));
+  pSolver.pathValidationType(std::string("RbprmPathValidation"), 0.05);
+
+  core::Configuration_t q_init(rbprmDevice->configSize());
+  q_init << -2, 0, 0.63, 0.0, 0.0, 0.0, 1.0;
+
+  core::Configuration_t q_goal = q_init;
+  q_goal(0) = 3;
+
+  pSolver.initConfig(ConfigurationPtr_t(new core::Configuration_t(q_init)));
+  pSolver.addGoalConfig(ConfigurationPtr_t(new core::Configuration_t(q_goal)));
+  pSolver.solve();
+  for (int i = 0; i < 10; ++i) {
+    pSolver.optimizePath(pSolver.paths().back());
+  }
+  pSolver.optimizePath(pSolver.paths().back());
+  return ps;
+}
+
 #endif  // TOOLSOBSTACLE_HH